@@ -0,0 +1,52 @@
+/**
+ * @brief Minimal helpers shared by the benchmarks.
+ *
+ * @file bench.h
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#define _POSIX_C_SOURCE 200809L // NOLINT
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+/**
+ * @brief Current value of the monotonic clock, in nanoseconds.
+ */
+static inline double bench_now(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (double) ts.tv_sec * 1e9 + (double) ts.tv_nsec;
+}
+
+/**
+ * @brief Deterministic xorshift64 generator, so every run measures the same inputs.
+ */
+static inline uint64_t bench_rand(uint64_t *state)
+{
+	*state ^= *state << 13;
+	*state ^= *state >> 7;
+	*state ^= *state << 17;
+
+	return *state;
+}
+
+/**
+ * @brief Prints the time per operation of a measurement and its speedup over a baseline.
+ */
+static inline void bench_report(const char *name, double ns, size_t ops, double baseline_ns)
+{
+	printf("%-40s %8.2f ns/op %8.2fx\n", name, ns / (double) ops, baseline_ns / ns);
+}
+
+/**
+ * @brief Prevents the compiler from optimizing away a computed value.
+ */
+#define BENCH_KEEP(x) __asm__ volatile("" : : "g"(x) : "memory")
+
+#endif
@@ -0,0 +1,102 @@
+#include "bench.h"
+#include "format.h"
+#include "utilities.h"
+
+#include <float.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NUM_OF_VALUES 1000000
+#define ROUNDS        10
+
+int main(void)
+{
+	uint64_t state = 88172645463325252ULL;
+	int *values    = malloc(NUM_OF_VALUES * sizeof(int));
+	double *reals  = malloc(NUM_OF_VALUES * sizeof(double));
+	char buf[UTIL_FORMAT_BUFSIZE];
+	double start, baseline, elapsed;
+
+	if (!values || !reals) {
+		free(values);
+		free(reals);
+		return EXIT_FAILURE;
+	}
+
+	/* Mix of magnitudes, so that the digit count is not predictable */
+	for (size_t i = 0; i < NUM_OF_VALUES; i++) {
+		uint64_t r = bench_rand(&state);
+		values[i]  = (int) (r >> 32) >> (r % 31);
+	}
+
+	start = bench_now();
+	for (int r = 0; r < ROUNDS; r++) {
+		for (size_t i = 0; i < NUM_OF_VALUES; i++) {
+			BENCH_KEEP(snprintf(buf, sizeof(buf), "%d", values[i]));
+		}
+	}
+	baseline = bench_now() - start;
+	bench_report("snprintf(\"%d\")", baseline, NUM_OF_VALUES * ROUNDS, baseline);
+
+	start = bench_now();
+	for (int r = 0; r < ROUNDS; r++) {
+		for (size_t i = 0; i < NUM_OF_VALUES; i++) {
+			BENCH_KEEP(util_formatInt(buf, values[i]));
+		}
+	}
+	elapsed = bench_now() - start;
+	bench_report("util_formatInt", elapsed, NUM_OF_VALUES * ROUNDS, baseline);
+
+	start = bench_now();
+	for (int r = 0; r < ROUNDS; r++) {
+		for (size_t i = 0; i < NUM_OF_VALUES; i++) {
+			BENCH_KEEP(util_int_toBuffer(buf, sizeof(buf), &values[i]));
+		}
+	}
+	elapsed = bench_now() - start;
+	bench_report("util_int_toBuffer", elapsed, NUM_OF_VALUES * ROUNDS, baseline);
+
+	/* Half of the values have few digits (prices, measures), half use the full precision */
+	for (size_t i = 0; i < NUM_OF_VALUES; i++) {
+		uint64_t r = bench_rand(&state);
+		if (i % 2) {
+			reals[i] = (double) (r % 1000000) / 100.0;
+		} else {
+			reals[i] = (double) (r >> 11) * 0x1.0p-53 * 1e6;
+		}
+	}
+
+	printf("\n");
+
+	start = bench_now();
+	for (int r = 0; r < ROUNDS; r++) {
+		for (size_t i = 0; i < NUM_OF_VALUES; i++) {
+			BENCH_KEEP(snprintf(buf, sizeof(buf), "%.*g", DBL_DIG, reals[i]));
+		}
+	}
+	baseline = bench_now() - start;
+	bench_report("snprintf(\"%.15g\") (lossy)", baseline, NUM_OF_VALUES * ROUNDS, baseline);
+
+	start = bench_now();
+	for (int r = 0; r < ROUNDS; r++) {
+		for (size_t i = 0; i < NUM_OF_VALUES; i++) {
+			BENCH_KEEP(snprintf(buf, sizeof(buf), "%.*g", DBL_DECIMAL_DIG, reals[i]));
+		}
+	}
+	elapsed = bench_now() - start;
+	bench_report("snprintf(\"%.17g\")", elapsed, NUM_OF_VALUES * ROUNDS, baseline);
+
+	start = bench_now();
+	for (int r = 0; r < ROUNDS; r++) {
+		for (size_t i = 0; i < NUM_OF_VALUES; i++) {
+			BENCH_KEEP(util_formatDouble(buf, reals[i]));
+		}
+	}
+	elapsed = bench_now() - start;
+	bench_report("util_formatDouble", elapsed, NUM_OF_VALUES * ROUNDS, baseline);
+
+	free(values);
+	free(reals);
+
+	return EXIT_SUCCESS;
+}
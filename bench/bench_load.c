@@ -0,0 +1,132 @@
+#include "bench.h"
+#include "load.h"
+#include "utilities.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define NUM_OF_VALUES 10000000
+#define ROUNDS        3
+
+static ErrStatus sum_int(void *elem, void *ctx)
+{
+	*(long *) ctx += *(int *) elem;
+
+	return E_SUCCESS;
+}
+
+static ErrStatus sum_and_free_int(void *elem, void *ctx)
+{
+	*(long *) ctx += *(int *) elem;
+	free(elem);
+
+	return E_SUCCESS;
+}
+
+/**
+ * @brief Baseline: getline(), then strtok() and util_int_fromString() on each token.
+ */
+static long load_getline(const char *path)
+{
+	FILE *file  = fopen(path, "r");
+	char *line  = NULL;
+	size_t size = 0;
+	long sum    = 0;
+
+	if (!file) {
+		return 0;
+	}
+
+	while (getline(&line, &size, file) > 0) {
+		for (char *token = strtok(line, " \n"); token; token = strtok(NULL, " \n")) {
+			int *i = util_int_fromString(token);
+			if (i) {
+				sum += *i;
+				free(i);
+			}
+		}
+	}
+
+	free(line);
+	fclose(file);
+
+	return sum;
+}
+
+int main(void)
+{
+	char path[]    = "/tmp/bench_load_XXXXXX";
+	uint64_t state = 88172645463325252ULL;
+	double start, baseline, elapsed;
+	long sum;
+	int elem;
+
+	int fd = mkstemp(path);
+	FILE *file = fd >= 0 ? fdopen(fd, "w") : NULL;
+	if (!file) {
+		return EXIT_FAILURE;
+	}
+
+	/* Lines of 10 space-separated integers */
+	for (size_t i = 0; i < NUM_OF_VALUES; i++) {
+		uint64_t r = bench_rand(&state);
+		fprintf(file, "%d%c", (int) (r >> 32) >> (r % 31), i % 10 == 9 ? '\n' : ' ');
+	}
+	long size = ftell(file);
+	fclose(file);
+
+	printf("%zu integers, %.1f MB\n", (size_t) NUM_OF_VALUES, (double) size / 1e6);
+
+	/* Warm the page cache, so that parsing rather than the disk is measured */
+	load_getline(path);
+
+	start = bench_now();
+	for (int r = 0; r < ROUNDS; r++) {
+		sum = load_getline(path);
+		BENCH_KEEP(sum);
+	}
+	baseline = bench_now() - start;
+	bench_report("getline + util_int_fromString", baseline, NUM_OF_VALUES * ROUNDS, baseline);
+
+	start = bench_now();
+	for (int r = 0; r < ROUNDS; r++) {
+		sum = 0;
+		util_loadElems(path, NULL, util_int_fromString, sum_and_free_int, &sum, NULL);
+		BENCH_KEEP(sum);
+	}
+	elapsed = bench_now() - start;
+	bench_report("util_loadElems", elapsed, NUM_OF_VALUES * ROUNDS, baseline);
+
+	start = bench_now();
+	for (int r = 0; r < ROUNDS; r++) {
+		sum = 0;
+		util_loadParsed(path, NULL, util_int_parse, &elem, sum_int, &sum, NULL);
+		BENCH_KEEP(sum);
+	}
+	elapsed = bench_now() - start;
+	bench_report("util_loadParsed", elapsed, NUM_OF_VALUES * ROUNDS, baseline);
+	printf("util_loadParsed throughput: %.0f MB/s\n", (double) size * ROUNDS / elapsed * 1e3);
+
+	/* Parallel loading into an array, up to the number of online processors */
+	long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+	for (size_t threads = 1; threads <= (size_t) (cpus > 0 ? cpus : 1); threads *= 2) {
+		char name[64];
+		int *elems;
+		size_t n;
+
+		start = bench_now();
+		for (int r = 0; r < ROUNDS; r++) {
+			util_loadParallel(path, NULL, util_int_parse, sizeof(int), threads, (void **) &elems, &n, NULL);
+			BENCH_KEEP(elems);
+			free(elems);
+		}
+		elapsed = bench_now() - start;
+		snprintf(name, sizeof(name), "util_loadParallel (%zu threads)", threads);
+		bench_report(name, elapsed, NUM_OF_VALUES * ROUNDS, baseline);
+	}
+
+	unlink(path);
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,179 @@
+#include "bench.h"
+#include "parse.h"
+#include "utilities.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define NUM_OF_VALUES 1000000
+#define ROUNDS        10
+#define FIELD_LEN     24
+
+int main(void)
+{
+	uint64_t state = 88172645463325252ULL;
+	char *ints     = malloc(NUM_OF_VALUES * FIELD_LEN);
+	char *doubles  = malloc(NUM_OF_VALUES * FIELD_LEN);
+	double start, baseline, elapsed;
+	double int_baseline, double_baseline;
+	double dsum;
+	long sum;
+
+	if (!ints || !doubles) {
+		free(ints);
+		free(doubles);
+		return EXIT_FAILURE;
+	}
+
+	/* Integer column with a mix of magnitudes */
+	for (size_t i = 0; i < NUM_OF_VALUES; i++) {
+		uint64_t r = bench_rand(&state);
+		snprintf(ints + i * FIELD_LEN, FIELD_LEN, "%d", (int) (r >> 32) >> (r % 31));
+	}
+
+	/* Double column as found in CSV exports: prices, measurements and scientific notation */
+	for (size_t i = 0; i < NUM_OF_VALUES; i++) {
+		uint64_t r  = bench_rand(&state);
+		double d    = (double) (r >> 11) / (double) (1ULL << 53);
+		char *field = doubles + i * FIELD_LEN;
+
+		if (r % 4 == 0) {
+			snprintf(field, FIELD_LEN, "%.2f", d * 10000);
+		} else if (r % 4 == 1) {
+			snprintf(field, FIELD_LEN, "%.6f", d * 100 - 50);
+		} else if (r % 4 == 2) {
+			snprintf(field, FIELD_LEN, "%.17g", d);
+		} else {
+			snprintf(field, FIELD_LEN, "%.6e", d * 1e10);
+		}
+	}
+
+	sum   = 0;
+	start = bench_now();
+	for (int r = 0; r < ROUNDS; r++) {
+		for (size_t i = 0; i < NUM_OF_VALUES; i++) {
+			sum += strtol(ints + i * FIELD_LEN, NULL, 10);
+		}
+	}
+	baseline = bench_now() - start;
+	BENCH_KEEP(sum);
+	bench_report("strtol", baseline, NUM_OF_VALUES * ROUNDS, baseline);
+	int_baseline = baseline;
+
+	sum   = 0;
+	start = bench_now();
+	for (int r = 0; r < ROUNDS; r++) {
+		for (size_t i = 0; i < NUM_OF_VALUES; i++) {
+			sum += util_strtoi(ints + i * FIELD_LEN, NULL);
+		}
+	}
+	elapsed = bench_now() - start;
+	BENCH_KEEP(sum);
+	bench_report("util_strtoi", elapsed, NUM_OF_VALUES * ROUNDS, baseline);
+
+	start = bench_now();
+	for (size_t i = 0; i < NUM_OF_VALUES; i++) {
+		free(util_int_fromString(ints + i * FIELD_LEN));
+	}
+	elapsed = bench_now() - start;
+	bench_report("util_int_fromString (with malloc)", elapsed * ROUNDS, NUM_OF_VALUES * ROUNDS, baseline);
+
+	dsum  = 0;
+	start = bench_now();
+	for (int r = 0; r < ROUNDS; r++) {
+		for (size_t i = 0; i < NUM_OF_VALUES; i++) {
+			dsum += strtod(doubles + i * FIELD_LEN, NULL);
+		}
+	}
+	baseline = bench_now() - start;
+	BENCH_KEEP(dsum);
+	bench_report("strtod", baseline, NUM_OF_VALUES * ROUNDS, baseline);
+	double_baseline = baseline;
+
+	dsum  = 0;
+	start = bench_now();
+	for (int r = 0; r < ROUNDS; r++) {
+		for (size_t i = 0; i < NUM_OF_VALUES; i++) {
+			dsum += util_strtod(doubles + i * FIELD_LEN, NULL);
+		}
+	}
+	elapsed = bench_now() - start;
+	BENCH_KEEP(dsum);
+	bench_report("util_strtod", elapsed, NUM_OF_VALUES * ROUNDS, baseline);
+
+	start = bench_now();
+	for (size_t i = 0; i < NUM_OF_VALUES; i++) {
+		free(util_double_fromString(doubles + i * FIELD_LEN));
+	}
+	elapsed = bench_now() - start;
+	bench_report("util_double_fromString (with malloc)", elapsed * ROUNDS, NUM_OF_VALUES * ROUNDS, baseline);
+
+	/* Same columns as comma-separated text, parsed in bulk */
+	char *csv             = malloc(NUM_OF_VALUES * FIELD_LEN);
+	int *int_column       = malloc(NUM_OF_VALUES * sizeof(int));
+	double *double_column = malloc(NUM_OF_VALUES * sizeof(double));
+	size_t int_len = 0, double_len = 0;
+
+	if (csv && int_column && double_column) {
+		for (size_t i = 0; i < NUM_OF_VALUES; i++) {
+			int_len += (size_t) sprintf(csv + int_len, "%s,", ints + i * FIELD_LEN);
+		}
+
+		start = bench_now();
+		for (int r = 0; r < ROUNDS; r++) {
+			util_parseInts(csv, int_len, ',', int_column, NUM_OF_VALUES, NULL);
+			BENCH_KEEP(int_column[r]);
+		}
+		elapsed = bench_now() - start;
+		bench_report("util_parseInts (comma-separated)", elapsed, NUM_OF_VALUES * ROUNDS, int_baseline);
+
+		for (size_t i = 0; i < NUM_OF_VALUES; i++) {
+			double_len += (size_t) sprintf(csv + double_len, "%s,", doubles + i * FIELD_LEN);
+		}
+
+		start = bench_now();
+		for (int r = 0; r < ROUNDS; r++) {
+			util_parseDoubles(csv, double_len, ',', double_column, NUM_OF_VALUES, NULL);
+			BENCH_KEEP(double_column[r]);
+		}
+		elapsed = bench_now() - start;
+		bench_report("util_parseDoubles (comma-separated)", elapsed, NUM_OF_VALUES * ROUNDS, double_baseline);
+	}
+
+	free(csv);
+	free(int_column);
+	free(double_column);
+
+	/* Dirty integer column: one field out of five is invalid. Logs are discarded, but still formatted */
+	for (size_t i = 0; i < NUM_OF_VALUES; i += 5) {
+		strcpy(ints + i * FIELD_LEN, "n/a");
+	}
+
+	sum   = 0;
+	start = bench_now();
+	for (int r = 0; r < ROUNDS; r++) {
+		for (size_t i = 0; i < NUM_OF_VALUES; i++) {
+			int v;
+			if (util_int_tryFromString(ints + i * FIELD_LEN, &v, NULL) == E_SUCCESS) {
+				sum += v;
+			}
+		}
+	}
+	baseline = bench_now() - start;
+	BENCH_KEEP(sum);
+	bench_report("util_int_tryFromString (20% invalid)", baseline, NUM_OF_VALUES * ROUNDS, baseline);
+
+	if (freopen("/dev/null", "w", stderr)) {
+		start = bench_now();
+		for (size_t i = 0; i < NUM_OF_VALUES; i++) {
+			free(util_int_fromString(ints + i * FIELD_LEN));
+		}
+		elapsed = bench_now() - start;
+		bench_report("util_int_fromString (20% invalid)", elapsed * ROUNDS, NUM_OF_VALUES * ROUNDS, baseline);
+	}
+
+	free(ints);
+	free(doubles);
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,260 @@
+#include "bench.h"
+#include "sort.h"
+#include "sort_template.h"
+#include "utilities.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define NUM_OF_VALUES 1000000
+#define ROUNDS        5
+#define STRING_LEN    16
+
+#define VALUE_LESS(a, b) ((a) < (b))
+
+UTIL_DEFINE_SORT(ints, int, VALUE_LESS)
+UTIL_DEFINE_SORT(doubles, double, VALUE_LESS)
+
+static int qsort_string_cmp(const void *p1, const void *p2)
+{
+	return util_string_cmp(*(void *const *) p1, *(void *const *) p2);
+}
+
+static int qsort_int_ptr_cmp(const void *p1, const void *p2)
+{
+	return util_int_cmp(*(void *const *) p1, *(void *const *) p2);
+}
+
+/**
+ * @brief Sorts copies of an array ROUNDS times, with util_sort() if util is true or qsort()
+ * otherwise, and returns the time spent sorting.
+ */
+static double time_sort(const void *input, void *work, size_t size, util_compare cmp, bool util)
+{
+	double elapsed = 0;
+
+	for (int r = 0; r < ROUNDS; r++) {
+		memcpy(work, input, NUM_OF_VALUES * size);
+
+		double start = bench_now();
+		if (util) {
+			util_sort(work, NUM_OF_VALUES, size, cmp);
+		} else {
+			qsort(work, NUM_OF_VALUES, size, cmp);
+		}
+		elapsed += bench_now() - start;
+		BENCH_KEEP(work);
+	}
+
+	return elapsed;
+}
+
+/**
+ * @brief Sorts copies of an array of pointers ROUNDS times with util_sortPtrs(), and returns the time spent sorting.
+ */
+static double time_sort_ptrs(void *const *input, void **work, util_compare cmp)
+{
+	double elapsed = 0;
+
+	for (int r = 0; r < ROUNDS; r++) {
+		memcpy(work, input, NUM_OF_VALUES * sizeof(void *));
+
+		double start = bench_now();
+		util_sortPtrs(work, NUM_OF_VALUES, cmp);
+		elapsed += bench_now() - start;
+		BENCH_KEEP(work);
+	}
+
+	return elapsed;
+}
+
+/**
+ * @brief Sorts copies of an array of pointers to ints ROUNDS times with util_stableSort(),
+ * and returns the time spent sorting, after reporting the statistics of a sort.
+ */
+static double time_stable_sort(const char *name, void *const *input, void **work, double baseline)
+{
+	double elapsed = 0;
+	SortStats stats;
+
+	for (int r = 0; r < ROUNDS; r++) {
+		memcpy(work, input, NUM_OF_VALUES * sizeof(void *));
+
+		double start = bench_now();
+		util_stableSort(work, NUM_OF_VALUES, sizeof(void *), qsort_int_ptr_cmp, &stats);
+		elapsed += bench_now() - start;
+		BENCH_KEEP(work);
+	}
+	bench_report(name, elapsed, NUM_OF_VALUES * ROUNDS, baseline);
+	printf("  %zu comparisons, %zu runs, %zu merges\n", stats.comparisons, stats.runs, stats.merges);
+
+	return elapsed;
+}
+
+/**
+ * @brief Sorts copies of the consecutive arrays of len ints or doubles of input, with qsort(),
+ * with an introsort with inlined comparisons, or with a sorting network depending on method,
+ * and returns the time spent sorting.
+ */
+static double time_small_sorts(const void *input, void *work, size_t len, bool doubles, int method)
+{
+	size_t size    = doubles ? sizeof(double) : sizeof(int);
+	double elapsed = 0;
+
+	for (int r = 0; r < ROUNDS; r++) {
+		memcpy(work, input, NUM_OF_VALUES * size);
+
+		double start = bench_now();
+		for (size_t i = 0; i + len <= NUM_OF_VALUES; i += len) {
+			char *a = (char *) work + i * size;
+			if (method == 0) {
+				qsort(a, len, size, doubles ? util_double_cmp : util_int_cmp);
+			} else if (method == 1 && doubles) {
+				doubles_sort((double *) a, len);
+			} else if (method == 1) {
+				ints_sort((int *) a, len);
+			} else if (doubles) {
+				util_double_smallSort((double *) a, len);
+			} else {
+				util_int_smallSort((int *) a, len);
+			}
+		}
+		elapsed += bench_now() - start;
+		BENCH_KEEP(work);
+	}
+
+	return elapsed;
+}
+
+int main(void)
+{
+	uint64_t state  = 88172645463325252ULL;
+	int *ints       = malloc(NUM_OF_VALUES * sizeof(int));
+	double *doubles = malloc(NUM_OF_VALUES * sizeof(double));
+	char *strings   = malloc(NUM_OF_VALUES * STRING_LEN);
+	void **ptrs     = malloc(NUM_OF_VALUES * sizeof(void *));
+	void *work      = malloc(NUM_OF_VALUES * sizeof(double));
+	double baseline, elapsed;
+
+	if (!ints || !doubles || !strings || !ptrs || !work) {
+		return EXIT_FAILURE;
+	}
+
+	for (size_t i = 0; i < NUM_OF_VALUES; i++) {
+		uint64_t r = bench_rand(&state);
+		ints[i]    = (int) (r >> 32);
+		doubles[i] = (double) (int64_t) r / 1e6;
+
+		/* Keys with a common prefix, as found in identifiers */
+		snprintf(strings + i * STRING_LEN, STRING_LEN, "key-%010u", (unsigned) (r >> 40));
+	}
+
+	baseline = time_sort(ints, work, sizeof(int), util_int_cmp, false);
+	bench_report("qsort ints", baseline, NUM_OF_VALUES * ROUNDS, baseline);
+	elapsed = time_sort(ints, work, sizeof(int), util_int_cmp, true);
+	bench_report("util_sort ints", elapsed, NUM_OF_VALUES * ROUNDS, baseline);
+
+	/* Comparison sort with an inlined comparison, without the radix sort */
+	elapsed = 0;
+	for (int r = 0; r < ROUNDS; r++) {
+		memcpy(work, ints, NUM_OF_VALUES * sizeof(int));
+
+		double start = bench_now();
+		ints_sort(work, NUM_OF_VALUES);
+		elapsed += bench_now() - start;
+		BENCH_KEEP(work);
+	}
+	bench_report("UTIL_DEFINE_SORT ints", elapsed, NUM_OF_VALUES * ROUNDS, baseline);
+
+	baseline = time_sort(doubles, work, sizeof(double), util_double_cmp, false);
+	bench_report("qsort doubles", baseline, NUM_OF_VALUES * ROUNDS, baseline);
+	elapsed = time_sort(doubles, work, sizeof(double), util_double_cmp, true);
+	bench_report("util_sort doubles", elapsed, NUM_OF_VALUES * ROUNDS, baseline);
+
+	for (size_t i = 0; i < NUM_OF_VALUES; i++) {
+		ptrs[i] = strings + i * STRING_LEN;
+	}
+	baseline = time_sort(ptrs, work, sizeof(void *), qsort_string_cmp, false);
+	bench_report("qsort strings", baseline, NUM_OF_VALUES * ROUNDS, baseline);
+	elapsed = time_sort_ptrs(ptrs, work, util_string_cmp);
+	bench_report("util_sortPtrs strings", elapsed, NUM_OF_VALUES * ROUNDS, baseline);
+
+	for (size_t i = 0; i < NUM_OF_VALUES; i++) {
+		ptrs[i] = &ints[i];
+	}
+	baseline = time_sort(ptrs, work, sizeof(void *), qsort_int_ptr_cmp, false);
+	bench_report("qsort pointers to ints", baseline, NUM_OF_VALUES * ROUNDS, baseline);
+	elapsed = time_sort_ptrs(ptrs, work, util_int_cmp);
+	bench_report("util_sortPtrs pointers to ints", elapsed, NUM_OF_VALUES * ROUNDS, baseline);
+
+	/* Same records, sorted by extracted keys with the pointers as payloads */
+	int *keys = (int *) doubles;
+	elapsed   = 0;
+	for (int r = 0; r < ROUNDS; r++) {
+		double start = bench_now();
+		for (size_t i = 0; i < NUM_OF_VALUES; i++) {
+			keys[i]             = *(const int *) ptrs[i];
+			((void **) work)[i] = ptrs[i];
+		}
+		util_int_radixSort(keys, work, NUM_OF_VALUES);
+		elapsed += bench_now() - start;
+		BENCH_KEEP(work);
+	}
+	bench_report("util_int_radixSort keys and payloads", elapsed, NUM_OF_VALUES * ROUNDS, baseline);
+
+	/* Comparison function that is not recognized: introsort against qsort */
+	elapsed = time_sort(ptrs, work, sizeof(void *), qsort_int_ptr_cmp, true);
+	bench_report("util_sort generic", elapsed, NUM_OF_VALUES * ROUNDS, baseline);
+
+	/* Same comparison function on all the online processors */
+	elapsed = 0;
+	for (int r = 0; r < ROUNDS; r++) {
+		memcpy(work, ptrs, NUM_OF_VALUES * sizeof(void *));
+
+		double start = bench_now();
+		util_parallelSort(work, NUM_OF_VALUES, sizeof(void *), qsort_int_ptr_cmp, 0, 0);
+		elapsed += bench_now() - start;
+		BENCH_KEEP(work);
+	}
+	bench_report("util_parallelSort generic", elapsed, NUM_OF_VALUES * ROUNDS, baseline);
+
+	/* Many small arrays, as in buckets or tree nodes */
+	static const size_t lens[] = {8, 16, 32, 64};
+	char name[64];
+	for (size_t l = 0; l < sizeof(lens) / sizeof(lens[0]); l++) {
+		for (int d = 0; d < 2; d++) {
+			const void *input = d ? (const void *) doubles : (const void *) ints;
+			const char *type  = d ? "doubles" : "ints";
+
+			baseline = time_small_sorts(input, work, lens[l], d, 0);
+			snprintf(name, sizeof(name), "qsort %zu %s", lens[l], type);
+			bench_report(name, baseline, NUM_OF_VALUES * ROUNDS, baseline);
+			elapsed = time_small_sorts(input, work, lens[l], d, 1);
+			snprintf(name, sizeof(name), "UTIL_DEFINE_SORT %zu %s", lens[l], type);
+			bench_report(name, elapsed, NUM_OF_VALUES * ROUNDS, baseline);
+			elapsed = time_small_sorts(input, work, lens[l], d, 2);
+			snprintf(name, sizeof(name), "util_%s_smallSort %zu", d ? "double" : "int", lens[l]);
+			bench_report(name, elapsed, NUM_OF_VALUES * ROUNDS, baseline);
+		}
+	}
+
+	/* Stable merge sort, on random and on mostly sorted input with a random tail appended */
+	time_stable_sort("util_stableSort generic", ptrs, work, baseline);
+
+	for (size_t i = 0; i < NUM_OF_VALUES; i++) {
+		ints[i] = i < NUM_OF_VALUES - NUM_OF_VALUES / 100 ? (int) i : (int) (bench_rand(&state) % NUM_OF_VALUES);
+	}
+	baseline = time_sort(ptrs, work, sizeof(void *), qsort_int_ptr_cmp, false);
+	bench_report("qsort mostly sorted", baseline, NUM_OF_VALUES * ROUNDS, baseline);
+	elapsed = time_sort(ptrs, work, sizeof(void *), qsort_int_ptr_cmp, true);
+	bench_report("util_sort mostly sorted", elapsed, NUM_OF_VALUES * ROUNDS, baseline);
+	time_stable_sort("util_stableSort mostly sorted", ptrs, work, baseline);
+
+	free(ints);
+	free(doubles);
+	free(strings);
+	free(ptrs);
+	free(work);
+
+	return EXIT_SUCCESS;
+}
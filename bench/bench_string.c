@@ -0,0 +1,159 @@
+#include "bench.h"
+#include "utilities.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define NUM_OF_KEYS 4096
+#define ROUNDS      200
+#define LONG_LEN    4096
+#define LONG_ROUNDS 200000
+
+/**
+ * @brief Previous implementation of util_string_cmp(), as the baseline.
+ */
+static int strcmp_cmp(const void *str1, const void *str2)
+{
+	if (!str1 || !str2) {
+		return (!str1 < !str2) - (!str1 > !str2);
+	}
+
+	return strcmp(str1, str2);
+}
+
+/**
+ * @brief Previous implementation of util_string_equal(), as the baseline.
+ */
+static bool strcmp_equal(const void *str1, const void *str2)
+{
+	if (!str1 || !str2) {
+		return str1 == str2;
+	}
+
+	return strcmp(str1, str2) == 0;
+}
+
+/**
+ * @brief Compares each key with the next one ROUNDS times through a function pointer,
+ * as data structures do, and returns the time spent.
+ */
+static double time_cmp(char *const *keys, util_compare cmp)
+{
+	double start = bench_now();
+	int sum      = 0;
+
+	for (int r = 0; r < ROUNDS; r++) {
+		for (size_t i = 0; i + 1 < NUM_OF_KEYS; i++) {
+			sum += cmp(keys[i], keys[i + 1]) > 0;
+		}
+	}
+	BENCH_KEEP(sum);
+
+	return bench_now() - start;
+}
+
+static double time_equal(char *const *keys, util_equal equal)
+{
+	double start = bench_now();
+	int sum      = 0;
+
+	for (int r = 0; r < ROUNDS; r++) {
+		for (size_t i = 0; i + 1 < NUM_OF_KEYS; i++) {
+			sum += equal(keys[i], keys[i + 1]);
+		}
+	}
+	BENCH_KEEP(sum);
+
+	return bench_now() - start;
+}
+
+/**
+ * @brief Fills keys of the given length sharing a prefix, where every other key is a copy of
+ * the previous one, so that comparisons either scan the whole key or stop near its end.
+ */
+static void fill_keys(char **keys, size_t len, uint64_t *state)
+{
+	for (size_t i = 0; i < NUM_OF_KEYS; i++) {
+		if (i % 2 == 1) {
+			memcpy(keys[i], keys[i - 1], len + 1);
+			continue;
+		}
+
+		memset(keys[i], 'k', len);
+		for (size_t k = len > 4 ? len - 4 : 0; k < len; k++) {
+			keys[i][k] = (char) ('a' + bench_rand(state) % 26);
+		}
+		keys[i][len] = '\0';
+	}
+}
+
+int main(void)
+{
+	uint64_t state = 88172645463325252ULL;
+	char **keys    = malloc(NUM_OF_KEYS * sizeof(char *));
+	char *storage  = malloc(NUM_OF_KEYS * 64);
+	char *long1    = malloc(LONG_LEN + 1);
+	char *long2    = malloc(LONG_LEN + 1);
+	static const size_t lens[] = {8, 16, 32};
+	double baseline, elapsed;
+	char name[64];
+
+	if (!keys || !storage || !long1 || !long2) {
+		return EXIT_FAILURE;
+	}
+
+	for (size_t i = 0; i < NUM_OF_KEYS; i++) {
+		keys[i] = storage + i * 64;
+	}
+
+	for (size_t l = 0; l < sizeof(lens) / sizeof(lens[0]); l++) {
+		size_t ops = (size_t) ROUNDS * (NUM_OF_KEYS - 1);
+		fill_keys(keys, lens[l], &state);
+
+		baseline = time_cmp(keys, strcmp_cmp);
+		snprintf(name, sizeof(name), "strcmp %zu-byte keys", lens[l]);
+		bench_report(name, baseline, ops, baseline);
+		elapsed = time_cmp(keys, util_string_cmp);
+		snprintf(name, sizeof(name), "util_string_cmp %zu-byte keys", lens[l]);
+		bench_report(name, elapsed, ops, baseline);
+
+		baseline = time_equal(keys, strcmp_equal);
+		snprintf(name, sizeof(name), "strcmp == 0 %zu-byte keys", lens[l]);
+		bench_report(name, baseline, ops, baseline);
+		elapsed = time_equal(keys, util_string_equal);
+		snprintf(name, sizeof(name), "util_string_equal %zu-byte keys", lens[l]);
+		bench_report(name, elapsed, ops, baseline);
+	}
+
+	/* Long payloads that only differ in their last character */
+	memset(long1, 'x', LONG_LEN);
+	memset(long2, 'x', LONG_LEN);
+	long1[LONG_LEN] = long2[LONG_LEN] = '\0';
+	long2[LONG_LEN - 1] = 'y';
+
+	util_compare cmps[] = {strcmp_cmp, util_string_cmp};
+	const char *names[] = {"strcmp 4 KiB payloads", "util_string_cmp 4 KiB payloads"};
+	for (int c = 0; c < 2; c++) {
+		double start = bench_now();
+		int sum      = 0;
+
+		for (int r = 0; r < LONG_ROUNDS; r++) {
+			sum += cmps[c](long1, long2) < 0;
+			BENCH_KEEP(long1);
+		}
+		BENCH_KEEP(sum);
+
+		elapsed = bench_now() - start;
+		if (c == 0) {
+			baseline = elapsed;
+		}
+		bench_report(names[c], elapsed, LONG_ROUNDS, baseline);
+	}
+
+	free(keys);
+	free(storage);
+	free(long1);
+	free(long2);
+
+	return EXIT_SUCCESS;
+}
@@ -24,6 +24,7 @@ typedef enum {
 	E_INVALID_ARG,   /**< Invalid arguments provided to the function */
 	E_INVALID_OP,    /**< Invalid operation or function call */
 	E_ERROR,         /**< Generic error code */
+	E_OUT_OF_RANGE,  /**< Value out of the representable range */
 } ErrStatus;
 
 /**
@@ -0,0 +1,79 @@
+/**
+ * @brief Fast, locale-independent conversion of numbers to text.
+ *
+ * @file format.h
+ */
+
+#ifndef FORMAT_H
+#define FORMAT_H
+
+#include <stddef.h>
+
+/**
+ * @brief Size of a buffer large enough to hold any number written by the util_format* functions,
+ * including the terminating null byte.
+ */
+#define UTIL_FORMAT_BUFSIZE 32
+
+/* SECTION - Integers */
+
+/**
+ * @brief Writes a signed integer in base 10. Produces the same output as the %d specifier.
+ *
+ * @param buf Buffer to write to. Must have room for at least @ref UTIL_FORMAT_BUFSIZE bytes.
+ * @param value Value to write.
+ * @return Number of characters written, excluding the terminating null byte.
+ */
+size_t util_formatInt(char *buf, int value);
+
+/**
+ * @brief Writes a signed long in base 10. Produces the same output as the %ld specifier.
+ *
+ * @param buf Buffer to write to. Must have room for at least @ref UTIL_FORMAT_BUFSIZE bytes.
+ * @param value Value to write.
+ * @return Number of characters written, excluding the terminating null byte.
+ */
+size_t util_formatLong(char *buf, long value);
+
+/**
+ * @brief Writes an unsigned integer in base 10. Produces the same output as the %u specifier.
+ *
+ * @param buf Buffer to write to. Must have room for at least @ref UTIL_FORMAT_BUFSIZE bytes.
+ * @param value Value to write.
+ * @return Number of characters written, excluding the terminating null byte.
+ */
+size_t util_formatUnsigned(char *buf, unsigned value);
+
+/**
+ * @brief Writes an unsigned long in base 10. Produces the same output as the %lu specifier.
+ *
+ * @param buf Buffer to write to. Must have room for at least @ref UTIL_FORMAT_BUFSIZE bytes.
+ * @param value Value to write.
+ * @return Number of characters written, excluding the terminating null byte.
+ */
+size_t util_formatUnsignedLong(char *buf, unsigned long value);
+
+/* !SECTION */
+/* SECTION - Floating point */
+
+/**
+ * @brief Writes the shortest decimal representation of a double that parses back to the same value.
+ *
+ * @details Digits are generated with the Ryu algorithm, so the output is both the shortest possible
+ * and, among the candidates of that length, the closest one to the exact value. Reading it back with
+ * strtod() in the C locale always yields the original bits.
+ *
+ * The layout follows the rules of the %g specifier, with a precision of 17 digits:
+ * scientific notation is used when the decimal exponent is less than -4 or greater than 16,
+ * and fixed notation otherwise. Infinities and NaNs are written as `inf` and `nan`, with a leading
+ * minus sign if negative.
+ *
+ * @param buf Buffer to write to. Must have room for at least @ref UTIL_FORMAT_BUFSIZE bytes.
+ * @param value Value to write.
+ * @return Number of characters written, excluding the terminating null byte.
+ */
+size_t util_formatDouble(char *buf, double value);
+
+/* !SECTION */
+
+#endif
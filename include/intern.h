@@ -0,0 +1,84 @@
+/**
+ * @brief String interning: one canonical copy per distinct string.
+ *
+ * @details An intern pool stores each distinct string once and always returns the same pointer
+ * for equal strings, so interned strings can be compared with util_genericEqual() instead of
+ * util_string_cmp(). Interned strings are never moved nor freed until their pool is destroyed.
+ *
+ * Pools are safe for concurrent use: they are split in shards, each protected by its own lock.
+ *
+ * @file intern.h
+ */
+
+#ifndef INTERN_H
+#define INTERN_H
+
+#include <stddef.h>
+
+typedef struct InternPool InternPool;
+
+/* SECTION - Intern pools */
+
+/**
+ * @brief Creates an empty intern pool.
+ *
+ * @return The pool, which must be destroyed with util_internPool_destroy().
+ * NULL if malloc fails. In this case, the errno value is set.
+ */
+InternPool *util_internPool_create(void);
+
+/**
+ * @brief Destroys an intern pool and all the strings interned in it.
+ *
+ * @param pool Pool to destroy. No other thread may be using it. NULL is no-op.
+ */
+void util_internPool_destroy(InternPool *pool);
+
+/**
+ * @brief Interns a string.
+ *
+ * @param pool Pool. Must not be NULL.
+ * @param str String to intern. Must not be NULL.
+ * @return Canonical copy of the string, which is the same pointer for all equal strings
+ * interned in the pool. Must not be freed or modified. NULL if malloc fails.
+ */
+const char *util_internPool_intern(InternPool *pool, const char *str);
+
+/**
+ * @brief Interns a sequence of characters, which does not need to be null-terminated.
+ *
+ * @param pool Pool. Must not be NULL.
+ * @param str Characters to intern. Must not be NULL unless len is 0. They must not contain null bytes.
+ * @param len Number of characters.
+ * @return Canonical null-terminated copy of the characters. Must not be freed or modified.
+ * NULL if malloc fails.
+ */
+const char *util_internPool_internLen(InternPool *pool, const char *str, size_t len);
+
+/**
+ * @brief Number of distinct strings interned in a pool.
+ *
+ * @param pool Pool. Must not be NULL.
+ * @return Number of strings.
+ */
+size_t util_internPool_count(InternPool *pool);
+
+/* !SECTION */
+/* SECTION - Global pool */
+
+/**
+ * @brief Interns a string in a process-wide pool, which is created when first used.
+ *
+ * @details Has the signature of @ref util_elemFromString, so it may replace util_string_fromString()
+ * for data structures of strings with many duplicates. Elements created this way must not be freed.
+ *
+ * @param str String to intern. Must not be NULL.
+ * @return Canonical copy of the string. Must not be freed or modified.
+ * NULL if malloc fails. In this case, the errno value is set. If the pool itself could not be
+ * created, the next call tries again.
+ */
+void *util_string_intern(const char *str);
+
+/* !SECTION */
+
+#endif
@@ -0,0 +1,164 @@
+/**
+ * @brief Loading of elements from large text files through memory mappings.
+ *
+ * @details Files are mapped read-only with a sequential access hint and split into tokens
+ * without copying them. Tokens are passed to a length-aware @ref util_parse, or to a
+ * @ref util_elemFromString, and the resulting elements are handed to a callback.
+ *
+ * @file load.h
+ */
+
+#ifndef LOAD_H
+#define LOAD_H
+
+#include "dbg.h"
+#include "parse.h"
+#include "utilities.h"
+
+#include <stddef.h>
+
+/**
+ * @brief Delimiters used when NULL is given: whitespace.
+ */
+#define UTIL_LOAD_DEF_DELIMS " \t\n\v\f\r"
+
+/**
+ * @brief Read-only memory mapping of a whole file.
+ */
+typedef struct {
+	const char *data; /**< Contents of the file. Not null-terminated. NULL if the file is empty */
+	size_t len;       /**< Size of the file */
+} MappedFile;
+
+/**
+ * @brief Function type that receives the tokens of a file.
+ *
+ * @param token First character of the token. Not null-terminated.
+ * @param len Length of the token, which is at least 1.
+ * @param ctx User data.
+ *
+ * @return @ref E_SUCCESS to continue. Any other value stops the tokenization and is returned by it.
+ */
+typedef ErrStatus (*util_tokenConsumer)(const char *token, size_t len, void *ctx);
+
+/**
+ * @brief Function type that receives the elements loaded from a file.
+ *
+ * @param elem Element loaded. Its ownership and lifetime depend on the loading function.
+ * @param ctx User data.
+ *
+ * @return @ref E_SUCCESS to continue. Any other value stops loading and is returned by it.
+ */
+typedef ErrStatus (*util_elemConsumer)(void *elem, void *ctx);
+
+/* SECTION - Memory mappings */
+
+/**
+ * @brief Maps a file into memory for sequential reading.
+ *
+ * @param file Mapping to initialize. Must not be NULL.
+ * @param path Path of the file. Must not be NULL.
+ * @return @ref E_SUCCESS, @ref E_INVALID_ARG if the file could not be opened,
+ * or @ref E_ERROR if it could not be mapped. In case of errors, the errno value is set.
+ */
+ErrStatus util_mappedFile_open(MappedFile *file, const char *path);
+
+/**
+ * @brief Unmaps a file.
+ *
+ * @param file Mapping to release. Its members are reset. NULL is no-op.
+ */
+void util_mappedFile_close(MappedFile *file);
+
+/**
+ * @brief Splits a mapped file into tokens, without copying them.
+ *
+ * @details Tokens are maximal runs of characters that are not delimiters,
+ * so consecutive delimiters do not produce empty tokens.
+ *
+ * @param file Mapped file. Must not be NULL.
+ * @param delims Null-terminated set of delimiter characters. @ref UTIL_LOAD_DEF_DELIMS if NULL.
+ * @param consume Function called with each token. Must not be NULL.
+ * @param ctx User data passed to consume.
+ * @return @ref E_SUCCESS, or the first status different from @ref E_SUCCESS returned by consume.
+ */
+ErrStatus util_mappedFile_tokenize(const MappedFile *file, const char *delims, util_tokenConsumer consume, void *ctx);
+
+/* !SECTION */
+/* SECTION - Loading functions */
+
+/**
+ * @brief Loads the elements of a file with a length-aware parse function.
+ *
+ * @details Tokens are parsed in place, so no memory is allocated. The element is written to
+ * the same storage for every token: the consumer must copy it if it needs to keep it.
+ * Tokens that cannot be parsed, or that have bytes left after the element, such as "12abc"
+ * for integers, are skipped and counted as errors.
+ *
+ * @param path Path of the file. Must not be NULL.
+ * @param delims Null-terminated set of delimiter characters. @ref UTIL_LOAD_DEF_DELIMS if NULL.
+ * @param parse Parse function. Must not be NULL.
+ * @param elem Storage for the parsed elements, large enough for their type. Must not be NULL.
+ * @param consume Function called with elem after each successful parse. Must not be NULL.
+ * @param ctx User data passed to consume.
+ * @param stats If not NULL, filled with the statistics of the call, with offsets relative to the
+ * start of the file. If consume stops loading, consumed is the end of the last token read.
+ * @return @ref E_SUCCESS, an error of util_mappedFile_open(), or the first status different from
+ * @ref E_SUCCESS returned by consume.
+ */
+ErrStatus util_loadParsed(const char *path, const char *delims, util_parse parse, void *elem,
+						  util_elemConsumer consume, void *ctx, ParseStats *stats);
+
+/**
+ * @brief Loads the elements of a file with a function that converts strings to elements.
+ *
+ * @details Since @ref util_elemFromString requires a null-terminated string, each token is copied
+ * into a reusable buffer before conversion; prefer util_loadParsed() when a parse function exists.
+ * Tokens for which fromString returns NULL are skipped and counted as errors.
+ *
+ * @param path Path of the file. Must not be NULL.
+ * @param delims Null-terminated set of delimiter characters. @ref UTIL_LOAD_DEF_DELIMS if NULL.
+ * @param fromString Conversion function. Must not be NULL.
+ * @param consume Function called with each element, which it takes ownership of. Must not be NULL.
+ * @param ctx User data passed to consume.
+ * @param stats If not NULL, filled with the statistics of the call, with offsets relative to the
+ * start of the file. If consume stops loading, consumed is the end of the last token read.
+ * @return @ref E_SUCCESS, an error of util_mappedFile_open(), @ref E_OUT_OF_MEMORY,
+ * or the first status different from @ref E_SUCCESS returned by consume.
+ */
+ErrStatus util_loadElems(const char *path, const char *delims, util_elemFromString fromString,
+						 util_elemConsumer consume, void *ctx, ParseStats *stats);
+
+/**
+ * @brief Loads the elements of a file into an array, parsing it on several threads.
+ *
+ * @details The file is split into chunks that end at newlines, which are processed in parallel,
+ * one chunk per thread: the tokens of every chunk are counted first, then each chunk parses its
+ * elements directly into its own slice of the returned array, in file order.
+ * Newlines are always delimiters, so tokens never span chunks. Chunks are at least 256 KiB,
+ * so small files use fewer threads. Tokens that cannot be parsed entirely are skipped and counted
+ * as errors, as in util_loadParsed().
+ *
+ * Elements must not reference the file, which is unmapped before returning:
+ * util_stringView_parse() cannot be used.
+ *
+ * @param path Path of the file. Must not be NULL.
+ * @param delims Null-terminated set of delimiter characters, to which '\n' is added.
+ * @ref UTIL_LOAD_DEF_DELIMS if NULL.
+ * @param parse Parse function, such as util_int_parse() or util_double_parse(). Must not be NULL.
+ * @param size Size of an element. Must be greater than 0.
+ * @param threads Maximum number of threads, including the calling thread.
+ * If 0, the number of online processors is used.
+ * @param elems Set to the array of elements, which must be freed after use.
+ * Set to NULL if there are no elements or if there were errors. Must not be NULL.
+ * @param n Set to the number of elements. Must not be NULL.
+ * @param stats If not NULL, filled with the statistics of the call, with offsets relative to the
+ * start of the file, in file order.
+ * @return @ref E_SUCCESS, an error of util_mappedFile_open(), or @ref E_OUT_OF_MEMORY.
+ */
+ErrStatus util_loadParallel(const char *path, const char *delims, util_parse parse, size_t size, size_t threads,
+							void **elems, size_t *n, ParseStats *stats);
+
+/* !SECTION */
+
+#endif
@@ -0,0 +1,187 @@
+/**
+ * @brief Length-prefixed strings with small-string optimization and a cached hash.
+ *
+ * @details An @ref LString stores its length, so comparing, printing and copying it never
+ * rescans the characters. Strings of up to @ref UTIL_LSTRING_SSO_CAP characters are stored
+ * inline, without any allocation; longer strings are stored in a separate buffer.
+ * The hash is computed on first use and cached in the string.
+ *
+ * The util_lString_* functions that take a `const void *` implement the function types of
+ * utilities.h for elements that are pointers to LString, so they can be used with any
+ * data structure built on those types.
+ *
+ * @file lstring.h
+ */
+
+#ifndef LSTRING_H
+#define LSTRING_H
+
+#include "dbg.h"
+#include "utilities.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/**
+ * @brief Maximum number of characters of a string stored inline.
+ */
+#define UTIL_LSTRING_SSO_CAP 15
+
+/**
+ * @brief String that knows its length. The characters are always null-terminated,
+ * but may also contain null bytes when created with util_lString_init().
+ */
+typedef struct {
+	size_t len;    /**< Number of characters, excluding the terminating null byte */
+	uint64_t hash; /**< Cached hash. 0 if it has not been computed yet */
+	union {
+		char sso[UTIL_LSTRING_SSO_CAP + 1]; /**< Characters, if len <= UTIL_LSTRING_SSO_CAP */
+		char *heap;                         /**< Characters, if len > UTIL_LSTRING_SSO_CAP */
+	} data;
+} LString;
+
+/* SECTION - Initialization */
+
+/**
+ * @brief Initializes a string with a copy of a sequence of characters.
+ *
+ * @param s String to initialize. Must not be NULL.
+ * @param str Characters to copy, which do not need to be null-terminated. Must not be NULL unless len is 0.
+ * @param len Number of characters.
+ * @return @ref E_SUCCESS, or @ref E_OUT_OF_MEMORY if malloc fails. In this case, the errno value is set
+ * and s is left empty.
+ */
+ErrStatus util_lString_init(LString *s, const char *str, size_t len);
+
+/**
+ * @brief Releases the memory used by the characters of a string initialized with util_lString_init().
+ *
+ * @param s String. It is left empty. NULL is no-op.
+ */
+void util_lString_destroy(LString *s);
+
+/**
+ * @brief Characters of a string.
+ *
+ * @param s String. Must not be NULL.
+ * @return Null-terminated characters, valid until the string is destroyed.
+ */
+const char *util_lString_str(const LString *s);
+
+/* !SECTION */
+/* SECTION - Element functions */
+
+/**
+ * @brief Print a string, followed by a space. See @ref util_print.
+ *
+ * @param file A pointer to the stream. Must not be NULL.
+ * @param s Pointer to the LString to print. @ref DEF_NULL is printed if NULL.
+ * @return Number of bytes printed.
+ * Returns a negative number if there were errors while printing
+ */
+int util_lString_print(FILE *file, const void *s);
+
+/**
+ * @brief Compares two strings in the same order as util_string_cmp(). See @ref util_compare.
+ *
+ * @param s1 Pointer to the first LString.
+ * @param s2 Pointer to the second LString.
+ * @return A negative integer, zero, or a positive integer as s1 is less than, equal to, or greater than s2.
+ * NULL is ordered before all strings.
+ */
+int util_lString_cmp(const void *s1, const void *s2);
+
+/**
+ * @brief Tests whether two strings are equal. See @ref util_equal.
+ *
+ * @details Strings of different lengths, or whose cached hashes differ, are told apart
+ * without reading their characters.
+ *
+ * @param s1 Pointer to the first LString.
+ * @param s2 Pointer to the second LString.
+ * @return `true` if both strings have the same characters or are both NULL, `false` otherwise.
+ */
+bool util_lString_equal(const void *s1, const void *s2);
+
+/**
+ * @brief Hash of a string, which is computed once and cached in it. See @ref util_hash.
+ *
+ * @param s Pointer to the LString. Must not point to an object defined as const.
+ * @return Hash of the characters, never 0. Equal strings have the same hash. 0 if s is NULL.
+ */
+uint64_t util_lString_hash(const void *s);
+
+/**
+ * @brief Writes the sort key of a string, consistent with util_lString_cmp(). See @ref util_sortKey.
+ *
+ * @details The key starts with @ref UTIL_KEY_PRESENT. Strings may contain null bytes, so each of
+ * them is written as 0x00 0xFF, and the key ends with 0x00 0x00. The key of a string without null
+ * bytes is thus its length plus 3.
+ *
+ * @param buf Buffer to write to. May be NULL if size is 0.
+ * @param size Size of the buffer in bytes.
+ * @param s Pointer to the LString. NULL has the key @ref UTIL_KEY_NULL.
+ * @return Length of the key, or 1 if s is NULL.
+ */
+size_t util_lString_sortKey(unsigned char *buf, size_t size, const void *s);
+
+/**
+ * @brief Converts a string to a malloc'ed null-terminated string. See @ref util_toString.
+ *
+ * @param s Pointer to the LString.
+ * @return Copy of the characters. Must be freed after use.
+ * NULL if s is NULL or if malloc fails. In this case, the errno value is set.
+ */
+char *util_lString_toString(const void *s);
+
+/**
+ * @brief Writes the characters of a string into a buffer. See @ref util_toBuffer.
+ *
+ * @param buf Buffer to write to. May be NULL if size is 0.
+ * @param size Size of the buffer in bytes.
+ * @param s Pointer to the LString.
+ * @return Length of the string. -1 if s is NULL or if its length does not fit in an int.
+ */
+int util_lString_toBuffer(char *buf, size_t size, const void *s);
+
+/**
+ * @brief Creates a string from a null-terminated string. See @ref util_elemFromString.
+ *
+ * @param str String to copy. Must not be NULL.
+ * @return Pointer to the LString created. Must be freed with util_lString_free().
+ * NULL is returned if malloc fails. In this case, the errno value is set.
+ */
+void *util_lString_fromString(const char *str);
+
+/**
+ * @brief Initializes a string with all the characters of a buffer. See @ref util_parse.
+ *
+ * @param str Start of the buffer. Must not be NULL.
+ * @param len Number of characters.
+ * @param s Pointer to the LString to initialize, which must be destroyed with util_lString_destroy().
+ * Must not be NULL.
+ * @param end If not NULL, set to str + len, or to str if malloc fails.
+ * @return @ref E_SUCCESS or @ref E_OUT_OF_MEMORY.
+ */
+ErrStatus util_lString_parse(const char *str, size_t len, void *s, const char **end);
+
+/**
+ * @brief Frees a string created with util_lString_fromString(). See @ref util_free.
+ *
+ * @param s Pointer to the LString. NULL is no-op.
+ */
+void util_lString_free(void *s);
+
+/* !SECTION */
+/* SECTION - Type descriptor */
+
+/**
+ * @brief Descriptor of pointers to LString created with util_lString_fromString().
+ */
+extern const UtilType UTIL_TYPE_LSTRING;
+
+/* !SECTION */
+
+#endif
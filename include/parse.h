@@ -0,0 +1,153 @@
+/**
+ * @brief Fast, locale-independent conversion of text to numbers.
+ *
+ * @file parse.h
+ */
+
+#ifndef PARSE_H
+#define PARSE_H
+
+#include "dbg.h"
+
+#include <stddef.h>
+
+/* SECTION - Integers */
+
+/**
+ * @brief Converts the initial part of a string to a long, in base 10.
+ *
+ * @details Drop-in replacement of `strtol(str, end, 10)` that does not depend on the locale:
+ * leading whitespace (as defined by isspace() in the C locale) is skipped, then an optional sign
+ * and as many decimal digits as possible are read. Digits are processed 8 at a time when possible.
+ *
+ * @param str String with the number. Must not be NULL.
+ * @param end If not NULL, set to the first character after the number, or to str if no number was found.
+ * @return The value read. 0 if no number was found.
+ * If the value does not fit in a long, LONG_MAX or LONG_MIN is returned and errno is set to ERANGE.
+ * errno is not modified otherwise.
+ */
+long util_strtol(const char *str, char **end);
+
+/**
+ * @brief Converts the initial part of a string to an int, in base 10.
+ *
+ * @details Same as util_strtol(), but values that do not fit in an int are clamped to
+ * INT_MAX or INT_MIN and set errno to ERANGE.
+ *
+ * @param str String with the number. Must not be NULL.
+ * @param end If not NULL, set to the first character after the number, or to str if no number was found.
+ * @return The value read. 0 if no number was found.
+ */
+int util_strtoi(const char *str, char **end);
+
+/* !SECTION */
+/* SECTION - Floating point */
+
+/**
+ * @brief Converts the initial part of a string to a double.
+ *
+ * @details Drop-in replacement of strtod() that always uses the C locale ('.' as decimal separator).
+ * Decimal numbers are converted with the Eisel-Lemire algorithm, which is correctly rounded;
+ * hexadecimal numbers, infinities, NaNs, results that overflow or underflow, and the rare inputs
+ * with too many significant digits to be decided quickly are handed over to strtod().
+ *
+ * @param str String with the number. Must not be NULL.
+ * @param end If not NULL, set to the first character after the number, or to str if no number was found.
+ * @return The value read. 0 if no number was found.
+ * On overflow or underflow, the result and errno are the ones of strtod().
+ */
+double util_strtod(const char *str, char **end);
+
+/* !SECTION */
+/* SECTION - Length-delimited parsing */
+
+/**
+ * @brief Parses a base 10 integer from the first len bytes of a buffer.
+ *
+ * @details Accepts the same syntax as util_strtol(), but never reads past str + len,
+ * so fields can be parsed in place from buffers that are not null-terminated.
+ * errno is not modified.
+ *
+ * @param str Start of the buffer. Must not be NULL.
+ * @param len Number of bytes that may be read.
+ * @param min Minimum value accepted.
+ * @param max Maximum value accepted.
+ * @param out Set to the value read, clamped to [min, max]. Not modified if no number was found. Must not be NULL.
+ * @param end If not NULL, set to the first byte after the number, or to str if no number was found.
+ * @return @ref E_SUCCESS if a number was parsed, @ref E_INVALID_ARG if no number was found,
+ * or @ref E_OUT_OF_RANGE if the number is not in [min, max].
+ */
+ErrStatus util_parseLong(const char *str, size_t len, long min, long max, long *out, const char **end);
+
+/**
+ * @brief Parses a double from the first len bytes of a buffer.
+ *
+ * @details Accepts the same syntax as util_strtod(), but never reads past str + len,
+ * so fields can be parsed in place from buffers that are not null-terminated.
+ * errno is not modified.
+ *
+ * @param str Start of the buffer. Must not be NULL.
+ * @param len Number of bytes that may be read.
+ * @param out Set to the value read. Not modified if no number was found. Must not be NULL.
+ * @param end If not NULL, set to the first byte after the number, or to str if no number was found.
+ * @return @ref E_SUCCESS if a number was parsed, @ref E_INVALID_ARG if no number was found,
+ * @ref E_OUT_OF_RANGE if the number overflows or underflows (out is set as strtod() would),
+ * or @ref E_OUT_OF_MEMORY if a temporary buffer was needed for a number longer than
+ * 127 bytes that had to be handed over to strtod() and it could not be allocated (end is set
+ * to str). Only the bytes of the number are copied, not the rest of the buffer.
+ */
+ErrStatus util_parseDouble(const char *str, size_t len, double *out, const char **end);
+
+/* !SECTION */
+/* SECTION - Bulk parsing */
+
+/**
+ * @brief Statistics of a bulk parsing call.
+ */
+typedef struct {
+	size_t count;          /**< Number of fields read, including invalid ones */
+	size_t errors;         /**< Number of invalid fields */
+	size_t consumed;       /**< Number of bytes consumed, to resume parsing from buf + consumed */
+	size_t *error_offsets; /**< Filled with the offsets of the first invalid fields. Set by the caller, may be NULL */
+	size_t error_capacity; /**< Capacity of error_offsets. Set by the caller */
+} ParseStats;
+
+/**
+ * @brief Parses a buffer of delimited base 10 integers into an array.
+ *
+ * @details Fields are separated by delim or by a newline, which are found 16 bytes at a time
+ * with SSE2 when available. Each field must contain a single integer, with the syntax of
+ * util_strtoi() and optional surrounding whitespace (so "\r\n" line endings are accepted).
+ * Invalid fields (empty, or with characters after the number) are stored as 0 and counted as errors; values that do not
+ * fit in an int are clamped and counted as errors as well. A final delimiter does not start an extra field.
+ *
+ * @param buf Buffer with the fields, which does not need to be null-terminated. Must not be NULL.
+ * @param len Length of the buffer.
+ * @param delim Field delimiter, in addition to newlines.
+ * @param out Array where the values are stored, in the order of the fields. May be NULL if n is 0.
+ * @param n Capacity of out. Parsing stops after n fields.
+ * @param stats If not NULL, filled with the statistics of the call.
+ * The offsets (from buf) of the first error_capacity invalid fields are stored in error_offsets.
+ * @return Number of fields read.
+ */
+size_t util_parseInts(const char *buf, size_t len, char delim, int *out, size_t n, ParseStats *stats);
+
+/**
+ * @brief Parses a buffer of delimited doubles into an array.
+ *
+ * @details Same as util_parseInts(), with the syntax of util_strtod(). Values that overflow or
+ * underflow are stored as returned by strtod() and counted as errors.
+ *
+ * @param buf Buffer with the fields, which does not need to be null-terminated. Must not be NULL.
+ * @param len Length of the buffer.
+ * @param delim Field delimiter, in addition to newlines.
+ * @param out Array where the values are stored, in the order of the fields. May be NULL if n is 0.
+ * @param n Capacity of out. Parsing stops after n fields.
+ * @param stats If not NULL, filled with the statistics of the call.
+ * @return Number of fields read.
+ */
+size_t util_parseDoubles(const char *buf, size_t len, char delim, double *out, size_t n, ParseStats *stats);
+
+/* !SECTION */
+
+#endif
@@ -0,0 +1,67 @@
+/**
+ * @brief Bulk printing of arrays of elements.
+ *
+ * @details The functions in this file print every element of an array followed by a space,
+ * like the util_print functions of utilities.h do for a single element. Instead of issuing one
+ * fprintf() per element, elements are formatted with a @ref util_toBuffer function, which avoids
+ * parsing a format string and taking the stream lock for each of them.
+ *
+ * @file print.h
+ */
+
+#ifndef PRINT_H
+#define PRINT_H
+
+#include "utilities.h"
+
+#include <sys/types.h>
+
+/**
+ * @brief Size of the internal buffer used by util_printArray() and util_printArrayFd().
+ * Output that does not fit in the buffer is flushed in several writes.
+ */
+#define UTIL_PRINT_BUFSIZE 65536
+
+/**
+ * @brief Prints an array of elements to a stream, each followed by a space.
+ *
+ * @details Elements are formatted into an internal buffer, which is written with a single
+ * fwrite() call every @ref UTIL_PRINT_BUFSIZE bytes.
+ *
+ * @param file Stream to print to. Must not be NULL.
+ * @param elems Array of elements. May be NULL if n is 0.
+ * @param n Number of elements.
+ * @param toBuffer Function to format each element (e.g. util_int_toBuffer() for util_int_print()).
+ * Must not be NULL. @ref DEF_NULL is printed for elements it does not convert.
+ * @return Number of bytes printed. A negative number if there were errors while printing.
+ */
+ssize_t util_printArray(FILE *file, const void *const *elems, size_t n, util_toBuffer toBuffer);
+
+/**
+ * @brief Same as util_printArray(), but writes to a file descriptor with write(), bypassing stdio.
+ *
+ * @param fd File descriptor to write to.
+ * @param elems Array of elements. May be NULL if n is 0.
+ * @param n Number of elements.
+ * @param toBuffer Function to format each element. Must not be NULL.
+ * @return Number of bytes written. A negative number if there were errors while writing.
+ * In this case, the errno value is set.
+ */
+ssize_t util_printArrayFd(int fd, const void *const *elems, size_t n, util_toBuffer toBuffer);
+
+/**
+ * @brief Prints an array of elements to a stream, each followed by a space, locking the stream only once.
+ *
+ * @details The stream is locked with flockfile() for the whole array, and elements are written
+ * with the unlocked stdio functions. The output goes through the stream buffer as usual, so
+ * it may be freely interleaved with other writes to the same stream.
+ *
+ * @param file Stream to print to. Must not be NULL.
+ * @param elems Array of elements. May be NULL if n is 0.
+ * @param n Number of elements.
+ * @param toBuffer Function to format each element. Must not be NULL.
+ * @return Number of bytes printed. A negative number if there were errors while printing.
+ */
+ssize_t util_printArrayLocked(FILE *file, const void *const *elems, size_t n, util_toBuffer toBuffer);
+
+#endif
@@ -0,0 +1,207 @@
+/**
+ * @brief Output sinks: destinations for printed text that do not depend on stdio.
+ *
+ * @details A sink is a small struct holding a write function and the state of its backend.
+ * The library provides sinks for stdio streams, file descriptors, growable memory buffers
+ * and fixed-size ring buffers. Custom backends may be created by setting the `write`
+ * and `ctx` members directly.
+ *
+ * Sinks are not thread-safe, and neither are the backends that they share, such as a ring buffer
+ * read by another thread: a sink used by several threads must be protected by a lock held around
+ * each call. Each print function makes a single call to the write function of the sink, so
+ * a value and its separator are never split by other writes to a shared file descriptor.
+ *
+ * @file sink.h
+ */
+
+#ifndef SINK_H
+#define SINK_H
+
+#include "dbg.h"
+#include "utilities.h"
+
+#include <sys/types.h>
+
+typedef struct Sink Sink;
+
+/**
+ * @brief Function type to write bytes to a sink.
+ *
+ * @param sink Sink to write to. Must not be NULL.
+ * @param data Bytes to write.
+ * @param len Number of bytes to write.
+ *
+ * @return Number of bytes written, which is len unless there were errors.
+ * A negative number if there were errors while writing.
+ */
+typedef ssize_t (*sink_write)(Sink *sink, const char *data, size_t len);
+
+/**
+ * @brief Function type to print an element to a sink. Sink counterpart of @ref util_print.
+ *
+ * @param sink Sink to print to. Must not be NULL.
+ * @param elem Element to print. @ref DEF_NULL is printed if NULL.
+ *
+ * @return Numbers of bytes printed. A negative number if there were errors while printing.
+ */
+typedef int (*util_sinkPrint)(Sink *sink, const void *elem);
+
+/**
+ * @brief Destination of printed text.
+ */
+struct Sink {
+	sink_write write; /**< Function used to write to the sink */
+
+	union {
+		FILE *file; /**< Stream of a sink created with util_sink_initFile() */
+		int fd;     /**< File descriptor of a sink created with util_sink_initFd() */
+		void *ctx;  /**< State of custom sinks */
+
+		struct {
+			char *data; /**< Written bytes. Not null-terminated */
+			size_t len; /**< Number of written bytes */
+			size_t cap; /**< Capacity of data */
+		} mem; /**< State of a sink created with util_sink_initMemory() */
+
+		struct {
+			char *data;  /**< Storage of the ring buffer */
+			size_t cap;  /**< Capacity of data */
+			size_t head; /**< Index of the oldest byte */
+			size_t len;  /**< Number of bytes stored */
+		} ring; /**< State of a sink created with util_sink_initRing() */
+	};
+};
+
+/* SECTION - Creation and destruction */
+
+/**
+ * @brief Initializes a sink that writes to a stream with fwrite().
+ *
+ * @param sink Sink to initialize. Must not be NULL.
+ * @param file Stream to write to. Must not be NULL.
+ */
+void util_sink_initFile(Sink *sink, FILE *file);
+
+/**
+ * @brief Initializes a sink that writes to a file descriptor with write(), without any buffering.
+ *
+ * @param sink Sink to initialize. Must not be NULL.
+ * @param fd File descriptor to write to.
+ */
+void util_sink_initFd(Sink *sink, int fd);
+
+/**
+ * @brief Initializes a sink that appends to a growable memory buffer.
+ * The buffer must be released with util_sink_destroy().
+ *
+ * @param sink Sink to initialize. Must not be NULL.
+ * @param capacity Initial capacity of the buffer, in bytes. May be 0.
+ * @return @ref E_SUCCESS, or @ref E_OUT_OF_MEMORY if the buffer could not be allocated.
+ */
+ErrStatus util_sink_initMemory(Sink *sink, size_t capacity);
+
+/**
+ * @brief Initializes a sink that writes to a fixed-size ring buffer provided by the caller.
+ * When the buffer is full, the oldest bytes are overwritten.
+ *
+ * @param sink Sink to initialize. Must not be NULL.
+ * @param buf Storage of the ring buffer. Must outlive the sink.
+ * @param capacity Size of buf in bytes. Must be greater than 0.
+ */
+void util_sink_initRing(Sink *sink, char *buf, size_t capacity);
+
+/**
+ * @brief Releases the resources owned by a sink. Streams and file descriptors are not closed.
+ *
+ * @param sink Sink to destroy. NULL is no-op.
+ */
+void util_sink_destroy(Sink *sink);
+
+/* !SECTION */
+/* SECTION - Writing and reading */
+
+/**
+ * @brief Writes bytes to a sink.
+ *
+ * @param sink Sink to write to. Must not be NULL.
+ * @param data Bytes to write.
+ * @param len Number of bytes to write.
+ * @return Number of bytes written. A negative number if there were errors while writing.
+ */
+ssize_t util_sink_write(Sink *sink, const char *data, size_t len);
+
+/**
+ * @brief Returns the contents of a memory sink.
+ *
+ * @param sink Sink created with util_sink_initMemory(). Must not be NULL.
+ * @param len Set to the number of bytes written to the sink. May be NULL.
+ * @return Pointer to the written bytes. It is invalidated by further writes.
+ */
+const char *util_sink_memoryData(const Sink *sink, size_t *len);
+
+/**
+ * @brief Reads and removes the oldest bytes of a ring sink.
+ *
+ * @param sink Sink created with util_sink_initRing(). Must not be NULL.
+ * @param buf Buffer to copy the bytes to.
+ * @param size Maximum number of bytes to read.
+ * @return Number of bytes read.
+ */
+size_t util_sink_ringRead(Sink *sink, char *buf, size_t size);
+
+/* !SECTION */
+/* SECTION - Printing functions */
+
+/**
+ * @brief Sink counterpart of util_generic_print().
+ *
+ * @param sink Sink to print to. Must not be NULL.
+ * @param p The pointer to print. @ref DEF_NULL is printed if NULL.
+ * @return Number of bytes printed.
+ * Returns a negative number if there were errors while printing
+ */
+int util_generic_sinkPrint(Sink *sink, const void *p);
+
+/**
+ * @brief Sink counterpart of util_char_print().
+ *
+ * @param sink Sink to print to. Must not be NULL.
+ * @param c A pointer to the char to print. @ref DEF_NULL is printed if NULL.
+ * @return Number of bytes printed.
+ * Returns a negative number if there were errors while printing
+ */
+int util_char_sinkPrint(Sink *sink, const void *c);
+
+/**
+ * @brief Sink counterpart of util_int_print().
+ *
+ * @param sink Sink to print to. Must not be NULL.
+ * @param i A pointer to the integer to print (base 10). @ref DEF_NULL is printed if NULL.
+ * @return Number of bytes printed.
+ * Returns a negative number if there were errors while printing
+ */
+int util_int_sinkPrint(Sink *sink, const void *i);
+
+/**
+ * @brief Sink counterpart of util_double_print().
+ *
+ * @param sink Sink to print to. Must not be NULL.
+ * @param d A pointer to the value to print. @ref DEF_NULL is printed if NULL.
+ * @return Number of bytes printed.
+ * Returns a negative number if there were errors while printing
+ */
+int util_double_sinkPrint(Sink *sink, const void *d);
+
+/**
+ * @brief Sink counterpart of util_string_print().
+ *
+ * @param sink Sink to print to. Must not be NULL.
+ * @param s String to print. @ref DEF_NULL is printed if NULL.
+ * @return Number of bytes printed.
+ * Returns a negative number if there were errors while printing
+ */
+int util_string_sinkPrint(Sink *sink, const void *s);
+
+/* !SECTION */
+
+#endif
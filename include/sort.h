@@ -0,0 +1,212 @@
+/**
+ * @brief Sorting of arrays with the comparison functions of utilities.h.
+ *
+ * @details The sorting functions recognize the built-in comparison functions and dispatch to
+ * specialized algorithms that do not call them: radix sorts for ints, doubles and chars, and a
+ * multikey quicksort for strings. Any other comparison function is used by an introsort,
+ * which is O(n log n) in the worst case. The radix sorts are also available directly, with
+ * payloads carried along with the keys, and util_stableSort() is a stable sort that takes
+ * advantage of presorted input. Small arrays of ints and doubles can be sorted with sorting
+ * networks, which are vectorized when AVX2 is enabled at compile time; the sorts of ints and doubles
+ * then use them for small arrays and for the small ranges left by their introsorts.
+ *
+ * @file sort.h
+ */
+
+#ifndef SORT_H
+#define SORT_H
+
+#include "utilities.h"
+
+#include <stddef.h>
+
+/**
+ * @brief Default minimum number of elements sorted by each thread of util_parallelSort().
+ */
+#define UTIL_PARALLEL_SORT_CUTOFF 65536
+
+/**
+ * @brief Maximum number of elements sorted with a sorting network.
+ */
+#define UTIL_SMALL_SORT_MAX 64
+
+/* SECTION - Sorting functions */
+
+/**
+ * @brief Sorts an array of elements stored by value, like qsort().
+ *
+ * @details cmp receives pointers to the elements of the array, so util_char_cmp(), util_int_cmp(),
+ * util_double_cmp() and util_double_totalCmp() can be used with arrays of char, int and double.
+ * Those are sorted with a radix sort; other functions use an introsort. The sort is not stable.
+ *
+ * @param base Array to sort. Must not be NULL unless n is 0.
+ * @param n Number of elements.
+ * @param size Size of an element. Must be greater than 0.
+ * @param cmp Comparison function. Must not be NULL.
+ */
+void util_sort(void *base, size_t n, size_t size, util_compare cmp);
+
+/**
+ * @brief Sorts an array of pointers to elements, as stored by the data structures built on utilities.h.
+ *
+ * @details cmp receives the elements themselves, so util_string_cmp() can be used with arrays
+ * of strings, and util_int_cmp() with arrays of pointers to ints. Strings are sorted with a
+ * multikey quicksort, which compares each character about once, and pointers to char, int and
+ * double with a radix sort that carries the pointers along with their values. Other functions
+ * use an introsort. NULL elements are ordered first, as the built-in comparison functions do.
+ * The sort is not stable.
+ *
+ * @param elems Array to sort. Must not be NULL unless n is 0.
+ * @param n Number of elements.
+ * @param cmp Comparison function. Must not be NULL.
+ */
+void util_sortPtrs(void **elems, size_t n, util_compare cmp);
+
+/* !SECTION */
+/* SECTION - Radix sorting functions */
+
+/**
+ * @brief Sorts an array of ints with an LSD radix sort, in the order of util_int_cmp().
+ *
+ * @details The sort is stable and makes one pass over the array per byte of the keys, skipping
+ * the bytes that are the same in all of them. If payloads is not NULL, each payload is moved
+ * along with its key, so that records can be sorted by a key without calling a comparison
+ * function: fill keys[i] with the key of record i and payloads[i] with a pointer to it.
+ * Without payloads, arrays of up to @ref UTIL_SMALL_SORT_MAX keys are sorted by comparison
+ * instead, as by util_sort().
+ *
+ * @param keys Array to sort. Must not be NULL unless n is 0.
+ * @param payloads Values carried along with the keys, or NULL.
+ * @param n Number of keys, and of payloads.
+ * @return @ref E_SUCCESS, or @ref E_OUT_OF_MEMORY if the buffers could not be allocated,
+ * in which case the arrays are not modified.
+ */
+ErrStatus util_int_radixSort(int *keys, void **payloads, size_t n);
+
+/**
+ * @brief Sorts an array of unsigned ints with an LSD radix sort. See util_int_radixSort().
+ *
+ * @param keys Array to sort. Must not be NULL unless n is 0.
+ * @param payloads Values carried along with the keys, or NULL.
+ * @param n Number of keys, and of payloads.
+ * @return @ref E_SUCCESS, or @ref E_OUT_OF_MEMORY if the buffers could not be allocated.
+ */
+ErrStatus util_unsigned_radixSort(unsigned *keys, void **payloads, size_t n);
+
+/**
+ * @brief Sorts an array of doubles with an LSD radix sort, in the order of util_double_totalCmp().
+ * See util_int_radixSort().
+ *
+ * @details The doubles are sorted by util_double_totalKey(), so -0.0 goes before 0.0 and NaNs
+ * are moved to the ends, which is also a valid order for util_double_cmp() without NaNs.
+ *
+ * @param keys Array to sort. Must not be NULL unless n is 0.
+ * @param payloads Values carried along with the keys, or NULL.
+ * @param n Number of keys, and of payloads.
+ * @return @ref E_SUCCESS, or @ref E_OUT_OF_MEMORY if the buffers could not be allocated.
+ */
+ErrStatus util_double_radixSort(double *keys, void **payloads, size_t n);
+
+/**
+ * @brief Sorts an array of chars, in the order of util_char_cmp(). See util_int_radixSort().
+ *
+ * @details Without payloads, the chars are counted and written back, which needs no memory.
+ *
+ * @param keys Array to sort. Must not be NULL unless n is 0.
+ * @param payloads Values carried along with the keys, or NULL.
+ * @param n Number of keys, and of payloads.
+ * @return @ref E_SUCCESS, or @ref E_OUT_OF_MEMORY if the buffers could not be allocated.
+ */
+ErrStatus util_char_radixSort(char *keys, void **payloads, size_t n);
+
+/* !SECTION */
+/* SECTION - Parallel sort */
+
+/**
+ * @brief Sorts an array of elements stored by value on several threads, like util_sort().
+ *
+ * @details The array is split in one chunk per thread, which are sorted with util_sort(), so the
+ * built-in comparison functions still select the radix sorts. With util_double_cmp(), the chunks
+ * are sorted and merged with util_double_totalCmp(), as util_sort() orders large arrays of doubles,
+ * so that NaNs are moved to the ends instead of splitting runs. The sorted chunks are then merged
+ * pairwise into a buffer of the size of the array, and back. Each merge is split in independent
+ * parts found by binary search, so that all the threads take part in every round of merges.
+ * If the buffer cannot be allocated or threads cannot be created, the work is done by fewer
+ * threads, down to a sequential util_sort(). The sort is not stable.
+ *
+ * @param base Array to sort. Must not be NULL unless n is 0.
+ * @param n Number of elements.
+ * @param size Size of an element. Must be greater than 0.
+ * @param cmp Comparison function. Must not be NULL. It is called concurrently.
+ * @param threads Maximum number of threads, including the calling one, or 0 for the number of
+ * online processors.
+ * @param cutoff Minimum number of elements sorted by each thread, or 0 for
+ * @ref UTIL_PARALLEL_SORT_CUTOFF. Arrays with fewer than 2 * cutoff elements are sorted sequentially.
+ */
+void util_parallelSort(void *base, size_t n, size_t size, util_compare cmp, unsigned threads, size_t cutoff);
+
+/* !SECTION */
+/* SECTION - Stable sort */
+
+/**
+ * @brief Statistics of a call to util_stableSort().
+ */
+typedef struct {
+	size_t comparisons; /**< Number of calls to the comparison function */
+	size_t runs;        /**< Number of ascending or strictly descending runs found in the input */
+	size_t merges;      /**< Number of merges of two runs */
+} SortStats;
+
+/**
+ * @brief Sorts an array of elements stored by value with a stable, adaptive merge sort.
+ *
+ * @details The array is split into maximal runs, ascending or strictly descending, the latter
+ * being reversed. Short runs are extended with binary insertion sort, and runs are merged as
+ * TimSort does, with galloping searches to skip the parts of runs that are already in place.
+ * Presorted or reversed input takes n - 1 comparisons, and few runs take O(n log runs).
+ * Equivalent elements keep their relative order. cmp is always called, the built-in comparison
+ * functions are not recognized.
+ *
+ * @param base Array to sort. Must not be NULL unless n is 0.
+ * @param n Number of elements.
+ * @param size Size of an element. Must be greater than 0.
+ * @param cmp Comparison function. Must not be NULL.
+ * @param stats If not NULL, filled with the statistics of the call.
+ * @return @ref E_SUCCESS, or @ref E_OUT_OF_MEMORY if the merge buffer of n / 2 elements cannot be
+ * allocated, in which case the array is left unchanged.
+ */
+ErrStatus util_stableSort(void *base, size_t n, size_t size, util_compare cmp, SortStats *stats);
+
+/* !SECTION */
+/* SECTION - Small array sorting */
+
+/**
+ * @brief Sorts a small array of ints with a sorting network, in the order of util_int_cmp().
+ *
+ * @details The array is padded to a power of 2 of at least 8 elements, and sorted with a bitonic
+ * network of branchless compare-exchanges, on AVX2 vectors if available. This avoids the
+ * mispredicted branches of an insertion sort and the calls to a comparison function.
+ * When AVX2 is enabled, util_sort() uses it for arrays of up to @ref UTIL_SMALL_SORT_MAX ints and
+ * for the ranges of up to @ref UTIL_SORT_INSERTION_THRESHOLD ints left by its introsort; the scalar
+ * network is not faster than an inlined insertion sort. Larger arrays are sorted as by util_sort().
+ *
+ * @param a Array to sort. Must not be NULL unless n is 0.
+ * @param n Number of elements.
+ */
+void util_int_smallSort(int *a, size_t n);
+
+/**
+ * @brief Sorts a small array of doubles with a sorting network, in the order of util_double_totalCmp().
+ *
+ * @details Same as util_int_smallSort(), on the bits of the doubles mapped to signed integers.
+ * The order is also valid for util_double_cmp(), for which util_sort() uses it as well when AVX2
+ * is enabled.
+ *
+ * @param a Array to sort. Must not be NULL unless n is 0.
+ * @param n Number of elements.
+ */
+void util_double_smallSort(double *a, size_t n);
+
+/* !SECTION */
+
+#endif
@@ -0,0 +1,275 @@
+/**
+ * @brief Macros that generate sorting and searching functions specialized for an element type.
+ *
+ * @details The functions of sort.h take a @ref util_compare, which is always called through a
+ * pointer. The macros of this header instead stamp out `static inline` functions for a concrete
+ * type, stored by value, and an order given as an expression, so that comparisons are inlined:
+ *
+ * @code
+ * typedef struct { int id; double score; } Entry;
+ * #define ENTRY_LESS(a, b) ((a).score < (b).score)
+ * UTIL_DEFINE_SORT(entries, Entry, ENTRY_LESS)
+ *
+ * entries_sort(array, n);
+ * size_t i = entries_lowerBound(array, n, (Entry) {.score = 0.5});
+ * @endcode
+ *
+ * less(a, b) must be true if a goes strictly before b, and must define a strict weak order.
+ * It may be a function-like macro or a function, and it may evaluate its arguments several times.
+ *
+ * @file sort_template.h
+ */
+
+#ifndef SORT_TEMPLATE_H
+#define SORT_TEMPLATE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @brief Ranges of at most this size are sorted with insertion sort.
+ */
+#define UTIL_SORT_INSERTION_THRESHOLD 16
+
+/**
+ * @brief Maximum recursion depth of an introsort of n > 0 elements before it switches to heapsort.
+ */
+static inline size_t util_sort_depthLimit(size_t n)
+{
+	return 2 * (size_t) (63 - __builtin_clzll((unsigned long long) n));
+}
+
+/**
+ * @brief Generates functions for arrays of type ordered by less(a, b, ctx),
+ * where ctx is an extra argument of type ctx_t passed to every function.
+ *
+ * @details The generated functions are:
+ * * `void name_sort(type *a, size_t n, ctx_t ctx)`: introsort, that is, quicksort with
+ *   median-of-three pivots, insertion sort for small ranges and heapsort once the recursion
+ *   gets too deep. Not stable. O(n log n) in the worst case.
+ * * `size_t name_lowerBound(type const *a, size_t n, type key, ctx_t ctx)`: index of the first
+ *   element of a sorted array that does not go before key, or n. Branchless binary search.
+ * * `type const *name_search(type const *a, size_t n, type key, ctx_t ctx)`: an element of a
+ *   sorted array equivalent to key, or NULL.
+ * * `void name_merge(type const *a, size_t na, type const *b, size_t nb, type *out, ctx_t ctx)`:
+ *   stable merge of two sorted arrays into out, which must not overlap them.
+ * * `bool name_isSorted(type const *a, size_t n, ctx_t ctx)`: whether an array is sorted.
+ *
+ * The partition scans are bounded, so an inconsistent order cannot make them leave the array.
+ */
+#define UTIL_DEFINE_SORT_CTX(name, type, ctx_t, less) UTIL_DEFINE_SORT_CTX_LEAF(name, type, ctx_t, less, name##_insertion)
+
+/**
+ * @brief Same as @ref UTIL_DEFINE_SORT_CTX, with the ranges of at most
+ * @ref UTIL_SORT_INSERTION_THRESHOLD elements left by the introsort sorted by
+ * `void leaf(type *a, size_t n, ctx_t ctx)` instead of insertion sort.
+ *
+ * @details leaf must sort in the order of less, and is meant for sorts specialized for the type,
+ * such as sorting networks.
+ */
+#define UTIL_DEFINE_SORT_CTX_LEAF(name, type, ctx_t, less, leaf)                                   \
+	static inline void name##_insertion(type *a, size_t n, ctx_t ctx)                              \
+	{                                                                                              \
+		for (size_t i = 1; i < n; i++) {                                                           \
+			type x   = a[i];                                                                       \
+			size_t j = i;                                                                          \
+			for (; j > 0 && less(x, a[j - 1], ctx); j--) {                                         \
+				a[j] = a[j - 1];                                                                   \
+			}                                                                                      \
+			a[j] = x;                                                                              \
+		}                                                                                          \
+	}                                                                                              \
+                                                                                                   \
+	static inline void name##_siftDown(type *a, size_t root, size_t n, ctx_t ctx)                  \
+	{                                                                                              \
+		type x = a[root];                                                                          \
+		size_t child;                                                                              \
+		while ((child = 2 * root + 1) < n) {                                                       \
+			if (child + 1 < n && less(a[child], a[child + 1], ctx)) {                              \
+				child++;                                                                           \
+			}                                                                                      \
+			if (!less(x, a[child], ctx)) {                                                         \
+				break;                                                                             \
+			}                                                                                      \
+			a[root] = a[child];                                                                    \
+			root    = child;                                                                       \
+		}                                                                                          \
+		a[root] = x;                                                                               \
+	}                                                                                              \
+                                                                                                   \
+	static inline void name##_heapsort(type *a, size_t n, ctx_t ctx)                               \
+	{                                                                                              \
+		for (size_t i = n / 2; i > 0; i--) {                                                       \
+			name##_siftDown(a, i - 1, n, ctx);                                                     \
+		}                                                                                          \
+		for (size_t i = n - 1; i > 0; i--) {                                                       \
+			type x = a[0];                                                                         \
+			a[0]   = a[i];                                                                         \
+			a[i]   = x;                                                                            \
+			name##_siftDown(a, 0, i, ctx);                                                         \
+		}                                                                                          \
+	}                                                                                              \
+                                                                                                   \
+	static inline void name##_introsort(type *a, size_t n, size_t depth, ctx_t ctx)                \
+	{                                                                                              \
+		while (n > UTIL_SORT_INSERTION_THRESHOLD) {                                                \
+			if (depth-- == 0) {                                                                    \
+				name##_heapsort(a, n, ctx);                                                        \
+				return;                                                                            \
+			}                                                                                      \
+                                                                                                   \
+			/* Median of three, moved to a[0], where it stays during partitioning */               \
+			size_t mid = n / 2;                                                                    \
+			type t;                                                                                \
+			if (less(a[mid], a[0], ctx)) {                                                         \
+				t = a[mid], a[mid] = a[0], a[0] = t;                                               \
+			}                                                                                      \
+			if (less(a[n - 1], a[mid], ctx)) {                                                     \
+				t = a[mid], a[mid] = a[n - 1], a[n - 1] = t;                                       \
+			}                                                                                      \
+			if (less(a[mid], a[0], ctx)) {                                                         \
+				t = a[mid], a[mid] = a[0], a[0] = t;                                               \
+			}                                                                                      \
+			t = a[mid], a[mid] = a[0], a[0] = t;                                                   \
+                                                                                                   \
+			size_t i = 0;                                                                          \
+			size_t j = n;                                                                          \
+			for (;;) {                                                                             \
+				while (++i < n - 1 && less(a[i], a[0], ctx)) {                                     \
+				}                                                                                  \
+				while (--j > 0 && less(a[0], a[j], ctx)) {                                         \
+				}                                                                                  \
+				if (i >= j) {                                                                      \
+					break;                                                                         \
+				}                                                                                  \
+				t = a[i], a[i] = a[j], a[j] = t;                                                   \
+			}                                                                                      \
+			t = a[0], a[0] = a[j], a[j] = t;                                                       \
+                                                                                                   \
+			/* Recurse into the smaller side, so that the stack stays logarithmic */               \
+			if (j < n - j - 1) {                                                                   \
+				name##_introsort(a, j, depth, ctx);                                                \
+				a += j + 1;                                                                        \
+				n -= j + 1;                                                                        \
+			} else {                                                                               \
+				name##_introsort(a + j + 1, n - j - 1, depth, ctx);                                \
+				n = j;                                                                             \
+			}                                                                                      \
+		}                                                                                          \
+		leaf(a, n, ctx);                                                                           \
+	}                                                                                              \
+                                                                                                   \
+	static inline void name##_sort(type *a, size_t n, ctx_t ctx)                                   \
+	{                                                                                              \
+		if (n > 1) {                                                                               \
+			name##_introsort(a, n, util_sort_depthLimit(n), ctx);                                  \
+		}                                                                                          \
+	}                                                                                              \
+                                                                                                   \
+	static inline size_t name##_lowerBound(type const *a, size_t n, type key, ctx_t ctx)           \
+	{                                                                                              \
+		if (n == 0) {                                                                              \
+			return 0;                                                                              \
+		}                                                                                          \
+		type const *base = a;                                                                      \
+		while (n > 1) {                                                                            \
+			size_t half = n / 2;                                                                   \
+			base        = less(base[half], key, ctx) ? base + half : base;                         \
+			n -= half;                                                                             \
+		}                                                                                          \
+		return (size_t) (base - a) + less(*base, key, ctx);                                        \
+	}                                                                                              \
+                                                                                                   \
+	static inline type const *name##_search(type const *a, size_t n, type key, ctx_t ctx)          \
+	{                                                                                              \
+		size_t i = name##_lowerBound(a, n, key, ctx);                                              \
+		return i < n && !less(key, a[i], ctx) ? &a[i] : NULL;                                      \
+	}                                                                                              \
+                                                                                                   \
+	static inline void name##_merge(type const *a, size_t na, type const *b, size_t nb, type *out, \
+									ctx_t ctx)                                                     \
+	{                                                                                              \
+		size_t i = 0;                                                                              \
+		size_t j = 0;                                                                              \
+		while (i < na && j < nb) {                                                                 \
+			*out++ = less(b[j], a[i], ctx) ? b[j++] : a[i++];                                      \
+		}                                                                                          \
+		while (i < na) {                                                                           \
+			*out++ = a[i++];                                                                       \
+		}                                                                                          \
+		while (j < nb) {                                                                           \
+			*out++ = b[j++];                                                                       \
+		}                                                                                          \
+	}                                                                                              \
+                                                                                                   \
+	static inline bool name##_isSorted(type const *a, size_t n, ctx_t ctx)                         \
+	{                                                                                              \
+		for (size_t i = 1; i < n; i++) {                                                           \
+			if (less(a[i], a[i - 1], ctx)) {                                                       \
+				return false;                                                                      \
+			}                                                                                      \
+		}                                                                                          \
+		return true;                                                                               \
+	}
+
+/**
+ * @brief Generates functions for arrays of type ordered by less(a, b).
+ *
+ * @details Same functions as @ref UTIL_DEFINE_SORT_CTX, without the ctx argument:
+ * `name_sort(a, n)`, `name_lowerBound(a, n, key)`, `name_search(a, n, key)`,
+ * `name_merge(a, na, b, nb, out)` and `name_isSorted(a, n)`.
+ */
+#define UTIL_DEFINE_SORT(name, type, less) UTIL_DEFINE_SORT_LEAF(name, type, less, name##_ctx_insertionLeaf)
+
+/**
+ * @brief Same as @ref UTIL_DEFINE_SORT, with the small ranges left by the introsort sorted by
+ * `void leaf(type *a, size_t n)` instead of insertion sort. See @ref UTIL_DEFINE_SORT_CTX_LEAF.
+ */
+#define UTIL_DEFINE_SORT_LEAF(name, type, less, leaf)                                              \
+	static inline bool name##_lessCtx(type x, type y, void *ctx)                                   \
+	{                                                                                              \
+		(void) ctx;                                                                                \
+		return less(x, y);                                                                         \
+	}                                                                                              \
+                                                                                                   \
+	static inline void name##_leafCtx(type *a, size_t n, void *ctx);                               \
+                                                                                                   \
+	UTIL_DEFINE_SORT_CTX_LEAF(name##_ctx, type, void *, name##_lessCtx, name##_leafCtx)            \
+                                                                                                   \
+	static inline void name##_ctx_insertionLeaf(type *a, size_t n)                                 \
+	{                                                                                              \
+		name##_ctx_insertion(a, n, NULL);                                                          \
+	}                                                                                              \
+                                                                                                   \
+	static inline void name##_leafCtx(type *a, size_t n, void *ctx)                                \
+	{                                                                                              \
+		(void) ctx;                                                                                \
+		leaf(a, n);                                                                                \
+	}                                                                                              \
+                                                                                                   \
+	static inline void name##_sort(type *a, size_t n)                                              \
+	{                                                                                              \
+		name##_ctx_sort(a, n, NULL);                                                               \
+	}                                                                                              \
+                                                                                                   \
+	static inline size_t name##_lowerBound(type const *a, size_t n, type key)                      \
+	{                                                                                              \
+		return name##_ctx_lowerBound(a, n, key, NULL);                                             \
+	}                                                                                              \
+                                                                                                   \
+	static inline type const *name##_search(type const *a, size_t n, type key)                     \
+	{                                                                                              \
+		return name##_ctx_search(a, n, key, NULL);                                                 \
+	}                                                                                              \
+                                                                                                   \
+	static inline void name##_merge(type const *a, size_t na, type const *b, size_t nb, type *out) \
+	{                                                                                              \
+		name##_ctx_merge(a, na, b, nb, out, NULL);                                                 \
+	}                                                                                              \
+                                                                                                   \
+	static inline bool name##_isSorted(type const *a, size_t n)                                    \
+	{                                                                                              \
+		return name##_ctx_isSorted(a, n, NULL);                                                    \
+	}
+
+#endif
@@ -0,0 +1,200 @@
+/**
+ * @brief Tagged immediate values: chars, ints and doubles stored inline in a `void *`.
+ *
+ * @details Data structures built on the function types of utilities.h store elements as
+ * `void *`, so primitives are usually malloc'ed one by one. A tagged value instead encodes
+ * the primitive in the bits of the pointer itself, so it needs no allocation and reading it
+ * needs no memory access. Tagged values must never be dereferenced: use the util_tagged_*
+ * functions, which recognize the type of a value from its tag.
+ *
+ * The encoding is NaN-boxing on the 64 bits of the pointer:
+ * * NULL is the null element, as with malloc'ed elements.
+ * * Chars have the top 16 bits set to 0x0001, and the char in the low 8 bits.
+ * * Ints have the top 16 bits set to 0xFFFF, and the int in the low 32 bits.
+ * * Doubles are stored as their bits plus 2^49, which maps them to the remaining top 16 bit
+ *   patterns. All NaNs are stored as the same quiet NaN.
+ *
+ * Tagged values require 64-bit pointers.
+ *
+ * @file tagged.h
+ */
+
+#ifndef TAGGED_H
+#define TAGGED_H
+
+#include "dbg.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+/* SECTION - Encoding */
+
+/**
+ * @brief Creates a tagged char.
+ *
+ * @param c Char to store.
+ * @return Tagged value, which is never NULL and must not be dereferenced.
+ */
+void *util_tagged_fromChar(char c);
+
+/**
+ * @brief Creates a tagged int.
+ *
+ * @param i Integer to store.
+ * @return Tagged value, which is never NULL and must not be dereferenced.
+ */
+void *util_tagged_fromInt(int i);
+
+/**
+ * @brief Creates a tagged double.
+ *
+ * @param d Value to store. NaNs lose their sign and payload.
+ * @return Tagged value, which is never NULL and must not be dereferenced.
+ */
+void *util_tagged_fromDouble(double d);
+
+/**
+ * @brief Tests whether a value is a tagged char.
+ *
+ * @param v Value.
+ * @return `true` if v was created with util_tagged_fromChar(), `false` otherwise.
+ */
+bool util_tagged_isChar(const void *v);
+
+/**
+ * @brief Tests whether a value is a tagged int.
+ *
+ * @param v Value.
+ * @return `true` if v was created with util_tagged_fromInt(), `false` otherwise.
+ */
+bool util_tagged_isInt(const void *v);
+
+/**
+ * @brief Tests whether a value is a tagged double.
+ *
+ * @param v Value.
+ * @return `true` if v was created with util_tagged_fromDouble(), `false` otherwise.
+ */
+bool util_tagged_isDouble(const void *v);
+
+/**
+ * @brief Char stored in a tagged value.
+ *
+ * @param v Tagged char. Must be a char.
+ * @return Char.
+ */
+char util_tagged_char(const void *v);
+
+/**
+ * @brief Integer stored in a tagged value.
+ *
+ * @param v Tagged int. Must be an int.
+ * @return Integer.
+ */
+int util_tagged_int(const void *v);
+
+/**
+ * @brief Number stored in a tagged value.
+ *
+ * @param v Tagged int or double. Must be an int or a double.
+ * @return Value, converted to double if it is an int.
+ */
+double util_tagged_double(const void *v);
+
+/* !SECTION */
+/* SECTION - Element functions */
+
+/**
+ * @brief Print a tagged value, followed by a space, in the same format as util_char_print(),
+ * util_int_print() or util_double_print(). See @ref util_print.
+ *
+ * @param file A pointer to the stream. Must not be NULL.
+ * @param v Tagged value. @ref DEF_NULL is printed if NULL.
+ * @return Number of bytes printed.
+ * Returns a negative number if there were errors while printing
+ */
+int util_tagged_print(FILE *file, const void *v);
+
+/**
+ * @brief Compares two tagged values. See @ref util_compare.
+ *
+ * @details Ints and doubles are compared by their numeric value, so -0.0 equals 0.0.
+ * NaN, which has a single tagged representation, is ordered after every number and is equal
+ * to itself, so this is a total order. Chars are compared as util_char_cmp() does, and are
+ * ordered before numbers.
+ *
+ * @param v1 First tagged value.
+ * @param v2 Second tagged value.
+ * @return A negative integer, zero, or a positive integer as v1 is less than, equal to, or greater than v2.
+ * NULL is ordered before all values.
+ */
+int util_tagged_cmp(const void *v1, const void *v2);
+
+/**
+ * @brief Tests whether two tagged values are equal. See @ref util_equal.
+ *
+ * @param v1 First tagged value.
+ * @param v2 Second tagged value.
+ * @return `true` if util_tagged_cmp() returns 0, `false` otherwise.
+ */
+bool util_tagged_equal(const void *v1, const void *v2);
+
+/**
+ * @brief Converts a tagged value to string, as util_char_toString(), util_int_toString()
+ * or util_double_toString() do. See @ref util_toString.
+ *
+ * @param v Tagged value.
+ * @return String that represents the value. Must be freed after use.
+ * NULL if v is NULL or if malloc fails. In this case, the errno value is set.
+ */
+char *util_tagged_toString(const void *v);
+
+/**
+ * @brief Writes the string representation of a tagged value into a buffer. See @ref util_toBuffer.
+ *
+ * @param buf Buffer to write to. May be NULL if size is 0.
+ * @param size Size of the buffer in bytes.
+ * @param v Tagged value.
+ * @return Length of the string representation. -1 if v is NULL.
+ */
+int util_tagged_toBuffer(char *buf, size_t size, const void *v);
+
+/**
+ * @brief Creates a tagged char from the first character of a string. See @ref util_elemFromString.
+ *
+ * @param str String. Must not be NULL.
+ * @return Tagged char. Never NULL.
+ */
+void *util_tagged_charFromString(const char *str);
+
+/**
+ * @brief Creates a tagged int from a string, with the same syntax as util_int_fromString().
+ * See @ref util_elemFromString.
+ *
+ * @param str String with the integer (base 10). Must not be NULL. Trailing characters are ignored.
+ * @return Tagged int. NULL if the string could not be parsed. In this case, errno is set to ERANGE
+ * if the integer is out of range, or to 0 if no integer could be parsed.
+ */
+void *util_tagged_intFromString(const char *str);
+
+/**
+ * @brief Creates a tagged double from a string, with the same syntax as util_double_fromString().
+ * See @ref util_elemFromString.
+ *
+ * @param str String with the double. Must not be NULL. Trailing characters are ignored.
+ * @return Tagged double. NULL if the string could not be parsed. In this case, errno is set to ERANGE
+ * if the value is out of range, or to 0 if no value could be parsed.
+ */
+void *util_tagged_doubleFromString(const char *str);
+
+/**
+ * @brief Frees a tagged value, which is no-op. See @ref util_free.
+ *
+ * @param v Tagged value.
+ */
+void util_tagged_free(void *v);
+
+/* !SECTION */
+
+#endif
@@ -10,9 +10,27 @@
 
 #define _POSIX_C_SOURCE 200809L // NOLINT
 
+#include "dbg.h"
+
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 
+/**
+ * @brief Size of a buffer large enough to hold the string representation of any pointer,
+ * char, int or double written by the util_*_toBuffer functions, including the terminating null byte.
+ */
+#define UTIL_PRIMITIVE_BUFSIZE 32
+
+/**
+ * @brief Non-owning view of a sequence of characters, which is not necessarily null-terminated.
+ */
+typedef struct {
+	const char *str; /**< First character */
+	size_t len;      /**< Number of characters */
+} StringView;
+
 /* SECTION - Function types */
 
 /**
@@ -56,6 +74,23 @@ typedef int (*util_compare)(const void *elem1, const void *elem2);
  */
 typedef char *(*util_toString)(const void *elem);
 
+/**
+ * @brief Function type to write the string representation of an element into a caller-provided buffer.
+ *
+ * @details Non-allocating counterpart of @ref util_toString. The semantics follow those of snprintf():
+ * at most `size` bytes are written, including the terminating null byte, so a single buffer
+ * may be reused to convert any number of elements.
+ *
+ * @param buf Buffer to write to. May be NULL if size is 0.
+ * @param size Size of the buffer in bytes.
+ * @param elem Element to convert to string.
+ *
+ * @return Length of the string representation, excluding the terminating null byte.
+ * If the returned value is greater than or equal to size, the output was truncated.
+ * A negative number is returned if the element is NULL (implementation defined) or if there were errors.
+ */
+typedef int (*util_toBuffer)(char *buf, size_t size, const void *elem);
+
 /**
  * @brief Function type to convert strings to elements.
  *
@@ -71,6 +106,23 @@ typedef char *(*util_toString)(const void *elem);
  */
 typedef void *(*util_elemFromString)(const char *str);
 
+/**
+ * @brief Function type to parse an element from a length-delimited buffer into caller-provided storage.
+ *
+ * @details Non-allocating counterpart of @ref util_elemFromString. The buffer does not need to be
+ * null-terminated and is never read past str + len, so fields can be parsed in place from
+ * memory-mapped files or network buffers. errno is not modified.
+ *
+ * @param str Start of the buffer. Must not be NULL.
+ * @param len Number of bytes that may be read.
+ * @param out Storage for the element, which must be large enough for its type. Must not be NULL.
+ * @param end If not NULL, set to the first byte after the element, or to str if it could not be parsed.
+ *
+ * @return @ref E_SUCCESS if the element was parsed, @ref E_INVALID_ARG if it could not be parsed,
+ * or another error code depending on the type.
+ */
+typedef ErrStatus (*util_parse)(const char *str, size_t len, void *out, const char **end);
+
 /**
  * @brief Function type to free an element
  *
@@ -105,6 +157,105 @@ typedef bool (*util_predicate)(const void *elem);
  */
 typedef bool (*util_equal)(const void *elem1, const void *elem2);
 
+/**
+ * @brief Function type to hash an element.
+ *
+ * @details The function type shall be consistent with the @ref util_equal function of the type:
+ * equal elements must have the same hash.
+ *
+ * @param elem Element to hash.
+ *
+ * @return Hash of the element. 0 if the element is NULL.
+ */
+typedef uint64_t (*util_hash)(const void *elem);
+
+/**
+ * @brief Function type to write the normalized sort key of an element: a sequence of bytes such
+ * that comparing the keys of two elements with util_compareKeys() orders them as their
+ * @ref util_compare function does.
+ *
+ * @details Keys let sorts and ordered structures compare contiguous bytes instead of calling
+ * a comparison function through a pointer. The key of NULL is the single byte @ref UTIL_KEY_NULL,
+ * and the keys of other elements start with @ref UTIL_KEY_PRESENT. Together with keys of other
+ * elements that are prefix-free, this ensures that no key is a proper prefix of another key of
+ * the same type, NULL included, so the keys of several fields can be concatenated into the key
+ * of a composite element, ordered by the first field, then the second, and so on. The semantics
+ * of size follow those of snprintf(): at most size bytes are written, so the length of a key can
+ * be queried with size 0.
+ *
+ * @param buf Buffer to write to. May be NULL if size is 0.
+ * @param size Size of the buffer in bytes.
+ * @param elem Element. NULL is ordered first.
+ *
+ * @return Length of the key. If it is greater than size, the key was truncated.
+ */
+typedef size_t (*util_sortKey)(unsigned char *buf, size_t size, const void *elem);
+
+/* !SECTION */
+/* SECTION - Type descriptors */
+
+/**
+ * @brief Built-in types, so that generic code can select specialized paths for them.
+ */
+typedef enum {
+	UTIL_KIND_CUSTOM,  /**< Type not known by the library */
+	UTIL_KIND_CHAR,    /**< char */
+	UTIL_KIND_INT,     /**< int */
+	UTIL_KIND_DOUBLE,  /**< double */
+	UTIL_KIND_STRING,  /**< Null-terminated string */
+	UTIL_KIND_GENERIC, /**< Pointers compared by address */
+} UtilKind;
+
+/**
+ * @brief Descriptor of an element type: all the functions a data structure needs to handle
+ * its elements, bundled so that it only has to carry one pointer.
+ *
+ * @details Descriptors are meant to be static and constant. Members that a type does not
+ * support are NULL.
+ */
+typedef struct {
+	const char *name;               /**< Name of the type, for diagnostics */
+	UtilKind kind;                  /**< Built-in type, or @ref UTIL_KIND_CUSTOM */
+	size_t size;                    /**< Size of an element, or 0 if elements have a variable size */
+	size_t align;                   /**< Alignment of an element, or 0 if elements have a variable size */
+	util_print print;               /**< Prints an element */
+	util_compare cmp;               /**< Compares two elements */
+	util_equal equal;               /**< Tests two elements for equality */
+	util_hash hash;                 /**< Hashes an element, consistently with equal */
+	util_sortKey sortKey;           /**< Writes the normalized sort key of an element, equal keys iff cmp returns 0 */
+	util_toString toString;         /**< Converts an element to a malloc'ed string */
+	util_toBuffer toBuffer;         /**< Writes an element into a buffer */
+	util_elemFromString fromString; /**< Creates an element from a string */
+	util_parse parse;               /**< Parses an element into caller-provided storage */
+	util_free free;                 /**< Frees an element created with fromString */
+} UtilType;
+
+/**
+ * @brief Descriptor of chars.
+ */
+extern const UtilType UTIL_TYPE_CHAR;
+
+/**
+ * @brief Descriptor of ints.
+ */
+extern const UtilType UTIL_TYPE_INT;
+
+/**
+ * @brief Descriptor of doubles, ordered by util_double_totalCmp(), so that NaNs can be stored
+ * in sorted and hashed containers. Its equal and hash functions match that order.
+ */
+extern const UtilType UTIL_TYPE_DOUBLE;
+
+/**
+ * @brief Descriptor of null-terminated strings. Elements are the strings themselves (`char *`).
+ */
+extern const UtilType UTIL_TYPE_STRING;
+
+/**
+ * @brief Descriptor of opaque pointers, which are only compared by address.
+ */
+extern const UtilType UTIL_TYPE_GENERIC;
+
 /* !SECTION */
 /* SECTION - Printing functions */
 
@@ -142,7 +293,7 @@ int util_int_print(FILE *file, const void *i);
 
 /**
  * @brief Print a double precision value, followed by a space.
- * Format uses %g specifier and DBL_DIG significant digits.
+ * Format uses the shortest representation that parses back to the same value (see util_formatDouble()).
  *
  * @param file A pointer to the stream. Must not be NULL.
  * @param d A pointer to the value to print. @ref DEF_NULL is printed if NULL.
@@ -194,11 +345,56 @@ int util_int_cmp(const void *int1, const void *int2);
  * @return A negative integer, zero, or a positive integer as double1
  * is less than, equal to, or greater than the specified double2.
  * NULL is always ordered before any other element, and is always equal to itself.
+ *
+ * @warning NaN compares equal to every value, so this is not a total order if NaN may occur.
+ * Use util_double_totalCmp() instead.
  */
 int util_double_cmp(const void *double1, const void *double2);
 
 /**
- * @brief Compare two strings.
+ * @brief Compare two double precision values according to the totalOrder predicate of IEEE 754.
+ *
+ * @details The order is: negative NaNs, -infinity, negative numbers, -0.0, 0.0, positive numbers,
+ * infinity, positive NaNs. NaNs are ordered by payload. Unlike util_double_cmp(), this is a total
+ * order over all the doubles. The values are compared as integer keys, without branches.
+ *
+ * @param double1 Pointer to the first value.
+ * @param double2 Pointer to the second value.
+ * @return A negative integer, zero, or a positive integer as double1
+ * is less than, equal to, or greater than the specified double2.
+ * NULL is always ordered before any other element, and is always equal to itself.
+ */
+int util_double_totalCmp(const void *double1, const void *double2);
+
+/**
+ * @brief Compares the doubles of two arrays pairwise, as util_double_totalCmp() does.
+ *
+ * @details The loop has no branches and can be vectorized by the compiler.
+ *
+ * @param doubles1 First array. Must not be NULL unless n is 0.
+ * @param doubles2 Second array. Must not be NULL unless n is 0.
+ * @param results Array where -1, 0 or 1 is written for each pair. Must not be NULL unless n is 0.
+ * @param n Number of pairs.
+ */
+void util_double_totalCmpBatch(const double *doubles1, const double *doubles2, int *results, size_t n);
+
+/**
+ * @brief Maps a double to an unsigned integer key whose order is the totalOrder of IEEE 754.
+ *
+ * @details The sign bit is flipped for positive values and all the bits are flipped for negative
+ * ones, so that keys can be compared, sorted or hashed as integers.
+ *
+ * @param d Value.
+ * @return Key of the value.
+ */
+uint64_t util_double_totalKey(double d);
+
+/**
+ * @brief Compare two strings, in the same order as strcmp().
+ *
+ * @details When the library is built with SSE2 or AVX2, the first 16 or 32 bytes are compared
+ * inline with vector instructions, which settles most short keys without calling strcmp().
+ * The vector loads never cross a page boundary past the end of a string.
  *
  * @param str1 First string.
  * @param str2 Second string.
@@ -208,6 +404,179 @@ int util_double_cmp(const void *double1, const void *double2);
  */
 int util_string_cmp(const void *str1, const void *str2);
 
+/* !SECTION */
+/* SECTION - Equality functions */
+
+/**
+ * @brief Tests whether two chars are equal.
+ *
+ * @param char1 Pointer to the first char.
+ * @param char2 Pointer to the second char.
+ * @return `true` if both chars are equal or both pointers are NULL, `false` otherwise.
+ */
+bool util_char_equal(const void *char1, const void *char2);
+
+/**
+ * @brief Tests whether two integers are equal.
+ *
+ * @param int1 Pointer to the first integer.
+ * @param int2 Pointer to the second integer.
+ * @return `true` if both integers are equal or both pointers are NULL, `false` otherwise.
+ */
+bool util_int_equal(const void *int1, const void *int2);
+
+/**
+ * @brief Tests whether two doubles are equal, consistently with util_double_cmp() except for NaNs.
+ *
+ * @details 0.0 and -0.0 are equal, and all the NaNs are equal to each other and to nothing else,
+ * so that this is an equivalence relation, unlike util_double_cmp() returning 0.
+ *
+ * @param double1 Pointer to the first double.
+ * @param double2 Pointer to the second double.
+ * @return `true` if both values are equal or both pointers are NULL, `false` otherwise.
+ */
+bool util_double_equal(const void *double1, const void *double2);
+
+/**
+ * @brief Tests whether two doubles are equal, consistently with util_double_totalCmp():
+ * 0.0 and -0.0 differ, and so do NaNs with different signs or payloads.
+ *
+ * @param double1 Pointer to the first double.
+ * @param double2 Pointer to the second double.
+ * @return `true` if both values have the same bits or both pointers are NULL, `false` otherwise.
+ */
+bool util_double_totalEqual(const void *double1, const void *double2);
+
+/**
+ * @brief Tests whether two strings are equal, with the same vector kernel as util_string_cmp().
+ *
+ * @param str1 First string.
+ * @param str2 Second string.
+ * @return `true` if both strings have the same characters or both are NULL, `false` otherwise.
+ */
+bool util_string_equal(const void *str1, const void *str2);
+
+/* !SECTION */
+/* SECTION - Hash functions */
+
+/**
+ * @brief Hashes a pointer by its address.
+ *
+ * @param p Pointer.
+ * @return Hash of the address. 0 if p is NULL.
+ */
+uint64_t util_generic_hash(const void *p);
+
+/**
+ * @brief Hashes a char.
+ *
+ * @param c Pointer to the char.
+ * @return Hash of the char. 0 if c is NULL.
+ */
+uint64_t util_char_hash(const void *c);
+
+/**
+ * @brief Hashes an integer.
+ *
+ * @param i Pointer to the integer.
+ * @return Hash of the integer. 0 if i is NULL.
+ */
+uint64_t util_int_hash(const void *i);
+
+/**
+ * @brief Hashes a double, consistently with util_double_equal(): 0.0 and -0.0 have the same hash,
+ * and so do all the NaNs.
+ *
+ * @param d Pointer to the double.
+ * @return Hash of the value. 0 if d is NULL.
+ */
+uint64_t util_double_hash(const void *d);
+
+/**
+ * @brief Hashes a double, consistently with util_double_totalEqual().
+ *
+ * @param d Pointer to the double.
+ * @return Hash of the value. 0 if d is NULL.
+ */
+uint64_t util_double_totalHash(const void *d);
+
+/**
+ * @brief Hashes a string.
+ *
+ * @param s String.
+ * @return Hash of the characters. 0 if s is NULL.
+ */
+uint64_t util_string_hash(const void *s);
+
+/* !SECTION */
+/* SECTION - Sort key functions */
+
+#define UTIL_KEY_NULL       0x00 /**< Sort key of NULL, which is ordered first */
+#define UTIL_KEY_PRESENT    0x01 /**< First byte of the sort key of any element other than NULL */
+#define UTIL_CHAR_KEYSIZE   2    /**< Length of the sort key of a char, including the leading byte */
+#define UTIL_INT_KEYSIZE    5    /**< Length of the sort key of an int, including the leading byte */
+#define UTIL_DOUBLE_KEYSIZE 9    /**< Length of the sort key of a double, including the leading byte */
+
+/**
+ * @brief Compares two sort keys byte by byte, as unsigned chars. A key that is a prefix of the
+ * other goes first.
+ *
+ * @param key1 First key. May be NULL if len1 is 0.
+ * @param len1 Length of the first key.
+ * @param key2 Second key. May be NULL if len2 is 0.
+ * @param len2 Length of the second key.
+ * @return A negative integer, zero, or a positive integer as key1
+ * is less than, equal to, or greater than key2.
+ */
+int util_compareKeys(const unsigned char *key1, size_t len1, const unsigned char *key2, size_t len2);
+
+/**
+ * @brief Writes the sort key of a char: @ref UTIL_KEY_PRESENT and the char as an unsigned byte,
+ * consistent with util_char_cmp().
+ *
+ * @param buf Buffer to write to. May be NULL if size is 0.
+ * @param size Size of the buffer in bytes.
+ * @param c Pointer to the char. NULL has the key @ref UTIL_KEY_NULL.
+ * @return Length of the key: @ref UTIL_CHAR_KEYSIZE, or 1 if c is NULL.
+ */
+size_t util_char_sortKey(unsigned char *buf, size_t size, const void *c);
+
+/**
+ * @brief Writes the sort key of an integer: @ref UTIL_KEY_PRESENT and the big-endian bytes with
+ * the sign bit flipped, consistent with util_int_cmp().
+ *
+ * @param buf Buffer to write to. May be NULL if size is 0.
+ * @param size Size of the buffer in bytes.
+ * @param i Pointer to the integer. NULL has the key @ref UTIL_KEY_NULL.
+ * @return Length of the key: @ref UTIL_INT_KEYSIZE, or 1 if i is NULL.
+ */
+size_t util_int_sortKey(unsigned char *buf, size_t size, const void *i);
+
+/**
+ * @brief Writes the sort key of a double: @ref UTIL_KEY_PRESENT and the big-endian bytes of
+ * util_double_totalKey().
+ *
+ * @details The keys follow util_double_totalCmp(), which refines util_double_cmp():
+ * -0.0 goes before 0.0, and NaNs are ordered at both ends.
+ *
+ * @param buf Buffer to write to. May be NULL if size is 0.
+ * @param size Size of the buffer in bytes.
+ * @param d Pointer to the double. NULL has the key @ref UTIL_KEY_NULL.
+ * @return Length of the key: @ref UTIL_DOUBLE_KEYSIZE, or 1 if d is NULL.
+ */
+size_t util_double_sortKey(unsigned char *buf, size_t size, const void *d);
+
+/**
+ * @brief Writes the sort key of a string: @ref UTIL_KEY_PRESENT, then its characters followed by
+ * the terminating null byte, consistent with util_string_cmp().
+ *
+ * @param buf Buffer to write to. May be NULL if size is 0.
+ * @param size Size of the buffer in bytes.
+ * @param s String. NULL has the key @ref UTIL_KEY_NULL.
+ * @return Length of the key: the length of the string plus 2, or 1 if s is NULL.
+ */
+size_t util_string_sortKey(unsigned char *buf, size_t size, const void *s);
+
 /* !SECTION */
 /* SECTION - Conversion to string functions */
 
@@ -245,7 +614,7 @@ char *util_int_toString(const void *i);
  *
  * @param d Pointer to the value.
  * @return String with the printed double. Must be freed after use.
- * Format uses %g specifier and DBL_DIG significant digits.
+ * Format uses the shortest representation that parses back to the same value (see util_formatDouble()).
  * NULL is returned if the element is NULL or if malloc fails (use errno to know which one).
  */
 char *util_double_toString(const void *d);
@@ -259,6 +628,67 @@ char *util_double_toString(const void *d);
  */
 char *util_string_toString(const void *s);
 
+/* !SECTION */
+/* SECTION - Conversion to buffer functions */
+
+/**
+ * @brief Writes the address of an element to a buffer.
+ * Format prints the memory address in an hexadecimal format, with leading '0x'.
+ *
+ * @param buf Buffer to write to. May be NULL if size is 0.
+ * @param size Size of the buffer. @ref UTIL_PRIMITIVE_BUFSIZE is always enough.
+ * @param e Pointer to print.
+ * @return Length of the string representation, as snprintf().
+ * A negative number is returned if the element is NULL.
+ */
+int util_generic_toBuffer(char *buf, size_t size, const void *e);
+
+/**
+ * @brief Writes a signed character to a buffer.
+ *
+ * @param buf Buffer to write to. May be NULL if size is 0.
+ * @param size Size of the buffer. @ref UTIL_PRIMITIVE_BUFSIZE is always enough.
+ * @param c Pointer to the character.
+ * @return Length of the string representation, as snprintf().
+ * A negative number is returned if the element is NULL.
+ */
+int util_char_toBuffer(char *buf, size_t size, const void *c);
+
+/**
+ * @brief Writes a signed integer to a buffer.
+ *
+ * @param buf Buffer to write to. May be NULL if size is 0.
+ * @param size Size of the buffer. @ref UTIL_PRIMITIVE_BUFSIZE is always enough.
+ * @param i Pointer to the integer.
+ * @return Length of the string representation, as snprintf().
+ * Format uses %d specifier.
+ * A negative number is returned if the element is NULL.
+ */
+int util_int_toBuffer(char *buf, size_t size, const void *i);
+
+/**
+ * @brief Writes a double precision value to a buffer.
+ *
+ * @param buf Buffer to write to. May be NULL if size is 0.
+ * @param size Size of the buffer. @ref UTIL_PRIMITIVE_BUFSIZE is always enough.
+ * @param d Pointer to the value.
+ * @return Length of the string representation, as snprintf().
+ * Format uses the shortest representation that parses back to the same value (see util_formatDouble()).
+ * A negative number is returned if the element is NULL.
+ */
+int util_double_toBuffer(char *buf, size_t size, const void *d);
+
+/**
+ * @brief Copies a string to a buffer.
+ *
+ * @param buf Buffer to write to. May be NULL if size is 0.
+ * @param size Size of the buffer.
+ * @param s String.
+ * @return Length of the string, as snprintf().
+ * A negative number is returned if the element is NULL or if its length exceeds INT_MAX.
+ */
+int util_string_toBuffer(char *buf, size_t size, const void *s);
+
 /* !SECTION */
 /* SECTION - String parsing functions */
 
@@ -276,7 +706,8 @@ void *util_char_fromString(const char *str);
  * @brief Creates an integer from a string.
  *
  * @param str String with the integer (base 10). Must not be NULL.
- * Trailing characters after the number are ignored. Parsing is done with strtol().
+ * Trailing characters after the number are ignored. Parsing is done with util_strtoi(),
+ * which accepts the same input as strtol() but does not depend on the locale.
  * @return Pointer to the integer created. Must be freed after use.
  * NULL is returned if malloc fails or if the string could not be parsed.
  * In this case, the errno value is set. If errno is 0, no integer could be parsed.
@@ -287,7 +718,7 @@ void *util_int_fromString(const char *str);
  * @brief Creates a double from a string.
  *
  * @param str String with the double. Must not be NULL.
- * Trailing characters after the number are ignored. Parsing is done with strtod().
+ * Trailing characters after the number are ignored. Parsing is done with util_strtod().
  * @return Pointer to the double created. Must be freed after use.
  * NULL is returned if malloc fails or if the string could not be parsed.
  * In this case, the errno value is set. If errno is 0, no value could be parsed.
@@ -303,6 +734,89 @@ void *util_double_fromString(const char *str);
  */
 void *util_string_fromString(const char *str);
 
+/**
+ * @brief Parses an integer from a string, without logging or modifying errno.
+ *
+ * @details Quiet counterpart of util_int_fromString() for inputs with many invalid values,
+ * where logging every failure would cost more than the parsing itself.
+ *
+ * @param str String with the integer (base 10). Must not be NULL.
+ * Trailing characters after the number are ignored.
+ * @param i Set to the value read, clamped to [INT_MIN, INT_MAX]. Not modified if no integer was found.
+ * Must not be NULL.
+ * @param offset If not NULL, set to the offset of the first character after the number,
+ * or to 0 if no integer was found.
+ * @return @ref E_SUCCESS, @ref E_INVALID_ARG if no integer was found,
+ * or @ref E_OUT_OF_RANGE if the value does not fit in an int.
+ */
+ErrStatus util_int_tryFromString(const char *str, int *i, size_t *offset);
+
+/**
+ * @brief Parses a double from a string, without logging or modifying errno.
+ *
+ * @details Quiet counterpart of util_double_fromString() for inputs with many invalid values,
+ * where logging every failure would cost more than the parsing itself.
+ *
+ * @param str String with the double. Must not be NULL.
+ * Trailing characters after the number are ignored.
+ * @param d Set to the value read (as returned by strtod() if out of range).
+ * Not modified if no value was found. Must not be NULL.
+ * @param offset If not NULL, set to the offset of the first character after the number,
+ * or to 0 if no value was found.
+ * @return @ref E_SUCCESS, @ref E_INVALID_ARG if no value was found,
+ * or @ref E_OUT_OF_RANGE if the value overflows or underflows.
+ */
+ErrStatus util_double_tryFromString(const char *str, double *d, size_t *offset);
+
+/* !SECTION */
+/* SECTION - Length-delimited parsing functions */
+
+/**
+ * @brief Parses a character: the first byte of the buffer.
+ *
+ * @param str Start of the buffer. Must not be NULL.
+ * @param len Number of bytes that may be read.
+ * @param c Pointer to a char, set to the first byte. Must not be NULL.
+ * @param end If not NULL, set to str + 1, or to str if len is 0.
+ * @return @ref E_SUCCESS, or @ref E_INVALID_ARG if len is 0.
+ */
+ErrStatus util_char_parse(const char *str, size_t len, void *c, const char **end);
+
+/**
+ * @brief Parses an integer (base 10), with the syntax of util_strtoi().
+ *
+ * @param str Start of the buffer. Must not be NULL.
+ * @param len Number of bytes that may be read.
+ * @param i Pointer to an int, set to the value read (clamped to [INT_MIN, INT_MAX]).
+ * Not modified if no integer was found. Must not be NULL.
+ * @param end If not NULL, set to the first byte after the integer, or to str if no integer was found.
+ * @return @ref E_SUCCESS, @ref E_INVALID_ARG if no integer was found,
+ * or @ref E_OUT_OF_RANGE if the value does not fit in an int.
+ */
+ErrStatus util_int_parse(const char *str, size_t len, void *i, const char **end);
+
+/**
+ * @brief Parses a double, with the syntax of util_strtod().
+ *
+ * @param str Start of the buffer. Must not be NULL.
+ * @param len Number of bytes that may be read.
+ * @param d Pointer to a double, set to the value read. Not modified if no value was found. Must not be NULL.
+ * @param end If not NULL, set to the first byte after the value, or to str if no value was found.
+ * @return The same codes as util_parseDouble().
+ */
+ErrStatus util_double_parse(const char *str, size_t len, void *d, const char **end);
+
+/**
+ * @brief Parses a string view: the whole buffer, without copying it.
+ *
+ * @param str Start of the buffer. Must not be NULL.
+ * @param len Number of bytes that may be read.
+ * @param sv Pointer to a @ref StringView, set to {str, len}. Must not be NULL.
+ * @param end If not NULL, set to str + len.
+ * @return @ref E_SUCCESS.
+ */
+ErrStatus util_stringView_parse(const char *str, size_t len, void *sv, const char **end);
+
 /* !SECTION */
 /* SECTION - Misc */
 
@@ -0,0 +1,419 @@
+/**
+ * @brief Fast, locale-independent conversion of numbers to text.
+ *
+ * @file format.c
+ */
+
+#include "format.h"
+
+#include "format_tables.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * @brief Number of explicit bits of the mantissa of a double.
+ */
+#define DOUBLE_MANTISSA_BITS 52
+
+/**
+ * @brief Number of bits of the exponent of a double.
+ */
+#define DOUBLE_EXPONENT_BITS 11
+
+/**
+ * @brief Exponent bias of a double.
+ */
+#define DOUBLE_BIAS 1023
+
+/**
+ * @brief Maximum number of significant digits written in fixed notation.
+ */
+#define DOUBLE_PRECISION 17
+
+/**
+ * @brief Every number in [0, 100) written with two digits, so that two digits are emitted
+ * per division instead of one.
+ */
+static const char DIGIT_PAIRS[200] = "00010203040506070809"
+									 "10111213141516171819"
+									 "20212223242526272829"
+									 "30313233343536373839"
+									 "40414243444546474849"
+									 "50515253545556575859"
+									 "60616263646566676869"
+									 "70717273747576777879"
+									 "80818283848586878889"
+									 "90919293949596979899";
+
+/* SECTION - Helpers */
+
+/**
+ * @brief Number of decimal digits of a value.
+ */
+static inline size_t count_digits(unsigned long value)
+{
+	size_t n = 1;
+
+	for (;;) {
+		if (value < 10) {
+			return n;
+		}
+		if (value < 100) {
+			return n + 1;
+		}
+		if (value < 1000) {
+			return n + 2;
+		}
+		if (value < 10000) {
+			return n + 3;
+		}
+
+		value /= 10000;
+		n += 4;
+	}
+}
+
+/**
+ * @brief Writes exactly len digits of value, filling the buffer from its end.
+ */
+static inline void write_digits(char *buf, size_t len, unsigned long value)
+{
+	char *p = buf + len;
+
+	while (value >= 100) {
+		p -= 2;
+		memcpy(p, &DIGIT_PAIRS[(value % 100) * 2], 2);
+		value /= 100;
+	}
+
+	if (value >= 10) {
+		memcpy(p - 2, &DIGIT_PAIRS[value * 2], 2);
+	} else {
+		p[-1] = (char) ('0' + value);
+	}
+}
+
+/* !SECTION */
+/* SECTION - Ryu helpers */
+
+/**
+ * @brief Computes ceil(log2(5^e)) for 0 < e <= 3528, and 1 for e = 0.
+ */
+static inline int32_t pow5_bits(int32_t e)
+{
+	return (int32_t) (((uint32_t) e * 1217359) >> 19) + 1;
+}
+
+/**
+ * @brief Computes floor(log10(2^e)) for 0 <= e <= 1650.
+ */
+static inline uint32_t log10_pow2(int32_t e)
+{
+	return ((uint32_t) e * 78913) >> 18;
+}
+
+/**
+ * @brief Computes floor(log10(5^e)) for 0 <= e <= 2620.
+ */
+static inline uint32_t log10_pow5(int32_t e)
+{
+	return ((uint32_t) e * 732923) >> 20;
+}
+
+/**
+ * @brief Returns the largest p such that 5^p divides value. value must not be 0.
+ */
+static inline uint32_t pow5_factor(uint64_t value)
+{
+	uint32_t count = 0;
+
+	while (value % 5 == 0) {
+		value /= 5;
+		count++;
+	}
+
+	return count;
+}
+
+static inline bool multiple_of_pow5(uint64_t value, uint32_t p)
+{
+	return pow5_factor(value) >= p;
+}
+
+static inline bool multiple_of_pow2(uint64_t value, uint32_t p)
+{
+	return (value & ((1ULL << p) - 1)) == 0;
+}
+
+/**
+ * @brief Unsigned 128-bit integer, as provided by GCC.
+ */
+__extension__ typedef unsigned __int128 uint128_t;
+
+/**
+ * @brief Computes (m * mul) >> j, where mul is a 128-bit table entry and 64 < j < 128.
+ */
+static inline uint64_t mul_shift(uint64_t m, const uint64_t *mul, int32_t j)
+{
+	const uint128_t b0 = (uint128_t) m * mul[0];
+	const uint128_t b2 = (uint128_t) m * mul[1];
+
+	return (uint64_t) (((b0 >> 64) + b2) >> (j - 64));
+}
+
+/**
+ * @brief Shortest decimal representation of a finite, positive double: value = mantissa * 10^exponent.
+ */
+typedef struct {
+	uint64_t mantissa;
+	int32_t exponent;
+} Decimal;
+
+/**
+ * @brief Core of the Ryu algorithm. Computes the shortest decimal in the rounding interval of a double.
+ *
+ * @param ieee_mantissa Explicit mantissa bits of the double.
+ * @param ieee_exponent Biased exponent bits of the double.
+ */
+static Decimal shortest_decimal(uint64_t ieee_mantissa, uint32_t ieee_exponent)
+{
+	int32_t e2;
+	uint64_t m2;
+
+	if (ieee_exponent == 0) {
+		e2 = 1 - DOUBLE_BIAS - DOUBLE_MANTISSA_BITS - 2;
+		m2 = ieee_mantissa;
+	} else {
+		e2 = (int32_t) ieee_exponent - DOUBLE_BIAS - DOUBLE_MANTISSA_BITS - 2;
+		m2 = (1ULL << DOUBLE_MANTISSA_BITS) | ieee_mantissa;
+	}
+
+	const bool accept_bounds = (m2 & 1) == 0; // Round to even: bounds are included if m2 is even
+
+	/* Step 2: Interval of valid decimal representations, scaled by 4 */
+	const uint64_t mv         = 4 * m2;
+	const uint32_t mm_shift   = ieee_mantissa != 0 || ieee_exponent <= 1;
+	uint64_t vr, vp, vm;
+	int32_t e10;
+	bool vm_trailing_zeros = false;
+	bool vr_trailing_zeros = false;
+
+	/* Step 3: Convert to a decimal power base */
+	if (e2 >= 0) {
+		const uint32_t q = log10_pow2(e2) - (e2 > 3);
+		const int32_t k  = DOUBLE_POW5_INV_BITCOUNT + pow5_bits((int32_t) q) - 1;
+		const int32_t i  = -e2 + (int32_t) q + k;
+
+		e10 = (int32_t) q;
+		vr  = mul_shift(4 * m2, DOUBLE_POW5_INV_SPLIT[q], i);
+		vp  = mul_shift(4 * m2 + 2, DOUBLE_POW5_INV_SPLIT[q], i);
+		vm  = mul_shift(4 * m2 - 1 - mm_shift, DOUBLE_POW5_INV_SPLIT[q], i);
+
+		if (q <= 21) {
+			/* Only one of mp, mv, and mm can be a multiple of 5, if any */
+			if (mv % 5 == 0) {
+				vr_trailing_zeros = multiple_of_pow5(mv, q);
+			} else if (accept_bounds) {
+				vm_trailing_zeros = multiple_of_pow5(mv - 1 - mm_shift, q);
+			} else {
+				vp -= multiple_of_pow5(mv + 2, q);
+			}
+		}
+	} else {
+		const uint32_t q = log10_pow5(-e2) - (-e2 > 1);
+		const int32_t i  = -e2 - (int32_t) q;
+		const int32_t k  = pow5_bits(i) - DOUBLE_POW5_BITCOUNT;
+		const int32_t j  = (int32_t) q - k;
+
+		e10 = (int32_t) q + e2;
+		vr  = mul_shift(4 * m2, DOUBLE_POW5_SPLIT[i], j);
+		vp  = mul_shift(4 * m2 + 2, DOUBLE_POW5_SPLIT[i], j);
+		vm  = mul_shift(4 * m2 - 1 - mm_shift, DOUBLE_POW5_SPLIT[i], j);
+
+		if (q <= 1) {
+			/* mv = 4 * m2 always has at least two trailing zero bits */
+			vr_trailing_zeros = true;
+			if (accept_bounds) {
+				vm_trailing_zeros = mm_shift == 1;
+			} else {
+				vp--;
+			}
+		} else if (q < 63) {
+			vr_trailing_zeros = multiple_of_pow2(mv, q);
+		}
+	}
+
+	/* Step 4: Find the shortest representation in the interval */
+	int32_t removed         = 0;
+	uint8_t last_removed    = 0;
+	uint64_t output;
+
+	if (vm_trailing_zeros || vr_trailing_zeros) {
+		/* General case, which happens rarely (~0.7%) */
+		while (vp / 10 > vm / 10) {
+			vm_trailing_zeros &= vm % 10 == 0;
+			vr_trailing_zeros &= last_removed == 0;
+			last_removed = (uint8_t) (vr % 10);
+			vr /= 10;
+			vp /= 10;
+			vm /= 10;
+			removed++;
+		}
+
+		if (vm_trailing_zeros) {
+			while (vm % 10 == 0) {
+				vr_trailing_zeros &= last_removed == 0;
+				last_removed = (uint8_t) (vr % 10);
+				vr /= 10;
+				vp /= 10;
+				vm /= 10;
+				removed++;
+			}
+		}
+
+		if (vr_trailing_zeros && last_removed == 5 && vr % 2 == 0) {
+			last_removed = 4; // Exactly halfway: round to even
+		}
+
+		output = vr + ((vr == vm && (!accept_bounds || !vm_trailing_zeros)) || last_removed >= 5);
+	} else {
+		/* Common case: digits can be removed without tracking trailing zeros */
+		bool round_up = false;
+
+		if (vp / 100 > vm / 100) {
+			round_up = vr % 100 >= 50;
+			vr /= 100;
+			vp /= 100;
+			vm /= 100;
+			removed += 2;
+		}
+
+		while (vp / 10 > vm / 10) {
+			round_up = vr % 10 >= 5;
+			vr /= 10;
+			vp /= 10;
+			vm /= 10;
+			removed++;
+		}
+
+		output = vr + (vr == vm || round_up);
+	}
+
+	return (Decimal) { .mantissa = output, .exponent = e10 + removed };
+}
+
+/* !SECTION */
+/* SECTION - Integers */
+
+size_t util_formatUnsignedLong(char *buf, unsigned long value)
+{
+	size_t len = count_digits(value);
+
+	write_digits(buf, len, value);
+	buf[len] = '\0';
+
+	return len;
+}
+
+size_t util_formatUnsigned(char *buf, unsigned value)
+{
+	return util_formatUnsignedLong(buf, value);
+}
+
+size_t util_formatLong(char *buf, long value)
+{
+	if (value < 0) {
+		*buf = '-';
+		/* Negating in the unsigned domain is well defined for LONG_MIN */
+		return 1 + util_formatUnsignedLong(buf + 1, 0UL - (unsigned long) value);
+	}
+
+	return util_formatUnsignedLong(buf, (unsigned long) value);
+}
+
+size_t util_formatInt(char *buf, int value)
+{
+	return util_formatLong(buf, value);
+}
+
+/* !SECTION */
+/* SECTION - Floating point */
+
+size_t util_formatDouble(char *buf, double value)
+{
+	uint64_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+
+	const bool sign             = bits >> (DOUBLE_MANTISSA_BITS + DOUBLE_EXPONENT_BITS);
+	const uint64_t ieee_mantissa = bits & ((1ULL << DOUBLE_MANTISSA_BITS) - 1);
+	const uint32_t ieee_exponent = (uint32_t) (bits >> DOUBLE_MANTISSA_BITS) & ((1U << DOUBLE_EXPONENT_BITS) - 1);
+	char *p                      = buf;
+
+	if (sign) {
+		*p++ = '-';
+	}
+
+	if (ieee_exponent == (1U << DOUBLE_EXPONENT_BITS) - 1) {
+		memcpy(p, ieee_mantissa ? "nan" : "inf", 4);
+		return (size_t) (p - buf) + 3;
+	}
+
+	if (ieee_exponent == 0 && ieee_mantissa == 0) {
+		memcpy(p, "0", 2);
+		return (size_t) (p - buf) + 1;
+	}
+
+	const Decimal dec = shortest_decimal(ieee_mantissa, ieee_exponent);
+	const size_t len  = count_digits(dec.mantissa);
+	const int32_t exp = dec.exponent + (int32_t) len - 1; // Exponent in scientific notation
+
+	if (exp < -4 || exp >= DOUBLE_PRECISION) {
+		/* Scientific notation: d[.ddd]e±XX */
+		write_digits(p + 1, len, dec.mantissa);
+		p[0] = p[1];
+		if (len > 1) {
+			p[1] = '.';
+			p += len + 1;
+		} else {
+			p++;
+		}
+
+		*p++ = 'e';
+		*p++ = exp < 0 ? '-' : '+';
+		uint32_t abs_exp = (uint32_t) (exp < 0 ? -exp : exp);
+		if (abs_exp >= 100) {
+			*p++ = (char) ('0' + abs_exp / 100);
+			abs_exp %= 100;
+		}
+		memcpy(p, &DIGIT_PAIRS[abs_exp * 2], 2);
+		p += 2;
+	} else if (exp < 0) {
+		/* Fixed notation, value in (0, 1): 0.000ddd */
+		const size_t zeros = (size_t) (-exp - 1);
+		memcpy(p, "0.0000", 2 + zeros);
+		p += 2 + zeros;
+		write_digits(p, len, dec.mantissa);
+		p += len;
+	} else if ((size_t) exp + 1 >= len) {
+		/* Fixed notation, integer value: ddd000 */
+		const size_t zeros = (size_t) exp + 1 - len;
+		write_digits(p, len, dec.mantissa);
+		memset(p + len, '0', zeros);
+		p += len + zeros;
+	} else {
+		/* Fixed notation, with fractional part: ddd.ddd */
+		const size_t int_len = (size_t) exp + 1;
+		write_digits(p + 1, len, dec.mantissa);
+		memmove(p, p + 1, int_len);
+		p[int_len] = '.';
+		p += len + 1;
+	}
+
+	*p = '\0';
+
+	return (size_t) (p - buf);
+}
+
+/* !SECTION */
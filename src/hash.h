@@ -0,0 +1,46 @@
+/**
+ * @brief Hash function for byte sequences shared by the string modules.
+ *
+ * @file hash.h
+ */
+
+#ifndef HASH_H
+#define HASH_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * @brief 64-bit hash of a sequence of bytes, mixing 8 bytes at a time.
+ *
+ * @details The final avalanche mixes all the input bits into both the high and the low bits
+ * of the result, so that any of them may be used to select buckets.
+ */
+static inline uint64_t hash_bytes(const char *str, size_t len)
+{
+	uint64_t h = 0x9E3779B97F4A7C15ULL ^ len;
+	size_t i   = 0;
+
+	for (; i + 8 <= len; i += 8) {
+		uint64_t w;
+		memcpy(&w, str + i, sizeof(w));
+		h = (h ^ w) * 0xFF51AFD7ED558CCDULL;
+		h ^= h >> 32;
+	}
+
+	if (i < len) {
+		uint64_t w = 0;
+		memcpy(&w, str + i, len - i);
+		h = (h ^ w) * 0xFF51AFD7ED558CCDULL;
+		h ^= h >> 32;
+	}
+
+	h ^= h >> 33;
+	h *= 0xC4CEB9FE1A85EC53ULL;
+	h ^= h >> 33;
+
+	return h;
+}
+
+#endif
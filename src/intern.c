@@ -0,0 +1,341 @@
+/**
+ * @brief String interning: one canonical copy per distinct string.
+ *
+ * @file intern.c
+ */
+
+#define _POSIX_C_SOURCE 200809L // NOLINT
+
+#include "intern.h"
+
+#include "dbg.h"
+#include "hash.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief Number of bits of the hash used to select a shard.
+ */
+#define SHARD_BITS 4
+
+/**
+ * @brief Number of independently locked shards of a pool.
+ */
+#define NUM_SHARDS (1 << SHARD_BITS)
+
+/**
+ * @brief Size of a cache line, to keep the locks of different shards apart.
+ */
+#define CACHE_LINE 64
+
+/**
+ * @brief Initial number of slots of the table of a shard. Must be a power of 2.
+ */
+#define INITIAL_SLOTS 64
+
+/**
+ * @brief Size of the blocks where interned strings are stored.
+ * Strings larger than a quarter of a block get their own block.
+ */
+#define BLOCK_SIZE (64 * 1024)
+
+/**
+ * @brief Slot of the hash table of a shard. The slot is empty if str is NULL.
+ */
+typedef struct {
+	uint64_t hash;
+	const char *str;
+	size_t len;
+} Entry;
+
+/**
+ * @brief Memory block where strings are stored, so that they never move.
+ */
+typedef struct Block {
+	struct Block *next;
+	size_t used;
+	size_t cap;
+	char data[];
+} Block;
+
+/**
+ * @brief Part of a pool with its own lock. Lookups of existing strings only take a read lock.
+ */
+typedef struct {
+	_Alignas(CACHE_LINE) pthread_rwlock_t lock;
+	Entry *entries; /**< Open addressing table with linear probing */
+	size_t slots;   /**< Number of slots of entries, a power of 2 */
+	size_t count;   /**< Number of strings */
+	Block *blocks;  /**< Storage of the strings, most recent block first */
+} Shard;
+
+struct InternPool {
+	Shard shards[NUM_SHARDS];
+};
+
+/**
+ * @brief Process-wide pool of util_string_intern(). NULL until it is created successfully.
+ */
+static InternPool *global_pool;
+
+/**
+ * @brief Serializes the creation of the global pool.
+ */
+static pthread_mutex_t global_pool_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/* SECTION - Helpers */
+
+/**
+ * @brief Finds the slot of a string in a shard: the slot holding it, or the empty slot where it would go.
+ */
+static Entry *find_slot(const Shard *shard, uint64_t hash, const char *str, size_t len)
+{
+	size_t mask = shard->slots - 1;
+
+	for (size_t i = hash & mask;; i = (i + 1) & mask) {
+		Entry *e = &shard->entries[i];
+
+		if (!e->str || (e->hash == hash && e->len == len && memcmp(e->str, str, len) == 0)) {
+			return e;
+		}
+	}
+}
+
+/**
+ * @brief Doubles the number of slots of a shard.
+ */
+static ErrStatus grow_table(Shard *shard)
+{
+	size_t slots     = shard->slots * 2;
+	Entry *entries   = calloc(slots, sizeof(Entry));
+	Entry *old       = shard->entries;
+	size_t old_slots = shard->slots;
+
+	check_mem(entries);
+
+	shard->entries = entries;
+	shard->slots   = slots;
+
+	for (size_t i = 0; i < old_slots; i++) {
+		if (old[i].str) {
+			*find_slot(shard, old[i].hash, old[i].str, old[i].len) = old[i];
+		}
+	}
+
+	free(old);
+	return E_SUCCESS;
+
+error:
+	return E_OUT_OF_MEMORY;
+}
+
+/**
+ * @brief Copies a string into the blocks of a shard, adding a null terminator.
+ */
+static const char *store_string(Shard *shard, const char *str, size_t len)
+{
+	Block *block = shard->blocks;
+
+	if (!block || block->cap - block->used < len + 1) {
+		size_t cap = len + 1 > BLOCK_SIZE / 4 ? len + 1 : BLOCK_SIZE;
+
+		block = malloc(sizeof(Block) + cap);
+		check_mem(block);
+
+		block->used = 0;
+		block->cap  = cap;
+
+		if (cap == BLOCK_SIZE || !shard->blocks) {
+			block->next   = shard->blocks;
+			shard->blocks = block;
+		} else {
+			/* Keep filling the current block: dedicated blocks are inserted behind it */
+			block->next         = shard->blocks->next;
+			shard->blocks->next = block;
+		}
+	}
+
+	char *copy = block->data + block->used;
+	if (len > 0) {
+		memcpy(copy, str, len);
+	}
+	copy[len] = '\0';
+	block->used += len + 1;
+
+	return copy;
+
+error:
+	return NULL;
+}
+
+/**
+ * @brief Returns the global pool, creating it if needed.
+ *
+ * @details The pool is published with release semantics once it is fully built. If it cannot be
+ * created, global_pool stays NULL and a later call tries again.
+ */
+static InternPool *get_global_pool(void)
+{
+	InternPool *pool = __atomic_load_n(&global_pool, __ATOMIC_ACQUIRE);
+
+	if (pool) {
+		return pool;
+	}
+
+	pthread_mutex_lock(&global_pool_lock);
+	pool = __atomic_load_n(&global_pool, __ATOMIC_ACQUIRE);
+	if (!pool) {
+		pool = util_internPool_create();
+		__atomic_store_n(&global_pool, pool, __ATOMIC_RELEASE);
+	}
+	pthread_mutex_unlock(&global_pool_lock);
+
+	return pool;
+}
+
+/* !SECTION */
+/* SECTION - Intern pools */
+
+InternPool *util_internPool_create(void)
+{
+	size_t initialized = 0;
+	InternPool *pool   = aligned_alloc(CACHE_LINE, sizeof(InternPool));
+	check_mem(pool);
+
+	memset(pool, 0, sizeof(*pool));
+
+	for (; initialized < NUM_SHARDS; initialized++) {
+		Shard *shard   = &pool->shards[initialized];
+		shard->entries = calloc(INITIAL_SLOTS, sizeof(Entry));
+		shard->slots   = INITIAL_SLOTS;
+		check_mem(shard->entries);
+
+		int error = pthread_rwlock_init(&shard->lock, NULL);
+		if (error) {
+			free(shard->entries);
+			errno = error;
+			goto error;
+		}
+	}
+
+	return pool;
+
+error:
+	for (size_t i = 0; pool && i < initialized; i++) {
+		pthread_rwlock_destroy(&pool->shards[i].lock);
+		free(pool->shards[i].entries);
+	}
+	free(pool);
+
+	return NULL;
+}
+
+void util_internPool_destroy(InternPool *pool)
+{
+	if (!pool) {
+		return;
+	}
+
+	for (size_t i = 0; i < NUM_SHARDS; i++) {
+		Shard *shard = &pool->shards[i];
+
+		for (Block *block = shard->blocks, *next; block; block = next) {
+			next = block->next;
+			free(block);
+		}
+
+		free(shard->entries);
+		pthread_rwlock_destroy(&shard->lock);
+	}
+
+	free(pool);
+}
+
+const char *util_internPool_internLen(InternPool *pool, const char *str, size_t len)
+{
+	claim(pool != NULL && (str != NULL || len == 0));
+
+	uint64_t hash      = hash_bytes(str, len);
+	Shard *shard       = &pool->shards[hash >> (64 - SHARD_BITS)];
+	const char *result = NULL;
+
+	/* Fast path: the string is already interned */
+	pthread_rwlock_rdlock(&shard->lock);
+	result = find_slot(shard, hash, str, len)->str;
+	pthread_rwlock_unlock(&shard->lock);
+
+	if (result) {
+		return result;
+	}
+
+	pthread_rwlock_wrlock(&shard->lock);
+
+	/* Another thread may have interned it in the meantime */
+	Entry *e = find_slot(shard, hash, str, len);
+	if (!e->str) {
+		if ((shard->count + 1) * 4 > shard->slots * 3) {
+			if (grow_table(shard) != E_SUCCESS) {
+				goto unlock;
+			}
+			e = find_slot(shard, hash, str, len);
+		}
+
+		const char *copy = store_string(shard, str, len);
+		if (!copy) {
+			goto unlock;
+		}
+
+		*e = (Entry) {.hash = hash, .str = copy, .len = len};
+		shard->count++;
+	}
+	result = e->str;
+
+unlock:
+	pthread_rwlock_unlock(&shard->lock);
+
+	return result;
+}
+
+const char *util_internPool_intern(InternPool *pool, const char *str)
+{
+	claim(str != NULL);
+
+	return util_internPool_internLen(pool, str, strlen(str));
+}
+
+size_t util_internPool_count(InternPool *pool)
+{
+	claim(pool != NULL);
+
+	size_t count = 0;
+
+	for (size_t i = 0; i < NUM_SHARDS; i++) {
+		pthread_rwlock_rdlock(&pool->shards[i].lock);
+		count += pool->shards[i].count;
+		pthread_rwlock_unlock(&pool->shards[i].lock);
+	}
+
+	return count;
+}
+
+/* !SECTION */
+/* SECTION - Global pool */
+
+void *util_string_intern(const char *str)
+{
+	claim(str != NULL);
+
+	InternPool *pool = get_global_pool();
+	if (!pool) {
+		errno = ENOMEM;
+		return NULL;
+	}
+
+	return (void *) util_internPool_intern(pool, str);
+}
+
+/* !SECTION */
@@ -0,0 +1,637 @@
+/**
+ * @brief Loading of elements from large text files through memory mappings.
+ *
+ * @file load.c
+ */
+
+#define _POSIX_C_SOURCE 200809L // NOLINT
+
+#include "load.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef __SSE2__
+	#include <emmintrin.h>
+#endif
+
+/**
+ * @brief Number of bytes classified at once by the tokenizer, one per bit of a uint64_t.
+ */
+#define BLOCK_SIZE 64
+
+/**
+ * @brief Maximum number of delimiters compared with SIMD instructions. Larger sets use a lookup table.
+ */
+#define MAX_SIMD_DELIMS 8
+
+/**
+ * @brief Minimum size of the chunks parsed by each thread of util_loadParallel().
+ */
+#define MIN_CHUNK_SIZE (256 * 1024)
+
+/**
+ * @brief Size of the stack buffer used to null-terminate tokens for util_elemFromString functions.
+ */
+#define TOKEN_BUFSIZE 256
+
+/**
+ * @brief Set of delimiter characters.
+ */
+typedef struct {
+	bool is_delim[256];           /**< Lookup table */
+	char chars[MAX_SIMD_DELIMS]; /**< Delimiters, if there are at most MAX_SIMD_DELIMS */
+	size_t count;                 /**< Number of delimiters */
+} Delims;
+
+/**
+ * @brief State of util_loadParsed().
+ */
+typedef struct {
+	const MappedFile *file;
+	util_parse parse;
+	void *elem;
+	util_elemConsumer consume;
+	void *ctx;
+	ParseStats *stats;
+	size_t count;
+	size_t errors;
+	size_t consumed;
+} ParsedLoader;
+
+/**
+ * @brief State of util_loadElems().
+ */
+typedef struct {
+	const MappedFile *file;
+	util_elemFromString fromString;
+	util_elemConsumer consume;
+	void *ctx;
+	ParseStats *stats;
+	size_t count;
+	size_t errors;
+	size_t consumed;
+	char *buf;
+	size_t cap;
+} ElemLoader;
+
+/**
+ * @brief Part of a file parsed by one thread of util_loadParallel().
+ */
+typedef struct {
+	const char *file_data; /**< Start of the file, for error offsets */
+	const char *begin;     /**< First byte of the chunk */
+	size_t len;            /**< Length of the chunk, which ends after a newline or at the end of the file */
+	const Delims *table;
+	util_parse parse;
+	size_t size;            /**< Size of an element */
+	char *elems;            /**< Slice of the result with room for every token of the chunk */
+	size_t count;           /**< Number of parsed elements */
+	size_t tokens;          /**< Number of tokens, including invalid ones */
+	size_t errors;          /**< Number of invalid tokens */
+	size_t *error_offsets;  /**< Offsets of the first invalid tokens */
+	size_t error_capacity;  /**< Capacity of error_offsets */
+	ErrStatus status;
+} Chunk;
+
+/* SECTION - Helpers */
+
+static void add_delim(Delims *table, char delim)
+{
+	if (table->is_delim[(unsigned char) delim]) {
+		return;
+	}
+
+	if (table->count < MAX_SIMD_DELIMS) {
+		table->chars[table->count] = delim;
+	}
+	table->count++;
+	table->is_delim[(unsigned char) delim] = true;
+}
+
+static void init_delims(Delims *table, const char *delims)
+{
+	memset(table->is_delim, 0, sizeof(table->is_delim));
+	table->count = 0;
+
+	for (const char *d = delims ? delims : UTIL_LOAD_DEF_DELIMS; *d; d++) {
+		add_delim(table, *d);
+	}
+}
+
+/**
+ * @brief Bitmask of the delimiters in a block of @ref BLOCK_SIZE bytes: bit i is set if block[i] is one.
+ */
+static inline uint64_t delim_mask(const Delims *table, const char *block)
+{
+	uint64_t mask = 0;
+
+#ifdef __SSE2__
+	if (table->count <= MAX_SIMD_DELIMS) {
+		for (int i = 0; i < BLOCK_SIZE / 16; i++) {
+			__m128i chunk = _mm_loadu_si128((const __m128i *) (block + 16 * i));
+			__m128i found = _mm_setzero_si128();
+
+			for (size_t j = 0; j < table->count; j++) {
+				found = _mm_or_si128(found, _mm_cmpeq_epi8(chunk, _mm_set1_epi8(table->chars[j])));
+			}
+			mask |= (uint64_t) (unsigned) _mm_movemask_epi8(found) << (16 * i);
+		}
+
+		return mask;
+	}
+#endif
+
+	for (int i = 0; i < BLOCK_SIZE; i++) {
+		mask |= (uint64_t) table->is_delim[(unsigned char) block[i]] << i;
+	}
+
+	return mask;
+}
+
+static void record_error(ParseStats *stats, size_t errors, size_t offset)
+{
+	if (stats && errors < stats->error_capacity) {
+		stats->error_offsets[errors] = offset;
+	}
+}
+
+static void fill_stats(ParseStats *stats, size_t count, size_t errors, size_t consumed)
+{
+	if (stats) {
+		stats->count    = count;
+		stats->errors   = errors;
+		stats->consumed = consumed;
+	}
+}
+
+static ErrStatus consume_parsed(const char *token, size_t len, void *ctx)
+{
+	ParsedLoader *loader = ctx;
+	const char *stop     = token;
+
+	loader->count++;
+	loader->consumed = (size_t) (token - loader->file->data) + len;
+	if (loader->parse(token, len, loader->elem, &stop) != E_SUCCESS || stop != token + len) {
+		record_error(loader->stats, loader->errors++, (size_t) (token - loader->file->data));
+		return E_SUCCESS;
+	}
+
+	return loader->consume(loader->elem, loader->ctx);
+}
+
+static ErrStatus consume_elem(const char *token, size_t len, void *ctx)
+{
+	ElemLoader *loader = ctx;
+
+	if (len >= loader->cap) {
+		size_t cap = loader->cap * 2 > len ? loader->cap * 2 : len + 1;
+		char *tmp  = malloc(cap);
+		check_mem(tmp);
+
+		if (loader->cap > TOKEN_BUFSIZE) {
+			free(loader->buf); // Not the initial stack buffer
+		}
+		loader->buf = tmp;
+		loader->cap = cap;
+	}
+
+	memcpy(loader->buf, token, len);
+	loader->buf[len] = '\0';
+
+	loader->count++;
+	loader->consumed = (size_t) (token - loader->file->data) + len;
+	void *elem = loader->fromString(loader->buf);
+	if (!elem) {
+		record_error(loader->stats, loader->errors++, (size_t) (token - loader->file->data));
+		return E_SUCCESS;
+	}
+
+	return loader->consume(elem, loader->ctx);
+
+error:
+	return E_OUT_OF_MEMORY;
+}
+
+/**
+ * @brief Splits len bytes starting at data into tokens.
+ */
+static ErrStatus tokenize(const char *data, size_t len, const Delims *table, util_tokenConsumer consume, void *ctx)
+{
+	const char *start   = NULL; // Start of the current token, if any
+	uint64_t prev_delim = 1;    // Whether the byte before the block is a delimiter
+	char tail[BLOCK_SIZE];
+
+	/* Token boundaries are found 64 bytes at a time from the bitmask of delimiters,
+	 * instead of testing every byte with a branch */
+	for (size_t base = 0; base < len; base += BLOCK_SIZE) {
+		const char *block = data + base;
+		size_t left       = len - base;
+		uint64_t delims_mask;
+
+		if (left >= BLOCK_SIZE) {
+			delims_mask = delim_mask(table, block);
+		} else {
+			/* Bytes past the end of the input are delimiters */
+			memset(tail, 0, sizeof(tail));
+			memcpy(tail, block, left);
+			delims_mask = delim_mask(table, tail) | (UINT64_MAX << left);
+		}
+
+		uint64_t after_delim = (delims_mask << 1) | prev_delim;
+		uint64_t starts      = ~delims_mask & after_delim;
+		uint64_t ends        = delims_mask & ~after_delim;
+		prev_delim           = delims_mask >> 63;
+
+		for (;;) {
+			if (!start) {
+				if (!starts) {
+					break;
+				}
+				start = block + __builtin_ctzll(starts);
+				starts &= starts - 1;
+			}
+
+			if (!ends) {
+				break;
+			}
+			const char *end = block + __builtin_ctzll(ends);
+			ends &= ends - 1;
+
+			ErrStatus status = consume(start, (size_t) (end - start), ctx);
+			if (status != E_SUCCESS) {
+				return status;
+			}
+			start = NULL;
+		}
+	}
+
+	if (start) {
+		return consume(start, (size_t) (data + len - start), ctx);
+	}
+
+	return E_SUCCESS;
+}
+
+static ErrStatus count_chunk_token(const char *token, size_t len, void *ctx)
+{
+	Chunk *chunk = ctx;
+
+	chunk->tokens++;
+	(void) token;
+	(void) len;
+
+	return E_SUCCESS;
+}
+
+static ErrStatus consume_chunk_token(const char *token, size_t len, void *ctx)
+{
+	Chunk *chunk     = ctx;
+	const char *stop = token;
+
+	/* count + errors is below the number of tokens counted beforehand, so elems has room */
+	if (chunk->parse(token, len, chunk->elems + chunk->count * chunk->size, &stop) == E_SUCCESS &&
+		stop == token + len) {
+		chunk->count++;
+	} else {
+		if (chunk->errors < chunk->error_capacity) {
+			chunk->error_offsets[chunk->errors] = (size_t) (token - chunk->file_data);
+		}
+		chunk->errors++;
+	}
+
+	return E_SUCCESS;
+}
+
+static void *count_chunk(void *arg)
+{
+	Chunk *chunk = arg;
+
+	chunk->status = tokenize(chunk->begin, chunk->len, chunk->table, count_chunk_token, chunk);
+
+	return NULL;
+}
+
+static void *parse_chunk(void *arg)
+{
+	Chunk *chunk = arg;
+
+	chunk->status = tokenize(chunk->begin, chunk->len, chunk->table, consume_chunk_token, chunk);
+
+	return NULL;
+}
+
+/**
+ * @brief Runs a function on every chunk, one thread per chunk.
+ *
+ * @details The first chunk is processed by the calling thread, as are chunks whose thread
+ * could not be created.
+ */
+static void run_chunks(Chunk *chunks, size_t num_chunks, void *(*fn)(void *), pthread_t *ids, bool *started)
+{
+	for (size_t i = 1; i < num_chunks; i++) {
+		started[i] = pthread_create(&ids[i], NULL, fn, &chunks[i]) == 0;
+	}
+	for (size_t i = 0; i < num_chunks; i++) {
+		if (!started[i]) {
+			fn(&chunks[i]);
+		}
+	}
+	for (size_t i = 1; i < num_chunks; i++) {
+		if (started[i]) {
+			pthread_join(ids[i], NULL);
+		}
+	}
+}
+
+/**
+ * @brief Splits a file into at most n chunks that end after a newline, or at the end of the file.
+ *
+ * @return Number of chunks, which is 0 for an empty file.
+ */
+static size_t split_chunks(const MappedFile *file, Chunk *chunks, size_t n)
+{
+	const char *lim   = file->data + file->len;
+	const char *begin = file->data;
+	size_t count      = 0;
+
+	for (size_t i = 1; i <= n && begin < lim; i++) {
+		const char *end = i == n ? lim : file->data + file->len / n * i;
+
+		if (end < begin) {
+			continue;
+		}
+		if (end < lim) {
+			const char *newline = memchr(end, '\n', (size_t) (lim - end));
+			end                 = newline ? newline + 1 : lim;
+		}
+
+		chunks[count].begin = begin;
+		chunks[count].len   = (size_t) (end - begin);
+		count++;
+		begin = end;
+	}
+
+	return count;
+}
+
+/* !SECTION */
+/* SECTION - Memory mappings */
+
+ErrStatus util_mappedFile_open(MappedFile *file, const char *path)
+{
+	claim(file != NULL && path != NULL);
+
+	ErrStatus status = E_INVALID_ARG;
+	void *data       = NULL;
+	struct stat st;
+
+	file->data = NULL;
+	file->len  = 0;
+
+	int fd = open(path, O_RDONLY);
+	check(fd >= 0, "Could not open %s", path);
+
+	bool mapped = fstat(fd, &st) == 0;
+	if (mapped && st.st_size > 0) {
+		data   = mmap(NULL, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		mapped = data != MAP_FAILED;
+	}
+
+	/* The mapping stays valid once the descriptor is closed */
+	int saved_errno = errno;
+	close(fd);
+	errno = saved_errno;
+
+	status = E_ERROR;
+	check(mapped, "Could not map %s", path);
+
+	if (data) {
+		/* Readahead more aggressively and drop pages behind the reading point sooner */
+		posix_madvise(data, (size_t) st.st_size, POSIX_MADV_SEQUENTIAL);
+
+		file->data = data;
+		file->len  = (size_t) st.st_size;
+	}
+
+	return E_SUCCESS;
+
+error:
+	return status;
+}
+
+void util_mappedFile_close(MappedFile *file)
+{
+	if (!file) {
+		return;
+	}
+
+	if (file->data) {
+		munmap((void *) file->data, file->len);
+	}
+
+	file->data = NULL;
+	file->len  = 0;
+}
+
+ErrStatus util_mappedFile_tokenize(const MappedFile *file, const char *delims, util_tokenConsumer consume, void *ctx)
+{
+	claim(file != NULL && consume != NULL);
+
+	Delims table;
+	init_delims(&table, delims);
+
+	return tokenize(file->data, file->len, &table, consume, ctx);
+}
+
+/* !SECTION */
+/* SECTION - Loading functions */
+
+ErrStatus util_loadParsed(const char *path, const char *delims, util_parse parse, void *elem,
+						  util_elemConsumer consume, void *ctx, ParseStats *stats)
+{
+	claim(path != NULL && parse != NULL && elem != NULL && consume != NULL);
+
+	MappedFile file;
+	ErrStatus status = util_mappedFile_open(&file, path);
+	if (status != E_SUCCESS) {
+		return status;
+	}
+
+	ParsedLoader loader = {
+		.file    = &file,
+		.parse   = parse,
+		.elem    = elem,
+		.consume = consume,
+		.ctx     = ctx,
+		.stats   = stats,
+	};
+
+	status = util_mappedFile_tokenize(&file, delims, consume_parsed, &loader);
+	fill_stats(stats, loader.count, loader.errors, status == E_SUCCESS ? file.len : loader.consumed);
+	util_mappedFile_close(&file);
+
+	return status;
+}
+
+ErrStatus util_loadElems(const char *path, const char *delims, util_elemFromString fromString,
+						 util_elemConsumer consume, void *ctx, ParseStats *stats)
+{
+	claim(path != NULL && fromString != NULL && consume != NULL);
+
+	MappedFile file;
+	ErrStatus status = util_mappedFile_open(&file, path);
+	if (status != E_SUCCESS) {
+		return status;
+	}
+
+	char local[TOKEN_BUFSIZE];
+	ElemLoader loader = {
+		.file       = &file,
+		.fromString = fromString,
+		.consume    = consume,
+		.ctx        = ctx,
+		.stats      = stats,
+		.buf        = local,
+		.cap        = sizeof(local),
+	};
+
+	status = util_mappedFile_tokenize(&file, delims, consume_elem, &loader);
+	fill_stats(stats, loader.count, loader.errors, status == E_SUCCESS ? file.len : loader.consumed);
+	util_mappedFile_close(&file);
+
+	if (loader.buf != local) {
+		free(loader.buf);
+	}
+
+	return status;
+}
+
+ErrStatus util_loadParallel(const char *path, const char *delims, util_parse parse, size_t size, size_t threads,
+							void **elems, size_t *n, ParseStats *stats)
+{
+	claim(path != NULL && parse != NULL && size > 0 && elems != NULL && n != NULL);
+
+	Chunk *chunks     = NULL;
+	pthread_t *ids    = NULL;
+	bool *started     = NULL;
+	char *result      = NULL;
+	size_t num_chunks = 0;
+	size_t error_cap  = stats ? stats->error_capacity : 0;
+	Delims table;
+	MappedFile file;
+
+	*elems = NULL;
+	*n     = 0;
+
+	ErrStatus status = util_mappedFile_open(&file, path);
+	if (status != E_SUCCESS) {
+		return status;
+	}
+
+	if (threads == 0) {
+		long online = sysconf(_SC_NPROCESSORS_ONLN);
+		threads     = online > 0 ? (size_t) online : 1;
+	}
+	if (threads > file.len / MIN_CHUNK_SIZE) {
+		threads = file.len / MIN_CHUNK_SIZE > 0 ? file.len / MIN_CHUNK_SIZE : 1;
+	}
+
+	/* Records never span chunks, since chunks end at newlines */
+	init_delims(&table, delims);
+	add_delim(&table, '\n');
+
+	status  = E_OUT_OF_MEMORY;
+	chunks  = calloc(threads, sizeof(*chunks));
+	ids     = malloc(threads * sizeof(*ids));
+	started = calloc(threads, sizeof(*started));
+	check_mem(chunks && ids && started);
+
+	num_chunks = split_chunks(&file, chunks, threads);
+	for (size_t i = 0; i < num_chunks; i++) {
+		chunks[i].file_data      = file.data;
+		chunks[i].table          = &table;
+		chunks[i].parse          = parse;
+		chunks[i].size           = size;
+		chunks[i].error_capacity = error_cap;
+		if (error_cap > 0) {
+			chunks[i].error_offsets = malloc(error_cap * sizeof(size_t));
+			check_mem(chunks[i].error_offsets);
+		}
+	}
+
+	/* Tokens are counted first, so that each chunk parses its elements directly into its own
+	 * slice of a single array, instead of growing a buffer that must then be copied */
+	run_chunks(chunks, num_chunks, count_chunk, ids, started);
+
+	size_t tokens = 0;
+	for (size_t i = 0; i < num_chunks; i++) {
+		tokens += chunks[i].tokens;
+	}
+
+	status = E_OUT_OF_MEMORY;
+	if (tokens > 0) {
+		result = malloc(tokens * size);
+		check_mem(result);
+
+		for (size_t i = 0, offset = 0; i < num_chunks; i++) {
+			chunks[i].elems = result + offset * size;
+			offset += chunks[i].tokens;
+		}
+	}
+
+	run_chunks(chunks, num_chunks, parse_chunk, ids, started);
+
+	/* Close the gaps left by invalid tokens at the end of the slices, in order */
+	size_t total = 0, errors = 0;
+	for (size_t i = 0; i < num_chunks; i++) {
+		status = chunks[i].status;
+		check(status == E_SUCCESS, "Could not parse chunk %zu of %s", i, path);
+
+		if (chunks[i].count > 0 && chunks[i].elems != result + total * size) {
+			memmove(result + total * size, chunks[i].elems, chunks[i].count * size);
+		}
+		total += chunks[i].count;
+
+		for (size_t j = 0; j < chunks[i].errors && errors + j < error_cap; j++) {
+			stats->error_offsets[errors + j] = chunks[i].error_offsets[j];
+		}
+		errors += chunks[i].errors;
+	}
+
+	if (total == 0) {
+		free(result);
+		result = NULL;
+	} else if (total < tokens) {
+		char *shrunk = realloc(result, total * size);
+		result       = shrunk ? shrunk : result;
+	}
+
+	fill_stats(stats, tokens, errors, file.len);
+	*elems = result;
+	*n     = total;
+	status = E_SUCCESS;
+	result = NULL;
+
+error:
+	for (size_t i = 0; chunks && i < num_chunks; i++) {
+		free(chunks[i].error_offsets);
+	}
+	free(result);
+	free(chunks);
+	free(ids);
+	free(started);
+	util_mappedFile_close(&file);
+
+	return status;
+}
+
+/* !SECTION */
@@ -0,0 +1,281 @@
+/**
+ * @brief Length-prefixed strings with small-string optimization and a cached hash.
+ *
+ * @file lstring.c
+ */
+
+#include "lstring.h"
+
+#include "dbg.h"
+#include "hash.h"
+#include "macros.h"
+
+#include <errno.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* SECTION - Initialization */
+
+ErrStatus util_lString_init(LString *s, const char *str, size_t len)
+{
+	claim(s != NULL && (str != NULL || len == 0));
+
+	char *dst = s->data.sso;
+
+	s->len  = 0;
+	s->hash = 0;
+
+	if (len > UTIL_LSTRING_SSO_CAP) {
+		dst = malloc(len + 1);
+		check_mem(dst);
+		s->data.heap = dst;
+	}
+
+	if (len > 0) {
+		memcpy(dst, str, len);
+	}
+	dst[len] = '\0';
+	s->len   = len;
+
+	return E_SUCCESS;
+
+error:
+	s->data.sso[0] = '\0';
+	return E_OUT_OF_MEMORY;
+}
+
+void util_lString_destroy(LString *s)
+{
+	if (!s) {
+		return;
+	}
+
+	if (s->len > UTIL_LSTRING_SSO_CAP) {
+		free(s->data.heap);
+	}
+
+	s->len         = 0;
+	s->hash        = 0;
+	s->data.sso[0] = '\0';
+}
+
+const char *util_lString_str(const LString *s)
+{
+	claim(s != NULL);
+
+	return s->len > UTIL_LSTRING_SSO_CAP ? s->data.heap : s->data.sso;
+}
+
+/* !SECTION */
+/* SECTION - Element functions */
+
+int util_lString_print(FILE *file, const void *s)
+{
+	claim(file != NULL);
+
+	if (!s) {
+		return fprintf(file, "%s ", DEF_NULL);
+	}
+
+	const LString *ls = s;
+
+	if (ls->len >= INT_MAX || fwrite(util_lString_str(ls), sizeof(char), ls->len, file) != ls->len ||
+		fputc(' ', file) == EOF) {
+		return -1;
+	}
+
+	return (int) ls->len + 1;
+}
+
+int util_lString_cmp(const void *s1, const void *s2)
+{
+	if (!s1 || !s2) {
+		return (!s1 < !s2) - (!s1 > !s2);
+	}
+
+	const LString *ls1 = s1;
+	const LString *ls2 = s2;
+	size_t len         = ls1->len < ls2->len ? ls1->len : ls2->len;
+	int cmp            = memcmp(util_lString_str(ls1), util_lString_str(ls2), len);
+
+	if (cmp != 0) {
+		return cmp;
+	}
+
+	return (ls1->len > ls2->len) - (ls1->len < ls2->len);
+}
+
+bool util_lString_equal(const void *s1, const void *s2)
+{
+	if (!s1 || !s2) {
+		return s1 == s2;
+	}
+
+	const LString *ls1 = s1;
+	const LString *ls2 = s2;
+
+	if (ls1->len != ls2->len) {
+		return false;
+	}
+
+	/* Only compare the hashes if both are already known: computing them costs more than memcmp */
+	uint64_t h1 = __atomic_load_n(&ls1->hash, __ATOMIC_RELAXED);
+	uint64_t h2 = __atomic_load_n(&ls2->hash, __ATOMIC_RELAXED);
+	if (h1 && h2 && h1 != h2) {
+		return false;
+	}
+
+	return memcmp(util_lString_str(ls1), util_lString_str(ls2), ls1->len) == 0;
+}
+
+uint64_t util_lString_hash(const void *s)
+{
+	if (!s) {
+		return 0;
+	}
+
+	/* The cache is written with relaxed atomics: threads that race to fill it store the same value */
+	LString *ls   = (LString *) s;
+	uint64_t hash = __atomic_load_n(&ls->hash, __ATOMIC_RELAXED);
+
+	if (!hash) {
+		hash = hash_bytes(util_lString_str(ls), ls->len);
+		hash = hash ? hash : 1;
+		__atomic_store_n(&ls->hash, hash, __ATOMIC_RELAXED);
+	}
+
+	return hash;
+}
+
+size_t util_lString_sortKey(unsigned char *buf, size_t size, const void *s)
+{
+	if (size > 0) {
+		buf[0] = s ? UTIL_KEY_PRESENT : UTIL_KEY_NULL;
+	}
+
+	if (!s) {
+		return 1;
+	}
+
+	const LString *ls = s;
+	const char *str   = util_lString_str(ls);
+	size_t len        = 1;
+
+	for (size_t i = 0; i <= ls->len; i++) {
+		/* The terminator is written as an escaped null byte followed by 0x00 instead of 0xFF */
+		unsigned char c = i < ls->len ? (unsigned char) str[i] : 0;
+
+		if (len < size) {
+			buf[len] = c;
+		}
+		len++;
+
+		if (c == 0) {
+			if (len < size) {
+				buf[len] = i < ls->len ? 0xFF : 0x00;
+			}
+			len++;
+		}
+	}
+
+	return len;
+}
+
+char *util_lString_toString(const void *s)
+{
+	char *str;
+
+	if (!s) {
+		return NULL;
+	}
+
+	const LString *ls = s;
+
+	str = malloc(ls->len + 1);
+	check_mem(str);
+
+	memcpy(str, util_lString_str(ls), ls->len + 1);
+
+error:
+	return str;
+}
+
+int util_lString_toBuffer(char *buf, size_t size, const void *s)
+{
+	if (!s) {
+		return -1;
+	}
+
+	const LString *ls = s;
+
+	if (ls->len > INT_MAX) {
+		errno = EOVERFLOW;
+		return -1;
+	}
+
+	if (size > 0) {
+		size_t n = ls->len < size ? ls->len : size - 1;
+		memcpy(buf, util_lString_str(ls), n);
+		buf[n] = '\0';
+	}
+
+	return (int) ls->len;
+}
+
+void *util_lString_fromString(const char *str)
+{
+	claim(str != NULL);
+
+	LString *s = malloc(sizeof(LString));
+	check_mem(s);
+
+	if (util_lString_init(s, str, strlen(str)) != E_SUCCESS) {
+		free(s);
+		return NULL;
+	}
+
+error:
+	return s;
+}
+
+ErrStatus util_lString_parse(const char *str, size_t len, void *s, const char **end)
+{
+	claim(str != NULL && s != NULL);
+
+	ErrStatus status = util_lString_init(s, str, len);
+
+	if (end) {
+		*end = status == E_SUCCESS ? str + len : str;
+	}
+
+	return status;
+}
+
+void util_lString_free(void *s)
+{
+	util_lString_destroy(s);
+	free(s);
+}
+
+/* !SECTION */
+/* SECTION - Type descriptor */
+
+const UtilType UTIL_TYPE_LSTRING = {
+	.name       = "lstring",
+	.kind       = UTIL_KIND_CUSTOM,
+	.size       = sizeof(LString),
+	.align      = _Alignof(LString),
+	.print      = util_lString_print,
+	.cmp        = util_lString_cmp,
+	.equal      = util_lString_equal,
+	.hash       = util_lString_hash,
+	.sortKey    = util_lString_sortKey,
+	.toString   = util_lString_toString,
+	.toBuffer   = util_lString_toBuffer,
+	.fromString = util_lString_fromString,
+	.parse      = util_lString_parse,
+	.free       = util_lString_free,
+};
+
+/* !SECTION */
@@ -0,0 +1,876 @@
+/**
+ * @brief Fast, locale-independent conversion of text to numbers.
+ *
+ * @file parse.c
+ */
+
+#define _POSIX_C_SOURCE 200809L // NOLINT
+
+#include "parse.h"
+
+#include "dbg.h"
+#include "parse_tables.h"
+
+#include <errno.h>
+#include <limits.h>
+#include <locale.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __SSE2__
+	#include <emmintrin.h>
+#endif
+
+_Static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "SWAR parsing assumes a little-endian target");
+
+/**
+ * @brief Smallest page size of the supported targets. Reads that do not cross a page boundary
+ * cannot fault, even if they go past the end of a null-terminated string.
+ */
+#define PAGE_SIZE 4096
+
+/**
+ * @brief Maximum number of significant digits that can be accumulated in a uint64_t without overflowing.
+ */
+#define MAX_U64_DIGITS 19
+
+/**
+ * @brief Disables AddressSanitizer in functions that intentionally read past the end of a string.
+ */
+#define NO_SANITIZE_ADDRESS __attribute__((no_sanitize_address))
+
+/**
+ * @brief Outcome of the internal parsing functions.
+ */
+typedef enum {
+	PARSE_OK,    /**< A number was parsed */
+	PARSE_EMPTY, /**< No number could be parsed */
+	PARSE_RANGE, /**< The number does not fit in the requested range */
+	PARSE_SLOW,  /**< The input must be parsed by the C library */
+} ParseResult;
+
+/**
+ * @brief Number of explicit bits of the mantissa of a double.
+ */
+#define DOUBLE_MANTISSA_BITS 52
+
+/**
+ * @brief Biased exponent of infinities and NaNs.
+ */
+#define DOUBLE_INFINITE_POWER 0x7FF
+
+/**
+ * @brief Exponents beyond this value are clamped while parsing, since they always overflow or underflow.
+ */
+#define MAX_PARSED_EXPONENT 100000
+
+/**
+ * @brief Size of the stack buffer used to null-terminate length-delimited inputs for strtod().
+ */
+#define STRTOD_BUFSIZE 128
+
+/**
+ * @brief Unsigned 128-bit integer, as provided by GCC.
+ */
+__extension__ typedef unsigned __int128 uint128_t;
+
+/**
+ * @brief Powers of 10 that fit in a uint64_t.
+ */
+static const uint64_t POW10[] = {
+	1ULL,
+	10ULL,
+	100ULL,
+	1000ULL,
+	10000ULL,
+	100000ULL,
+	1000000ULL,
+	10000000ULL,
+	100000000ULL,
+	1000000000ULL,
+	10000000000ULL,
+	100000000000ULL,
+	1000000000000ULL,
+	10000000000000ULL,
+	100000000000000ULL,
+	1000000000000000ULL,
+	10000000000000000ULL,
+	100000000000000000ULL,
+	1000000000000000000ULL,
+	10000000000000000000ULL,
+};
+
+/**
+ * @brief Powers of 10 that are exactly representable as doubles.
+ */
+static const double EXACT_POW10[] = {
+	1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+/* SECTION - SWAR helpers */
+
+static inline bool is_digit(char c)
+{
+	return (unsigned char) (c - '0') < 10;
+}
+
+static inline bool is_space(char c)
+{
+	return c == ' ' || (unsigned char) (c - '\t') < 5; // \t \n \v \f \r
+}
+
+/**
+ * @brief Tests whether 8 bytes can be read from p without going past lim,
+ * or without crossing a page boundary if lim is NULL (null-terminated input).
+ */
+static inline bool can_load8(const char *p, const char *lim)
+{
+	if (lim) {
+		return lim - p >= 8;
+	}
+
+	return ((uintptr_t) p & (PAGE_SIZE - 1)) <= PAGE_SIZE - 8;
+}
+
+/**
+ * @brief Reads 8 bytes in native (little-endian) order. Bytes past the null terminator may be read,
+ * see can_load8().
+ */
+NO_SANITIZE_ADDRESS static inline uint64_t load8(const char *p)
+{
+	uint64_t v;
+	__builtin_memcpy(&v, p, sizeof(v));
+
+	return v;
+}
+
+/**
+ * @brief Number of consecutive decimal digits at the start of an 8-byte chunk.
+ */
+static inline unsigned count_digits8(uint64_t chunk)
+{
+	/* Bytes become c - '0', which is in [0, 9] only for digits. Borrows and carries only
+	 * propagate towards later characters, so they cannot affect the first non-digit. */
+	uint64_t x    = chunk - 0x3030303030303030ULL;
+	uint64_t mask = ((x + 0x7676767676767676ULL) | x) & 0x8080808080808080ULL;
+
+	return mask ? (unsigned) __builtin_ctzll(mask) / 8 : 8;
+}
+
+/**
+ * @brief Converts the first n (1 <= n <= 8) digits of an 8-byte chunk to their value.
+ */
+static inline uint32_t parse_digits8(uint64_t chunk, unsigned n)
+{
+	if (n < 8) {
+		/* Shift the digits to the end and pad the start with '0' */
+		unsigned shift = (8 - n) * 8;
+		chunk          = (chunk << shift) | (0x3030303030303030ULL >> (64 - shift));
+	}
+
+	chunk -= 0x3030303030303030ULL;
+	chunk = (chunk * 10) + (chunk >> 8); // Pairs of digits
+	chunk = (((chunk & 0x000000FF000000FFULL) * 0x000F424000000064ULL) +
+			 (((chunk >> 16) & 0x000000FF000000FFULL) * 0x0000271000000001ULL)) >>
+			32;
+
+	return (uint32_t) chunk;
+}
+
+/* !SECTION */
+/* SECTION - Integers */
+
+/**
+ * @brief Parses a base 10 integer, with optional leading whitespace and sign.
+ *
+ * @param str Start of the input.
+ * @param lim End of the input, or NULL if the input is null-terminated.
+ * @param min Minimum value accepted.
+ * @param max Maximum value accepted.
+ * @param out Set to the value read, clamped to [min, max]. Not modified if no number was found.
+ * @param end Set to the first character after the number, or to str if no number was found.
+ */
+static ParseResult parse_integer(const char *str, const char *lim, long min, long max, long *out, const char **end)
+{
+	const char *p = str;
+
+	while ((!lim || p < lim) && is_space(*p)) {
+		p++;
+	}
+
+	bool negative = false;
+	if ((!lim || p < lim) && (*p == '-' || *p == '+')) {
+		negative = *p == '-';
+		p++;
+	}
+
+	const char *digits = p;
+	while ((!lim || p < lim) && *p == '0') {
+		p++;
+	}
+
+	uint64_t acc       = 0;
+	size_t significant = 0;
+
+	for (;;) {
+		if (can_load8(p, lim)) {
+			uint64_t chunk = load8(p);
+			unsigned n     = count_digits8(chunk);
+
+			if (n > 0 && significant + n <= MAX_U64_DIGITS) {
+				acc = acc * POW10[n] + parse_digits8(chunk, n);
+			}
+
+			significant += n;
+			p += n;
+			if (n < 8) {
+				break;
+			}
+		} else {
+			if ((lim && p >= lim) || !is_digit(*p)) {
+				break;
+			}
+
+			if (significant < MAX_U64_DIGITS) {
+				acc = acc * 10 + (uint64_t) (*p - '0');
+			}
+
+			significant++;
+			p++;
+		}
+	}
+
+	if (p == digits) {
+		*end = str;
+		return PARSE_EMPTY;
+	}
+
+	*end = p;
+
+	/* Magnitudes are compared in the unsigned domain, where -LONG_MIN is representable */
+	uint64_t limit = negative ? 0ULL - (uint64_t) min : (uint64_t) max;
+	if (significant > MAX_U64_DIGITS || acc > limit) {
+		*out = negative ? min : max;
+		return PARSE_RANGE;
+	}
+
+	*out = negative ? (long) (0ULL - acc) : (long) acc;
+	return PARSE_OK;
+}
+
+long util_strtol(const char *str, char **end)
+{
+	claim(str != NULL);
+
+	long value       = 0;
+	const char *stop = str;
+
+	if (parse_integer(str, NULL, LONG_MIN, LONG_MAX, &value, &stop) == PARSE_RANGE) {
+		errno = ERANGE;
+	}
+
+	if (end) {
+		*end = (char *) stop;
+	}
+
+	return value;
+}
+
+int util_strtoi(const char *str, char **end)
+{
+	claim(str != NULL);
+
+	long value       = 0;
+	const char *stop = str;
+
+	if (parse_integer(str, NULL, INT_MIN, INT_MAX, &value, &stop) == PARSE_RANGE) {
+		errno = ERANGE;
+	}
+
+	if (end) {
+		*end = (char *) stop;
+	}
+
+	return (int) value;
+}
+
+/* !SECTION */
+/* SECTION - Floating point */
+
+/**
+ * @brief C locale, used when doubles must be parsed by strtod().
+ */
+static locale_t c_locale;
+
+static pthread_once_t c_locale_once = PTHREAD_ONCE_INIT;
+
+static void init_c_locale(void)
+{
+	c_locale = newlocale(LC_ALL_MASK, "C", (locale_t) 0);
+}
+
+/**
+ * @brief strtod() in the C locale, regardless of the locale of the process.
+ */
+static double strtod_c(const char *str, char **end)
+{
+	pthread_once(&c_locale_once, init_c_locale);
+
+	if (!c_locale) {
+		return strtod(str, end);
+	}
+
+	locale_t old = uselocale(c_locale);
+	double d     = strtod(str, end);
+	uselocale(old);
+
+	return d;
+}
+
+/**
+ * @brief Reads a run of decimal digits, accumulating up to @ref MAX_U64_DIGITS significant digits.
+ *
+ * @param p Start of the digits.
+ * @param lim End of the input, or NULL if the input is null-terminated.
+ * @param w Accumulated significant digits.
+ * @param sig Number of digits accumulated in w.
+ * @param truncated Set to true if a non-zero digit had to be dropped.
+ * @param taken Set to the number of digits of the run that were accumulated in w.
+ * @return Pointer to the first character after the run.
+ */
+static const char *accumulate_digits(const char *p, const char *lim, uint64_t *w, size_t *sig, bool *truncated,
+									 size_t *taken)
+{
+	*taken = 0;
+
+	for (;;) {
+		if (*sig + 8 <= MAX_U64_DIGITS && can_load8(p, lim)) {
+			uint64_t chunk = load8(p);
+			unsigned n     = count_digits8(chunk);
+
+			if (n > 0) {
+				*w = *w * POW10[n] + parse_digits8(chunk, n);
+				*sig += n;
+				*taken += n;
+				p += n;
+			}
+
+			if (n < 8) {
+				return p;
+			}
+			continue;
+		}
+
+		if ((lim && p >= lim) || !is_digit(*p)) {
+			return p;
+		}
+
+		if (*sig < MAX_U64_DIGITS) {
+			*w = *w * 10 + (uint64_t) (*p - '0');
+			(*sig)++;
+			(*taken)++;
+		} else if (*p != '0') {
+			*truncated = true;
+		}
+		p++;
+	}
+}
+
+/**
+ * @brief Eisel-Lemire algorithm: computes the double nearest to w * 10^q, for w != 0.
+ *
+ * @param bits Set to the bits of the double, without sign.
+ * @return false if the result is zero, subnormal or infinite, which must be handled by strtod()
+ * to get the same errno.
+ */
+static bool eisel_lemire(uint64_t w, int64_t q, uint64_t *bits)
+{
+	if (q < SMALLEST_POWER_OF_FIVE || q > LARGEST_POWER_OF_FIVE) {
+		return false;
+	}
+
+	/* Normalize w so that its most significant bit is set */
+	int lz = __builtin_clzll(w);
+	w <<= lz;
+
+	/* 128-bit approximation of w * 5^q. The second multiplication is only needed if the
+	 * bits below the required precision (mantissa, implicit bit, rounding bit and one more bit
+	 * lost to normalization) are all ones, since a carry could still change them. */
+	const uint64_t *pow5      = POWERS_OF_FIVE[q - SMALLEST_POWER_OF_FIVE];
+	uint128_t first           = (uint128_t) w * pow5[0];
+	uint64_t high             = (uint64_t) (first >> 64);
+	uint64_t low              = (uint64_t) first;
+	const uint64_t prec_mask  = UINT64_MAX >> (DOUBLE_MANTISSA_BITS + 3);
+
+	if ((high & prec_mask) == prec_mask) {
+		uint64_t second_high = (uint64_t) (((uint128_t) w * pow5[1]) >> 64);
+		low += second_high;
+		if (second_high > low) {
+			high++;
+		}
+	}
+
+	int upperbit      = (int) (high >> 63);
+	int shift         = upperbit + 64 - DOUBLE_MANTISSA_BITS - 3;
+	uint64_t mantissa = high >> shift;
+	/* ((152170 + 65536) * q) >> 16 is floor(log2(10^q)) */
+	int32_t power2 = (int32_t) ((((152170 + 65536) * q) >> 16) + 63) + upperbit - lz + 1023;
+
+	if (power2 <= 0) {
+		return false; // Subnormal or zero
+	}
+
+	/* Exactly halfway between two doubles: round to even instead of up.
+	 * This can only happen when 5^q fits in 64 bits. */
+	if (low <= 1 && q >= -4 && q <= 23 && (mantissa & 3) == 1 && (mantissa << shift) == high) {
+		mantissa &= ~1ULL;
+	}
+
+	mantissa += mantissa & 1;
+	mantissa >>= 1;
+	if (mantissa >= (2ULL << DOUBLE_MANTISSA_BITS)) {
+		mantissa = 1ULL << DOUBLE_MANTISSA_BITS;
+		power2++;
+	}
+
+	if (power2 >= DOUBLE_INFINITE_POWER) {
+		return false;
+	}
+
+	mantissa &= ~(1ULL << DOUBLE_MANTISSA_BITS);
+	*bits = mantissa | ((uint64_t) power2 << DOUBLE_MANTISSA_BITS);
+
+	return true;
+}
+
+/**
+ * @brief Parses a decimal floating point number, with optional leading whitespace and sign.
+ *
+ * @param str Start of the input.
+ * @param lim End of the input, or NULL if the input is null-terminated.
+ * @param out Set to the value read. Not modified if no number was found, or if the result is
+ * @ref PARSE_SLOW.
+ * @param end Set to the first character after the number, or to str if no number was found.
+ * @return @ref PARSE_SLOW if the number must be parsed by strtod() instead: hexadecimal numbers,
+ * infinities, NaNs, results that underflow or overflow, and some numbers with more than
+ * @ref MAX_U64_DIGITS significant digits.
+ */
+static ParseResult parse_double(const char *str, const char *lim, double *out, const char **end)
+{
+	const char *p = str;
+
+	while ((!lim || p < lim) && is_space(*p)) {
+		p++;
+	}
+
+	bool negative = false;
+	if ((!lim || p < lim) && (*p == '-' || *p == '+')) {
+		negative = *p == '-';
+		p++;
+	}
+
+	if (!lim || p < lim) {
+		char c = *p | 0x20; // Lowercase
+		if (c == 'i' || c == 'n' || (*p == '0' && (!lim || p + 1 < lim) && (p[1] | 0x20) == 'x')) {
+			return PARSE_SLOW;
+		}
+	}
+
+	uint64_t w      = 0;
+	size_t sig      = 0;
+	size_t taken    = 0;
+	bool truncated  = false;
+	int64_t exp10   = 0;
+	size_t ndigits  = 0;
+	const char *run = p;
+
+	/* Integer part: leading zeros are not significant, dropped digits scale the value */
+	while ((!lim || p < lim) && *p == '0') {
+		p++;
+	}
+	ndigits += (size_t) (p - run);
+	run = p;
+	p   = accumulate_digits(p, lim, &w, &sig, &truncated, &taken);
+	exp10 += (int64_t) ((size_t) (p - run) - taken);
+	ndigits += (size_t) (p - run);
+
+	/* Fractional part */
+	if ((!lim || p < lim) && *p == '.') {
+		p++;
+		run = p;
+
+		if (w == 0) {
+			while ((!lim || p < lim) && *p == '0') {
+				p++;
+			}
+			exp10 -= p - run;
+		}
+
+		p = accumulate_digits(p, lim, &w, &sig, &truncated, &taken);
+		exp10 -= (int64_t) taken;
+		ndigits += (size_t) (p - run);
+	}
+
+	if (ndigits == 0) {
+		*end = str;
+		return PARSE_EMPTY;
+	}
+
+	/* Exponent, only consumed if it has digits */
+	if ((!lim || p < lim) && (*p | 0x20) == 'e') {
+		const char *e     = p + 1;
+		bool exp_negative = false;
+
+		if ((!lim || e < lim) && (*e == '-' || *e == '+')) {
+			exp_negative = *e == '-';
+			e++;
+		}
+
+		if ((!lim || e < lim) && is_digit(*e)) {
+			int64_t exp_value = 0;
+
+			while ((!lim || e < lim) && is_digit(*e)) {
+				if (exp_value < MAX_PARSED_EXPONENT) {
+					exp_value = exp_value * 10 + (*e - '0');
+				}
+				e++;
+			}
+
+			exp10 += exp_negative ? -exp_value : exp_value;
+			p = e;
+		}
+	}
+
+	*end = p;
+
+	if (w == 0) {
+		*out = negative ? -0.0 : 0.0;
+		return PARSE_OK;
+	}
+
+	double value;
+
+	if (!truncated && exp10 >= -22 && exp10 <= 22 && w <= (1ULL << 53)) {
+		/* Clinger's fast path: both w and 10^|exp10| are exact, so a single operation rounds correctly */
+		value = (double) w;
+		value = exp10 < 0 ? value / EXACT_POW10[-exp10] : value * EXACT_POW10[exp10];
+	} else {
+		uint64_t bits;
+
+		if (!eisel_lemire(w, exp10, &bits)) {
+			return PARSE_SLOW;
+		}
+
+		if (truncated) {
+			/* The exact value is between w * 10^q and (w + 1) * 10^q: both must round the same way */
+			uint64_t upper_bits;
+			if (!eisel_lemire(w + 1, exp10, &upper_bits) || upper_bits != bits) {
+				return PARSE_SLOW;
+			}
+		}
+
+		memcpy(&value, &bits, sizeof(value));
+	}
+
+	*out = negative ? -value : value;
+	return PARSE_OK;
+}
+
+double util_strtod(const char *str, char **end)
+{
+	claim(str != NULL);
+
+	double value     = 0.0;
+	const char *stop = str;
+
+	if (parse_double(str, NULL, &value, &stop) == PARSE_SLOW) {
+		return strtod_c(str, end);
+	}
+
+	if (end) {
+		*end = (char *) stop;
+	}
+
+	return value;
+}
+
+/* !SECTION */
+/* SECTION - Length-delimited parsing */
+
+/**
+ * @brief Maps the result of an internal parsing function to an error code.
+ */
+static ErrStatus parse_status(ParseResult res)
+{
+	if (res == PARSE_EMPTY) {
+		return E_INVALID_ARG;
+	}
+	if (res == PARSE_RANGE) {
+		return E_OUT_OF_RANGE;
+	}
+
+	return E_SUCCESS;
+}
+
+ErrStatus util_parseLong(const char *str, size_t len, long min, long max, long *out, const char **end)
+{
+	claim(str != NULL && out != NULL);
+
+	const char *stop = str;
+	ParseResult res  = parse_integer(str, str + len, min, max, out, &stop);
+
+	if (end) {
+		*end = stop;
+	}
+
+	return parse_status(res);
+}
+
+/**
+ * @brief Finds the end of the longest prefix that strtod() might consume.
+ *
+ * @details Covers leading whitespace, a sign, and then letters, digits, '.' and '_', signs that
+ * follow an exponent marker ('e' or 'p'), and a parenthesized NaN payload. This is a superset of
+ * the syntax of strtod() (decimal and hexadecimal numbers, inf, infinity and nan(...)), so that
+ * only the bytes of the number are copied before calling it.
+ */
+static const char *numeric_extent(const char *p, const char *lim)
+{
+	while (p < lim && is_space(*p)) {
+		p++;
+	}
+
+	if (p < lim && (*p == '-' || *p == '+')) {
+		p++;
+	}
+
+	while (p < lim) {
+		char c = *p | 0x20; // Lowercase
+
+		if (is_digit(*p) || (c >= 'a' && c <= 'z') || *p == '.' || *p == '_') {
+			p++;
+		} else if ((*p == '-' || *p == '+') && ((p[-1] | 0x20) == 'e' || (p[-1] | 0x20) == 'p')) {
+			p++;
+		} else if (*p == '(') {
+			const char *q = p + 1;
+
+			while (q < lim && (is_digit(*q) || ((*q | 0x20) >= 'a' && (*q | 0x20) <= 'z') || *q == '_')) {
+				q++;
+			}
+
+			return q < lim && *q == ')' ? q + 1 : p;
+		} else {
+			break;
+		}
+	}
+
+	return p;
+}
+
+/**
+ * @brief Parses a length-delimited double with strtod(), leaving errno untouched.
+ *
+ * @return @ref PARSE_SLOW, with end set to str, if a temporary buffer could not be allocated.
+ */
+static ParseResult parse_double_strtod(const char *str, size_t len, double *out, const char **end)
+{
+	char local[STRTOD_BUFSIZE];
+
+	len       = (size_t) (numeric_extent(str, str + len) - str);
+	char *buf = len < sizeof(local) ? local : malloc(len + 1);
+
+	if (!buf) {
+		*end = str;
+		return PARSE_SLOW;
+	}
+
+	memcpy(buf, str, len);
+	buf[len] = '\0';
+
+	int saved_errno = errno;
+	char *stop;
+
+	errno          = 0;
+	double d       = strtod_c(buf, &stop);
+	bool out_range = errno == ERANGE;
+	errno          = saved_errno;
+
+	*end = str + (stop - buf);
+	if (buf != local) {
+		free(buf);
+	}
+
+	if (*end == str) {
+		return PARSE_EMPTY;
+	}
+
+	*out = d;
+	return out_range ? PARSE_RANGE : PARSE_OK;
+}
+
+ErrStatus util_parseDouble(const char *str, size_t len, double *out, const char **end)
+{
+	claim(str != NULL && out != NULL);
+
+	const char *stop = str;
+	ParseResult res  = parse_double(str, str + len, out, &stop);
+
+	if (res == PARSE_SLOW) {
+		res = parse_double_strtod(str, len, out, &stop);
+	}
+
+	if (end) {
+		*end = stop;
+	}
+
+	if (res == PARSE_SLOW) {
+		return E_OUT_OF_MEMORY;
+	}
+
+	return parse_status(res);
+}
+
+/* !SECTION */
+/* SECTION - Bulk parsing */
+
+/**
+ * @brief Function type of the internal parsers of a single field.
+ *
+ * @param str Start of the field.
+ * @param field_end End of the field.
+ * @param lim End of the buffer. Numbers are read up to lim rather than field_end, so that short
+ * fields can still be processed 8 bytes at a time; the caller checks that the number ends
+ * within the field.
+ */
+typedef ParseResult (*parse_field)(const char *str, const char *field_end, const char *lim, void *out,
+								   const char **end);
+
+static ParseResult parse_int_field(const char *str, const char *field_end, const char *lim, void *out,
+								   const char **end)
+{
+	long value      = 0;
+	ParseResult res = parse_integer(str, lim, INT_MIN, INT_MAX, &value, end);
+
+	if (*end > field_end) {
+		res = parse_integer(str, field_end, INT_MIN, INT_MAX, &value, end);
+	}
+
+	*(int *) out = (int) value;
+	return res;
+}
+
+static ParseResult parse_double_field(const char *str, const char *field_end, const char *lim, void *out,
+									  const char **end)
+{
+	ParseResult res = parse_double(str, lim, out, end);
+
+	if (res != PARSE_SLOW && *end > field_end) {
+		res = parse_double(str, field_end, out, end);
+	}
+
+	if (res == PARSE_SLOW) {
+		res = parse_double_strtod(str, (size_t) (field_end - str), out, end);
+	}
+
+	return res == PARSE_SLOW ? PARSE_EMPTY : res;
+}
+
+/**
+ * @brief Finds the next delimiter or newline, 16 bytes at a time when SSE2 is available.
+ *
+ * @return Pointer to the delimiter, or lim if there is none.
+ */
+static inline const char *find_delimiter(const char *p, const char *lim, char delim)
+{
+#ifdef __SSE2__
+	const __m128i delims   = _mm_set1_epi8(delim);
+	const __m128i newlines = _mm_set1_epi8('\n');
+
+	while (lim - p >= 16) {
+		__m128i chunk = _mm_loadu_si128((const __m128i *) p);
+		__m128i found = _mm_or_si128(_mm_cmpeq_epi8(chunk, delims), _mm_cmpeq_epi8(chunk, newlines));
+		unsigned mask = (unsigned) _mm_movemask_epi8(found);
+
+		if (mask) {
+			return p + __builtin_ctz(mask);
+		}
+		p += 16;
+	}
+#endif
+
+	while (p < lim && *p != delim && *p != '\n') {
+		p++;
+	}
+
+	return p;
+}
+
+/**
+ * @brief Parses delimited fields into an array of elements of the given size.
+ */
+static inline size_t parse_column(const char *buf, size_t len, char delim, void *out, size_t size, size_t n,
+								  ParseStats *stats, parse_field parse)
+{
+	const char *p   = buf;
+	const char *lim = buf + len;
+	size_t count    = 0;
+	size_t errors   = 0;
+
+	while (p < lim && count < n) {
+		const char *field_end = find_delimiter(p, lim, delim);
+		char *elem            = (char *) out + count * size;
+		const char *stop;
+
+		ParseResult res = parse(p, field_end, lim, elem, &stop);
+
+		/* Only trailing whitespace may follow the number */
+		while (stop < field_end && is_space(*stop)) {
+			stop++;
+		}
+
+		if (res == PARSE_EMPTY || stop != field_end) {
+			memset(elem, 0, size);
+			res = PARSE_EMPTY;
+		}
+
+		if (res != PARSE_OK) {
+			if (stats && errors < stats->error_capacity) {
+				stats->error_offsets[errors] = (size_t) (p - buf);
+			}
+			errors++;
+		}
+
+		count++;
+		p = field_end < lim ? field_end + 1 : lim;
+	}
+
+	if (stats) {
+		stats->count    = count;
+		stats->errors   = errors;
+		stats->consumed = (size_t) (p - buf);
+	}
+
+	return count;
+}
+
+size_t util_parseInts(const char *buf, size_t len, char delim, int *out, size_t n, ParseStats *stats)
+{
+	claim(buf != NULL && (out != NULL || n == 0));
+	claim(!stats || stats->error_offsets != NULL || stats->error_capacity == 0);
+
+	return parse_column(buf, len, delim, out, sizeof(*out), n, stats, parse_int_field);
+}
+
+size_t util_parseDoubles(const char *buf, size_t len, char delim, double *out, size_t n, ParseStats *stats)
+{
+	claim(buf != NULL && (out != NULL || n == 0));
+	claim(!stats || stats->error_offsets != NULL || stats->error_capacity == 0);
+
+	return parse_column(buf, len, delim, out, sizeof(*out), n, stats, parse_double_field);
+}
+
+/* !SECTION */
@@ -0,0 +1,205 @@
+/**
+ * @brief Bulk printing of arrays of elements.
+ *
+ * @file print.c
+ */
+
+#include "print.h"
+
+#include "dbg.h"
+#include "macros.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/**
+ * @brief Output buffer of the bulk printing functions.
+ */
+typedef struct {
+	char *data;    /**< Buffer of @ref UTIL_PRINT_BUFSIZE bytes */
+	size_t len;    /**< Number of bytes pending to be written */
+	FILE *file;    /**< Destination stream, or NULL to use fd */
+	int fd;        /**< Destination file descriptor */
+	ssize_t total; /**< Number of bytes written so far */
+} Batch;
+
+/* SECTION - Helpers */
+
+/**
+ * @brief Writes len bytes to the destination of the batch, retrying on partial writes.
+ */
+static bool batch_write(Batch *b, const char *data, size_t len)
+{
+	if (b->file) {
+		if (fwrite(data, sizeof(char), len, b->file) != len) {
+			return false;
+		}
+	} else {
+		size_t done = 0;
+
+		while (done < len) {
+			ssize_t w = write(b->fd, data + done, len - done);
+			if (w < 0) {
+				if (errno == EINTR) {
+					continue;
+				}
+				return false;
+			}
+			done += (size_t) w;
+		}
+	}
+
+	b->total += (ssize_t) len;
+	return true;
+}
+
+static bool batch_flush(Batch *b)
+{
+	bool ok = batch_write(b, b->data, b->len);
+	b->len  = 0;
+
+	return ok;
+}
+
+/**
+ * @brief Formats an element followed by a space into the batch, flushing it if needed.
+ */
+static bool batch_add(Batch *b, const void *elem, util_toBuffer toBuffer)
+{
+	size_t room = UTIL_PRINT_BUFSIZE - b->len;
+	int len     = toBuffer(b->data + b->len, room, elem);
+
+	if (len < 0) {
+		/* Elements without a representation are printed as DEF_NULL */
+		elem     = DEF_NULL;
+		toBuffer = util_string_toBuffer;
+		len      = toBuffer(b->data + b->len, room, elem);
+	}
+
+	if ((size_t) len >= room) {
+		/* Did not fit: flush and try again with the whole buffer */
+		if (!batch_flush(b)) {
+			return false;
+		}
+
+		if ((size_t) len >= UTIL_PRINT_BUFSIZE) {
+			/* Larger than the buffer itself: format it on its own */
+			char *tmp = malloc((size_t) len + 2);
+			check_mem(tmp);
+
+			toBuffer(tmp, (size_t) len + 1, elem);
+			tmp[len] = ' ';
+			bool ok  = batch_write(b, tmp, (size_t) len + 1);
+			free(tmp);
+
+			return ok;
+		}
+
+		toBuffer(b->data, UTIL_PRINT_BUFSIZE, elem);
+	}
+
+	b->len += (size_t) len;
+	b->data[b->len++] = ' '; // Overwrites the null byte, which always fits
+
+	return true;
+
+error:
+	return false;
+}
+
+/**
+ * @brief Shared implementation of util_printArray() and util_printArrayFd().
+ */
+static ssize_t print_batch(Batch *b, const void *const *elems, size_t n, util_toBuffer toBuffer)
+{
+	claim(toBuffer != NULL);
+	claim(elems != NULL || n == 0);
+
+	b->data = malloc(UTIL_PRINT_BUFSIZE);
+	check_mem(b->data);
+
+	for (size_t i = 0; i < n; i++) {
+		if (!batch_add(b, elems[i], toBuffer)) {
+			goto error;
+		}
+	}
+
+	if (!batch_flush(b)) {
+		goto error;
+	}
+
+	free(b->data);
+	return b->total;
+
+error:
+	free(b->data);
+	return -1;
+}
+
+/* !SECTION */
+/* SECTION - Bulk printing */
+
+ssize_t util_printArray(FILE *file, const void *const *elems, size_t n, util_toBuffer toBuffer)
+{
+	claim(file != NULL);
+
+	Batch b = { .file = file };
+
+	return print_batch(&b, elems, n, toBuffer);
+}
+
+ssize_t util_printArrayFd(int fd, const void *const *elems, size_t n, util_toBuffer toBuffer)
+{
+	Batch b = { .fd = fd };
+
+	return print_batch(&b, elems, n, toBuffer);
+}
+
+ssize_t util_printArrayLocked(FILE *file, const void *const *elems, size_t n, util_toBuffer toBuffer)
+{
+	claim(file != NULL);
+	claim(toBuffer != NULL);
+	claim(elems != NULL || n == 0);
+
+	char buf[UTIL_PRIMITIVE_BUFSIZE];
+	ssize_t total = 0;
+
+	flockfile(file);
+
+	for (size_t i = 0; i < n; i++) {
+		const char *str = buf;
+		char *tmp       = NULL;
+		int len         = toBuffer(buf, sizeof(buf), elems[i]);
+
+		if (len < 0) {
+			str = DEF_NULL;
+			len = (int) strlen(DEF_NULL);
+		} else if ((size_t) len >= sizeof(buf)) {
+			tmp = malloc((size_t) len + 1);
+			check_mem(tmp);
+			toBuffer(tmp, (size_t) len + 1, elems[i]);
+			str = tmp;
+		}
+
+		for (int j = 0; j < len; j++) {
+			if (putc_unlocked(str[j], file) == EOF) {
+				free(tmp);
+				goto error;
+			}
+		}
+		free(tmp);
+
+		check(putc_unlocked(' ', file) != EOF, "Could not print to the stream");
+		total += len + 1;
+	}
+
+	funlockfile(file);
+	return total;
+
+error:
+	funlockfile(file);
+	return -1;
+}
+
+/* !SECTION */
@@ -0,0 +1,304 @@
+/**
+ * @brief Output sinks: destinations for printed text that do not depend on stdio.
+ *
+ * @file sink.c
+ */
+
+#include "sink.h"
+
+#include "format.h"
+#include "macros.h"
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/**
+ * @brief Minimum capacity of the buffer of a memory sink once something is written to it.
+ */
+#define MEMORY_SINK_MIN_CAP 64
+
+/* SECTION - Backends */
+
+static ssize_t file_write(Sink *sink, const char *data, size_t len)
+{
+	return fwrite(data, sizeof(char), len, sink->file) == len ? (ssize_t) len : -1;
+}
+
+static ssize_t fd_write(Sink *sink, const char *data, size_t len)
+{
+	size_t done = 0;
+
+	while (done < len) {
+		ssize_t w = write(sink->fd, data + done, len - done);
+		if (w < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			return -1;
+		}
+		done += (size_t) w;
+	}
+
+	return (ssize_t) len;
+}
+
+static ssize_t memory_write(Sink *sink, const char *data, size_t len)
+{
+	if (sink->mem.cap - sink->mem.len < len) {
+		size_t cap = sink->mem.cap < MEMORY_SINK_MIN_CAP ? MEMORY_SINK_MIN_CAP : sink->mem.cap;
+		while (cap - sink->mem.len < len) {
+			cap *= 2;
+		}
+
+		char *tmp = realloc(sink->mem.data, cap);
+		check_mem(tmp);
+
+		sink->mem.data = tmp;
+		sink->mem.cap  = cap;
+	}
+
+	memcpy(sink->mem.data + sink->mem.len, data, len);
+	sink->mem.len += len;
+
+	return (ssize_t) len;
+
+error:
+	return -1;
+}
+
+static ssize_t ring_write(Sink *sink, const char *data, size_t len)
+{
+	size_t cap   = sink->ring.cap;
+	size_t total = len;
+
+	if (len >= cap) {
+		/* Only the last bytes survive */
+		memcpy(sink->ring.data, data + len - cap, cap);
+		sink->ring.head = 0;
+		sink->ring.len  = cap;
+		return (ssize_t) total;
+	}
+
+	size_t tail  = (sink->ring.head + sink->ring.len) % cap;
+	size_t first = len < cap - tail ? len : cap - tail;
+	memcpy(sink->ring.data + tail, data, first);
+	memcpy(sink->ring.data, data + first, len - first);
+
+	sink->ring.len += len;
+	if (sink->ring.len > cap) {
+		/* Oldest bytes were overwritten */
+		sink->ring.head = (sink->ring.head + sink->ring.len - cap) % cap;
+		sink->ring.len  = cap;
+	}
+
+	return (ssize_t) total;
+}
+
+/* !SECTION */
+/* SECTION - Creation and destruction */
+
+void util_sink_initFile(Sink *sink, FILE *file)
+{
+	claim(sink != NULL);
+	claim(file != NULL);
+
+	*sink = (Sink) { .write = file_write, .file = file };
+}
+
+void util_sink_initFd(Sink *sink, int fd)
+{
+	claim(sink != NULL);
+
+	*sink = (Sink) { .write = fd_write, .fd = fd };
+}
+
+ErrStatus util_sink_initMemory(Sink *sink, size_t capacity)
+{
+	claim(sink != NULL);
+
+	*sink = (Sink) { .write = memory_write };
+
+	if (capacity > 0) {
+		sink->mem.data = malloc(capacity);
+		check_mem(sink->mem.data);
+		sink->mem.cap = capacity;
+	}
+
+	return E_SUCCESS;
+
+error:
+	return E_OUT_OF_MEMORY;
+}
+
+void util_sink_initRing(Sink *sink, char *buf, size_t capacity)
+{
+	claim(sink != NULL);
+	claim(buf != NULL);
+	claim(capacity > 0);
+
+	*sink = (Sink) { .write = ring_write, .ring = { .data = buf, .cap = capacity } };
+}
+
+void util_sink_destroy(Sink *sink)
+{
+	if (!sink) {
+		return;
+	}
+
+	if (sink->write == memory_write) {
+		free(sink->mem.data);
+		sink->mem.data = NULL;
+		sink->mem.len  = 0;
+		sink->mem.cap  = 0;
+	}
+}
+
+/* !SECTION */
+/* SECTION - Writing and reading */
+
+ssize_t util_sink_write(Sink *sink, const char *data, size_t len)
+{
+	claim(sink != NULL);
+
+	return sink->write(sink, data, len);
+}
+
+const char *util_sink_memoryData(const Sink *sink, size_t *len)
+{
+	claim(sink != NULL);
+	claim(sink->write == memory_write);
+
+	if (len) {
+		*len = sink->mem.len;
+	}
+
+	return sink->mem.data;
+}
+
+size_t util_sink_ringRead(Sink *sink, char *buf, size_t size)
+{
+	claim(sink != NULL);
+	claim(sink->write == ring_write);
+
+	size_t n     = size < sink->ring.len ? size : sink->ring.len;
+	size_t first = n < sink->ring.cap - sink->ring.head ? n : sink->ring.cap - sink->ring.head;
+
+	memcpy(buf, sink->ring.data + sink->ring.head, first);
+	memcpy(buf + first, sink->ring.data, n - first);
+
+	sink->ring.head = (sink->ring.head + n) % sink->ring.cap;
+	sink->ring.len -= n;
+
+	return n;
+}
+
+/* !SECTION */
+/* SECTION - Printing functions */
+
+/**
+ * @brief Writes a string of the given length, optionally followed by a space, in a single write,
+ * so that output on a shared file descriptor cannot interleave between a value and its separator.
+ * Strings that do not fit on the stack are copied to a temporary buffer.
+ */
+static int sink_print(Sink *sink, const char *str, size_t len, bool space)
+{
+	char stack_buf[UTIL_PRIMITIVE_BUFSIZE];
+	char *buf = stack_buf;
+	int ret   = -1;
+
+	if (!space) {
+		return sink->write(sink, str, len) < 0 ? -1 : (int) len;
+	}
+
+	if (len >= sizeof(stack_buf)) {
+		buf = malloc(len + 1);
+		check_mem(buf);
+	}
+
+	memcpy(buf, str, len);
+	buf[len++] = ' ';
+	ret        = sink->write(sink, buf, len) < 0 ? -1 : (int) len;
+
+error:
+	if (buf != stack_buf) {
+		free(buf);
+	}
+	return ret;
+}
+
+/**
+ * @brief Prints @ref DEF_NULL followed by a space.
+ */
+static int sink_print_null(Sink *sink)
+{
+	return sink_print(sink, DEF_NULL, strlen(DEF_NULL), true);
+}
+
+int util_generic_sinkPrint(Sink *sink, const void *p)
+{
+	claim(sink != NULL);
+
+	if (!p) {
+		return sink_print_null(sink);
+	}
+
+	char buf[UTIL_PRIMITIVE_BUFSIZE];
+	int len = util_generic_toBuffer(buf, sizeof(buf), p);
+
+	return sink_print(sink, buf, (size_t) len, false);
+}
+
+int util_char_sinkPrint(Sink *sink, const void *c)
+{
+	claim(sink != NULL);
+
+	if (!c) {
+		return sink_print_null(sink);
+	}
+
+	return sink_print(sink, c, 1, true);
+}
+
+int util_int_sinkPrint(Sink *sink, const void *i)
+{
+	claim(sink != NULL);
+
+	if (!i) {
+		return sink_print_null(sink);
+	}
+
+	char buf[UTIL_FORMAT_BUFSIZE];
+	size_t len = util_formatInt(buf, *(const int *) i);
+
+	return sink_print(sink, buf, len, true);
+}
+
+int util_double_sinkPrint(Sink *sink, const void *d)
+{
+	claim(sink != NULL);
+
+	if (!d) {
+		return sink_print_null(sink);
+	}
+
+	char buf[UTIL_FORMAT_BUFSIZE];
+	size_t len = util_formatDouble(buf, *(const double *) d);
+
+	return sink_print(sink, buf, len, false);
+}
+
+int util_string_sinkPrint(Sink *sink, const void *s)
+{
+	claim(sink != NULL);
+
+	if (!s) {
+		return sink_print_null(sink);
+	}
+
+	return sink_print(sink, s, strlen((const char *) s), true);
+}
+
+/* !SECTION */
@@ -0,0 +1,1504 @@
+/**
+ * @brief Sorting of arrays with the comparison functions of utilities.h.
+ *
+ * @file sort.c
+ */
+
+#include "sort.h"
+
+#include "dbg.h"
+#include "sort_template.h"
+
+#include <limits.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#ifdef __AVX2__
+	#include <immintrin.h>
+#endif
+
+_Static_assert(sizeof(int) == sizeof(uint32_t), "Radix sort of ints assumes 32-bit ints");
+
+/**
+ * @brief Arrays smaller than this are sorted by comparison instead of radix sort,
+ * whose fixed cost of clearing and scanning the histograms would dominate.
+ */
+#define RADIX_THRESHOLD 256
+
+/**
+ * @brief Number of buckets of a radix sort pass, one per byte value.
+ */
+#define RADIX_BUCKETS 256
+
+/* SECTION - Sorting networks */
+
+/**
+ * @brief Arrays are padded to at least this many elements, one AVX2 vector of ints, before
+ * running a sorting network.
+ */
+#define NETWORK_MIN 8
+
+/**
+ * @brief Defines a bitonic sorting network over an array of m elements of type, where m is a
+ * power of 2, with branchless compare-exchanges.
+ *
+ * @details Each stage merges pairs of sorted blocks of size k, first by comparing each element
+ * with its mirror in the other block, and then with half-cleaners of decreasing strides.
+ * Every compare-exchange puts the minimum at the lower index, so that no direction is tracked.
+ * The generated function is `static void name(type *a, size_t m)`.
+ */
+#define DEFINE_SCALAR_NETWORK(name, type)                                           \
+	static void name(type *a, size_t m)                                             \
+	{                                                                               \
+		for (size_t k = 1; k < m; k *= 2) {                                         \
+			for (size_t j = 2 * k - 1; j > 0; j = j == 2 * k - 1 ? k / 2 : j / 2) { \
+				for (size_t i = 0; i < m; i++) {                                    \
+					size_t p = i ^ j;                                               \
+					if (p > i) {                                                    \
+						type x = a[i];                                              \
+						type y = a[p];                                              \
+						a[i]   = x < y ? x : y;                                     \
+						a[p]   = x < y ? y : x;                                     \
+					}                                                               \
+				}                                                                   \
+			}                                                                       \
+		}                                                                           \
+	}
+
+#ifdef __AVX2__
+
+/**
+ * @brief Forces the inlining of a function, so that its loops are unrolled for constant arguments.
+ */
+#define ALWAYS_INLINE __attribute__((always_inline))
+
+/**
+ * @brief Moves each 32-bit lane i of v to lane i ^ x.
+ */
+static inline __m256i lanes_swap(__m256i v, unsigned x)
+{
+	__m256i index = _mm256_xor_si256(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32((int) x));
+	return _mm256_permutevar8x32_epi32(v, index);
+}
+
+/**
+ * @brief Mask of the 32-bit lanes i with i > (i ^ x), which receive the maximum of a compare-exchange.
+ */
+static inline __m256i lanes_upper(unsigned x)
+{
+	unsigned high = 1U << (31 - __builtin_clz(x));
+	__m256i bit   = _mm256_set1_epi32((int) high);
+
+	return _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), bit), bit);
+}
+
+static inline __m256i min_i32(__m256i v, __m256i w)
+{
+	return _mm256_min_epi32(v, w);
+}
+
+static inline __m256i max_i32(__m256i v, __m256i w)
+{
+	return _mm256_max_epi32(v, w);
+}
+
+static inline __m256i min_i64(__m256i v, __m256i w)
+{
+	return _mm256_blendv_epi8(v, w, _mm256_cmpgt_epi64(v, w));
+}
+
+static inline __m256i max_i64(__m256i v, __m256i w)
+{
+	return _mm256_blendv_epi8(w, v, _mm256_cmpgt_epi64(v, w));
+}
+
+/**
+ * @brief Defines the bitonic network of DEFINE_SCALAR_NETWORK over count AVX2 vectors of lanes
+ * elements each, where count is a power of 2.
+ *
+ * @details Strides of at least a vector are compare-exchanges of whole vectors, mirrors being
+ * reversed vectors. Smaller strides exchange the lanes of each vector with a permutation and
+ * blend the minimum and maximum, the permutation working on 32-bit lanes, which are
+ * scale per element. The generated function is `static inline void name(__m256i *v, size_t count)`,
+ * which is always inlined: called with a constant count, its loops are fully unrolled.
+ */
+#define DEFINE_VECTOR_NETWORK(name, lanes, scale, min, max)                                \
+	ALWAYS_INLINE static inline void name(__m256i *v, size_t count)                        \
+	{                                                                                      \
+		for (size_t k = 1; k < (lanes) * count; k *= 2) {                                  \
+			for (size_t j = 2 * k - 1; j > 0; j = j == 2 * k - 1 ? k / 2 : j / 2) {        \
+				if (j < (lanes)) {                                                         \
+					unsigned x    = (unsigned) (j * (scale));                              \
+					__m256i upper  = lanes_upper(x);                                       \
+					for (size_t u = 0; u < count; u++) {                                   \
+						__m256i w = lanes_swap(v[u], x);                                   \
+						v[u]      = _mm256_blendv_epi8(min(v[u], w), max(v[u], w), upper); \
+					}                                                                      \
+				} else if (j == 2 * k - 1) {                                               \
+					unsigned x = (unsigned) ((lanes) - 1) * (scale);                       \
+					size_t w   = 2 * k / (lanes);                                          \
+					for (size_t b = 0; b < count; b += w) {                                \
+						for (size_t u = 0; u < w / 2; u++) {                               \
+							__m256i lo       = v[b + u];                                   \
+							__m256i hi       = lanes_swap(v[b + w - 1 - u], x);            \
+							v[b + u]         = min(lo, hi);                                \
+							v[b + w - 1 - u] = lanes_swap(max(lo, hi), x);                 \
+						}                                                                  \
+					}                                                                      \
+				} else {                                                                   \
+					size_t d = j / (lanes);                                                \
+					for (size_t u = 0; u < count; u++) {                                   \
+						if ((u & d) == 0) {                                                \
+							__m256i lo = v[u];                                             \
+							v[u]       = min(lo, v[u + d]);                                \
+							v[u + d]   = max(lo, v[u + d]);                                \
+						}                                                                  \
+					}                                                                      \
+				}                                                                          \
+			}                                                                              \
+		}                                                                                  \
+	}
+
+DEFINE_VECTOR_NETWORK(network_i32, 8, 1, min_i32, max_i32)
+DEFINE_VECTOR_NETWORK(network_i64, 4, 2, min_i64, max_i64)
+
+#else
+
+DEFINE_SCALAR_NETWORK(network_i32, int32_t)
+DEFINE_SCALAR_NETWORK(network_i64, int64_t)
+
+#endif
+
+/**
+ * @brief Smallest power of 2 that is at least n and NETWORK_MIN.
+ */
+static size_t network_size(size_t n)
+{
+	size_t m = NETWORK_MIN;
+
+	while (m < n) {
+		m *= 2;
+	}
+
+	return m;
+}
+
+/**
+ * @brief Sorts up to UTIL_SMALL_SORT_MAX ints with a sorting network, padding them with INT_MAX.
+ */
+static void network_sort_ints(int *a, size_t n)
+{
+	int32_t keys[UTIL_SMALL_SORT_MAX];
+	size_t m = network_size(n);
+
+	memcpy(keys, a, n * sizeof(int));
+	for (size_t i = n; i < m; i++) {
+		keys[i] = INT32_MAX;
+	}
+
+#ifdef __AVX2__
+	__m256i v[UTIL_SMALL_SORT_MAX / 8];
+	for (size_t u = 0; u < m / 8; u++) {
+		v[u] = _mm256_loadu_si256((const __m256i *) (keys + 8 * u));
+	}
+	if (m == 8) {
+		network_i32(v, 1);
+	} else if (m == 16) {
+		network_i32(v, 2);
+	} else if (m == 32) {
+		network_i32(v, 4);
+	} else {
+		network_i32(v, 8);
+	}
+	for (size_t u = 0; u < m / 8; u++) {
+		_mm256_storeu_si256((__m256i *) (keys + 8 * u), v[u]);
+	}
+#else
+	network_i32(keys, m);
+#endif
+
+	memcpy(a, keys, n * sizeof(int));
+}
+
+#ifndef __AVX2__
+
+/**
+ * @brief Maps the bits of a double to a signed integer with the order of util_double_totalCmp(),
+ * by flipping all the bits but the sign of negative doubles, and back.
+ */
+static int64_t total_bits(int64_t bits)
+{
+	return bits ^ (int64_t) ((uint64_t) (bits >> 63) >> 1);
+}
+
+#endif
+
+/**
+ * @brief Sorts up to UTIL_SMALL_SORT_MAX doubles in totalOrder with a sorting network on their
+ * bits as signed integers, padding them with the greatest key, which is the bits of a NaN.
+ */
+static void network_sort_doubles(double *a, size_t n)
+{
+	int64_t keys[UTIL_SMALL_SORT_MAX];
+	size_t m = network_size(n);
+
+	memcpy(keys, a, n * sizeof(double));
+	for (size_t i = n; i < m; i++) {
+		keys[i] = INT64_MAX;
+	}
+
+#ifdef __AVX2__
+	/* The keys are computed in the vectors, where total_bits() is a shift and a xor */
+	__m256i v[UTIL_SMALL_SORT_MAX / 4];
+	__m256i zero = _mm256_setzero_si256();
+	for (size_t u = 0; u < m / 4; u++) {
+		v[u] = _mm256_loadu_si256((const __m256i *) (keys + 4 * u));
+		v[u] = _mm256_xor_si256(v[u], _mm256_srli_epi64(_mm256_cmpgt_epi64(zero, v[u]), 1));
+	}
+	if (m == 8) {
+		network_i64(v, 2);
+	} else if (m == 16) {
+		network_i64(v, 4);
+	} else if (m == 32) {
+		network_i64(v, 8);
+	} else {
+		network_i64(v, 16);
+	}
+	for (size_t u = 0; u < m / 4; u++) {
+		v[u] = _mm256_xor_si256(v[u], _mm256_srli_epi64(_mm256_cmpgt_epi64(zero, v[u]), 1));
+		_mm256_storeu_si256((__m256i *) (keys + 4 * u), v[u]);
+	}
+#else
+	for (size_t i = 0; i < n; i++) {
+		keys[i] = total_bits(keys[i]);
+	}
+	network_i64(keys, m);
+	for (size_t i = 0; i < n; i++) {
+		keys[i] = total_bits(keys[i]);
+	}
+#endif
+
+	memcpy(a, keys, n * sizeof(double));
+}
+
+/* !SECTION */
+/* SECTION - Comparison sorts */
+
+#define LESS_VALUE(a, b)     ((a) < (b))
+#define LESS_ELEM(a, b, cmp) ((cmp)((a), (b)) < 0)
+#define LESS_TOTAL(a, b)     (util_double_totalKey(a) < util_double_totalKey(b))
+
+#ifdef __AVX2__
+
+/* Sorting networks for the small ranges; the scalar networks are not faster than insertion sort */
+UTIL_DEFINE_SORT_LEAF(introsort_int, int, LESS_VALUE, network_sort_ints)
+UTIL_DEFINE_SORT_LEAF(introsort_double, double, LESS_VALUE, network_sort_doubles)
+UTIL_DEFINE_SORT_LEAF(introsort_total, double, LESS_TOTAL, network_sort_doubles)
+
+#else
+
+UTIL_DEFINE_SORT(introsort_int, int, LESS_VALUE)
+UTIL_DEFINE_SORT(introsort_double, double, LESS_VALUE)
+UTIL_DEFINE_SORT(introsort_total, double, LESS_TOTAL)
+
+#endif
+UTIL_DEFINE_SORT_CTX(introsort_ptr, void *, util_compare, LESS_ELEM)
+
+/**
+ * @brief Swaps two elements of the given size.
+ */
+static void swap_elems(char *a, char *b, size_t size)
+{
+	if (size == sizeof(uint64_t)) {
+		uint64_t t;
+		memcpy(&t, a, sizeof(t));
+		memcpy(a, b, sizeof(t));
+		memcpy(b, &t, sizeof(t));
+		return;
+	}
+
+	for (; size >= sizeof(uint64_t); size -= sizeof(uint64_t), a += sizeof(uint64_t), b += sizeof(uint64_t)) {
+		uint64_t t;
+		memcpy(&t, a, sizeof(t));
+		memcpy(a, b, sizeof(t));
+		memcpy(b, &t, sizeof(t));
+	}
+
+	for (; size > 0; size--, a++, b++) {
+		char t = *a;
+		*a     = *b;
+		*b     = t;
+	}
+}
+
+static void generic_siftDown(char *a, size_t root, size_t n, size_t size, util_compare cmp)
+{
+	size_t child;
+
+	while ((child = 2 * root + 1) < n) {
+		if (child + 1 < n && cmp(a + child * size, a + (child + 1) * size) < 0) {
+			child++;
+		}
+		if (cmp(a + root * size, a + child * size) >= 0) {
+			break;
+		}
+		swap_elems(a + root * size, a + child * size, size);
+		root = child;
+	}
+}
+
+static void generic_heapsort(char *a, size_t n, size_t size, util_compare cmp)
+{
+	for (size_t i = n / 2; i > 0; i--) {
+		generic_siftDown(a, i - 1, n, size, cmp);
+	}
+
+	for (size_t i = n - 1; i > 0; i--) {
+		swap_elems(a, a + i * size, size);
+		generic_siftDown(a, 0, i, size, cmp);
+	}
+}
+
+/**
+ * @brief Introsort of elements of any size, with the same structure as @ref UTIL_DEFINE_SORT_CTX.
+ */
+static void generic_introsort(char *a, size_t n, size_t size, util_compare cmp, size_t depth)
+{
+	while (n > UTIL_SORT_INSERTION_THRESHOLD) {
+		if (depth-- == 0) {
+			generic_heapsort(a, n, size, cmp);
+			return;
+		}
+
+		char *mid  = a + n / 2 * size;
+		char *last = a + (n - 1) * size;
+		if (cmp(mid, a) < 0) {
+			swap_elems(mid, a, size);
+		}
+		if (cmp(last, mid) < 0) {
+			swap_elems(mid, last, size);
+		}
+		if (cmp(mid, a) < 0) {
+			swap_elems(mid, a, size);
+		}
+		swap_elems(mid, a, size);
+
+		size_t i = 0;
+		size_t j = n;
+		for (;;) {
+			while (++i < n - 1 && cmp(a + i * size, a) < 0) {
+			}
+			while (--j > 0 && cmp(a, a + j * size) < 0) {
+			}
+			if (i >= j) {
+				break;
+			}
+			swap_elems(a + i * size, a + j * size, size);
+		}
+		swap_elems(a, a + j * size, size);
+
+		if (j < n - j - 1) {
+			generic_introsort(a, j, size, cmp, depth);
+			a += (j + 1) * size;
+			n -= j + 1;
+		} else {
+			generic_introsort(a + (j + 1) * size, n - j - 1, size, cmp, depth);
+			n = j;
+		}
+	}
+
+	for (size_t i = 1; i < n; i++) {
+		for (char *p = a + i * size; p > a && cmp(p, p - size) < 0; p -= size) {
+			swap_elems(p, p - size, size);
+		}
+	}
+}
+
+/* !SECTION */
+/* SECTION - String sort */
+
+/**
+ * @brief Character of a string at the given depth, as compared by strcmp().
+ */
+static unsigned char char_at(const char *s, size_t depth)
+{
+	return (unsigned char) s[depth];
+}
+
+/**
+ * @brief Multikey quicksort (Bentley and Sedgewick) of strings sharing their first depth characters.
+ *
+ * @details Each step partitions the strings in three groups by a single character, so that the
+ * common prefixes are never compared again.
+ */
+static void multikey_quicksort(char **a, size_t n, size_t depth)
+{
+	while (n > UTIL_SORT_INSERTION_THRESHOLD) {
+		unsigned char c0 = char_at(a[0], depth);
+		unsigned char c1 = char_at(a[n / 2], depth);
+		unsigned char c2 = char_at(a[n - 1], depth);
+		unsigned char v  = c0 < c1 ? (c1 < c2 ? c1 : (c0 < c2 ? c2 : c0)) : (c0 < c2 ? c0 : (c1 < c2 ? c2 : c1));
+
+		/* Dijkstra's three-way partition: [0, lt) < v, [lt, gt) == v, [gt, n) > v */
+		size_t lt = 0;
+		size_t gt = n;
+		for (size_t i = 0; i < gt;) {
+			unsigned char c = char_at(a[i], depth);
+			char *t;
+
+			if (c < v) {
+				t = a[lt], a[lt++] = a[i], a[i++] = t;
+			} else if (c > v) {
+				t = a[--gt], a[gt] = a[i], a[i] = t;
+			} else {
+				i++;
+			}
+		}
+
+		/* The middle group holds equal strings if v ends them, otherwise it continues at the next byte */
+		size_t less    = lt;
+		size_t equal   = v == '\0' ? 0 : gt - lt;
+		size_t greater = n - gt;
+
+		/* Recurse on the two smaller groups and loop on the largest, so the stack depth is logarithmic */
+		if (equal >= less && equal >= greater) {
+			multikey_quicksort(a, less, depth);
+			multikey_quicksort(a + gt, greater, depth);
+			a += lt;
+			n = equal;
+			depth++;
+		} else if (less >= greater) {
+			if (equal > 0) {
+				multikey_quicksort(a + lt, equal, depth + 1);
+			}
+			multikey_quicksort(a + gt, greater, depth);
+			n = less;
+		} else {
+			multikey_quicksort(a, less, depth);
+			if (equal > 0) {
+				multikey_quicksort(a + lt, equal, depth + 1);
+			}
+			a += gt;
+			n = greater;
+		}
+	}
+
+	for (size_t i = 1; i < n; i++) {
+		char *x  = a[i];
+		size_t j = i;
+		for (; j > 0 && strcmp(x + depth, a[j - 1] + depth) < 0; j--) {
+			a[j] = a[j - 1];
+		}
+		a[j] = x;
+	}
+}
+
+/* !SECTION */
+/* SECTION - Radix sorts */
+
+/**
+ * @brief Defines a stable LSD radix sort of unsigned keys of type key_t, one byte per pass.
+ *
+ * @details If vals is not NULL, each value is moved along with its key. Passes where all the
+ * keys have the same byte are skipped, so narrow keys only cost the passes they need.
+ * The generated function is `static bool name(key_t *keys, void **vals, size_t n)`, which
+ * returns false, without sorting, if the buffers could not be allocated.
+ */
+#define DEFINE_RADIX_SORT(name, key_t)                               \
+	static bool name(key_t *keys, void **vals, size_t n)             \
+	{                                                                \
+		size_t counts[sizeof(key_t)][RADIX_BUCKETS] = {0};           \
+                                                                     \
+		key_t *kbuf = malloc(n * sizeof(key_t));                     \
+		void **vbuf = vals ? malloc(n * sizeof(void *)) : NULL;      \
+                                                                     \
+		if (!kbuf || (vals && !vbuf)) {                              \
+			free(kbuf);                                              \
+			free(vbuf);                                              \
+			return false;                                            \
+		}                                                            \
+                                                                     \
+		for (size_t i = 0; i < n; i++) {                             \
+			for (size_t b = 0; b < sizeof(key_t); b++) {             \
+				counts[b][(keys[i] >> (8 * b)) & 0xFF]++;            \
+			}                                                        \
+		}                                                            \
+                                                                     \
+		key_t *src  = keys;                                          \
+		key_t *dst  = kbuf;                                          \
+		void **vsrc = vals;                                          \
+		void **vdst = vbuf;                                          \
+                                                                     \
+		for (size_t b = 0; b < sizeof(key_t); b++) {                 \
+			size_t *count  = counts[b];                              \
+			unsigned shift = 8 * (unsigned) b;                       \
+                                                                     \
+			if (count[(src[0] >> shift) & 0xFF] == n) {              \
+				continue;                                            \
+			}                                                        \
+                                                                     \
+			size_t offset = 0;                                       \
+			for (size_t d = 0; d < RADIX_BUCKETS; d++) {             \
+				size_t c = count[d];                                 \
+				count[d] = offset;                                   \
+				offset += c;                                         \
+			}                                                        \
+                                                                     \
+			if (vals) {                                              \
+				for (size_t i = 0; i < n; i++) {                     \
+					size_t pos = count[(src[i] >> shift) & 0xFF]++;  \
+					dst[pos]   = src[i];                             \
+					vdst[pos]  = vsrc[i];                            \
+				}                                                    \
+			} else {                                                 \
+				for (size_t i = 0; i < n; i++) {                     \
+					dst[count[(src[i] >> shift) & 0xFF]++] = src[i]; \
+				}                                                    \
+			}                                                        \
+                                                                     \
+			key_t *t  = src;                                         \
+			src       = dst;                                         \
+			dst       = t;                                           \
+			void **vt = vsrc;                                        \
+			vsrc      = vdst;                                        \
+			vdst      = vt;                                          \
+		}                                                            \
+                                                                     \
+		if (src != keys) {                                           \
+			memcpy(keys, src, n * sizeof(key_t));                    \
+			if (vals) {                                              \
+				memcpy(vals, vsrc, n * sizeof(void *));              \
+			}                                                        \
+		}                                                            \
+                                                                     \
+		free(kbuf);                                                  \
+		free(vbuf);                                                  \
+		return true;                                                 \
+	}
+
+DEFINE_RADIX_SORT(radix_sort32, uint32_t)
+DEFINE_RADIX_SORT(radix_sort64, uint64_t)
+
+/**
+ * @brief Maps an int to an unsigned key with the same order.
+ */
+static uint32_t int_key(int i)
+{
+	return (uint32_t) i ^ 0x80000000U;
+}
+
+/**
+ * @brief Inverse of util_double_totalKey().
+ */
+static double key_double(uint64_t key)
+{
+	uint64_t bits = key ^ (((key >> 63) - 1) | 0x8000000000000000ULL);
+	double d;
+	memcpy(&d, &bits, sizeof(d));
+
+	return d;
+}
+
+/**
+ * @brief Maps a char to an unsigned key with the same order, whether char is signed or not.
+ */
+static uint32_t char_key(char c)
+{
+	return (uint32_t) (c - CHAR_MIN);
+}
+
+static void sort_ints(int *a, size_t n)
+{
+#ifdef __AVX2__
+	if (n <= UTIL_SMALL_SORT_MAX) {
+		network_sort_ints(a, n);
+		return;
+	}
+#endif
+
+	/* If the buffers cannot be allocated, fall back to the introsort, which needs no memory */
+	if (n < RADIX_THRESHOLD || util_int_radixSort(a, NULL, n) != E_SUCCESS) {
+		introsort_int_sort(a, n);
+	}
+}
+
+/**
+ * @brief Sorts doubles by their totalOrder keys, which is also a valid order for util_double_cmp().
+ * If the radix sort cannot be used, arrays are sorted by value, or by key if total is true:
+ * NaNs must then be ordered too.
+ */
+static void sort_doubles(double *a, size_t n, bool total)
+{
+#ifdef __AVX2__
+	if (n <= UTIL_SMALL_SORT_MAX) {
+		network_sort_doubles(a, n);
+		return;
+	}
+#endif
+
+	if (n >= RADIX_THRESHOLD && util_double_radixSort(a, NULL, n) == E_SUCCESS) {
+		return;
+	}
+
+	if (total) {
+		introsort_total_sort(a, n);
+	} else {
+		introsort_double_sort(a, n);
+	}
+}
+
+/**
+ * @brief Moves the NULL elements to the front of the array.
+ *
+ * @return Number of NULL elements.
+ */
+static size_t partition_nulls(void **elems, size_t n)
+{
+	size_t nulls = 0;
+
+	for (size_t i = 0; i < n; i++) {
+		if (!elems[i]) {
+			elems[i]       = elems[nulls];
+			elems[nulls++] = NULL;
+		}
+	}
+
+	return nulls;
+}
+
+/**
+ * @brief Radix sort of pointers to ints, chars or doubles. The keys are read once.
+ *
+ * @return false if the buffers could not be allocated.
+ */
+static bool radix_sort_ptrs(void **elems, size_t n, util_compare cmp)
+{
+	bool sorted = false;
+
+	if (cmp == util_double_cmp || cmp == util_double_totalCmp) {
+		uint64_t *keys = malloc(n * sizeof(uint64_t));
+		if (keys) {
+			for (size_t i = 0; i < n; i++) {
+				keys[i] = util_double_totalKey(*(const double *) elems[i]);
+			}
+			sorted = radix_sort64(keys, elems, n);
+		}
+		free(keys);
+	} else {
+		uint32_t *keys = malloc(n * sizeof(uint32_t));
+		if (keys) {
+			for (size_t i = 0; i < n; i++) {
+				keys[i] = cmp == util_int_cmp ? int_key(*(const int *) elems[i]) : char_key(*(const char *) elems[i]);
+			}
+			sorted = radix_sort32(keys, elems, n);
+		}
+		free(keys);
+	}
+
+	return sorted;
+}
+
+/* !SECTION */
+/* SECTION - Sorting functions */
+
+void util_sort(void *base, size_t n, size_t size, util_compare cmp)
+{
+	claim((base != NULL || n == 0) && size > 0 && cmp != NULL);
+
+	if (n < 2) {
+		return;
+	}
+
+	if (cmp == util_int_cmp && size == sizeof(int)) {
+		sort_ints(base, n);
+	} else if ((cmp == util_double_cmp || cmp == util_double_totalCmp) && size == sizeof(double)) {
+		sort_doubles(base, n, cmp == util_double_totalCmp);
+	} else if (cmp == util_char_cmp && size == sizeof(char)) {
+		util_char_radixSort(base, NULL, n);
+	} else {
+		generic_introsort(base, n, size, cmp, util_sort_depthLimit(n));
+	}
+}
+
+void util_sortPtrs(void **elems, size_t n, util_compare cmp)
+{
+	claim((elems != NULL || n == 0) && cmp != NULL);
+
+	if (n < 2) {
+		return;
+	}
+
+	if (cmp == util_string_cmp) {
+		size_t nulls = partition_nulls(elems, n);
+		multikey_quicksort((char **) elems + nulls, n - nulls, 0);
+		return;
+	}
+
+	if (cmp == util_int_cmp || cmp == util_double_cmp || cmp == util_double_totalCmp || cmp == util_char_cmp) {
+		size_t nulls = partition_nulls(elems, n);
+
+		/* If the buffers cannot be allocated, fall back to the introsort, which needs no memory */
+		if (n - nulls >= RADIX_THRESHOLD && radix_sort_ptrs(elems + nulls, n - nulls, cmp)) {
+			return;
+		}
+		introsort_ptr_sort(elems + nulls, n - nulls, cmp);
+		return;
+	}
+
+	introsort_ptr_sort(elems, n, cmp);
+}
+
+/* !SECTION */
+/* SECTION - Radix sorting functions */
+
+ErrStatus util_int_radixSort(int *keys, void **payloads, size_t n)
+{
+	claim(keys != NULL || n == 0);
+
+	if (n < 2) {
+		return E_SUCCESS;
+	}
+
+	/* Without payloads, the order of equal keys cannot be told, and small arrays are sorted by comparison */
+	if (!payloads && n <= UTIL_SMALL_SORT_MAX) {
+		sort_ints(keys, n);
+		return E_SUCCESS;
+	}
+
+	/* The keys are computed in place: int and uint32_t may alias each other */
+	uint32_t *ukeys = (uint32_t *) keys;
+	for (size_t i = 0; i < n; i++) {
+		ukeys[i] ^= 0x80000000U;
+	}
+
+	bool sorted = radix_sort32(ukeys, payloads, n);
+
+	for (size_t i = 0; i < n; i++) {
+		ukeys[i] ^= 0x80000000U;
+	}
+
+	return sorted ? E_SUCCESS : E_OUT_OF_MEMORY;
+}
+
+ErrStatus util_unsigned_radixSort(unsigned *keys, void **payloads, size_t n)
+{
+	claim(keys != NULL || n == 0);
+
+	if (n < 2) {
+		return E_SUCCESS;
+	}
+
+	return radix_sort32((uint32_t *) keys, payloads, n) ? E_SUCCESS : E_OUT_OF_MEMORY;
+}
+
+ErrStatus util_double_radixSort(double *keys, void **payloads, size_t n)
+{
+	claim(keys != NULL || n == 0);
+
+	if (n < 2) {
+		return E_SUCCESS;
+	}
+
+	if (!payloads && n <= UTIL_SMALL_SORT_MAX) {
+		sort_doubles(keys, n, true);
+		return E_SUCCESS;
+	}
+
+	uint64_t *ukeys = malloc(n * sizeof(uint64_t));
+	if (!ukeys) {
+		return E_OUT_OF_MEMORY;
+	}
+
+	for (size_t i = 0; i < n; i++) {
+		ukeys[i] = util_double_totalKey(keys[i]);
+	}
+
+	bool sorted = radix_sort64(ukeys, payloads, n);
+	if (sorted) {
+		for (size_t i = 0; i < n; i++) {
+			keys[i] = key_double(ukeys[i]);
+		}
+	}
+
+	free(ukeys);
+	return sorted ? E_SUCCESS : E_OUT_OF_MEMORY;
+}
+
+ErrStatus util_char_radixSort(char *keys, void **payloads, size_t n)
+{
+	claim(keys != NULL || n == 0);
+
+	if (n < 2) {
+		return E_SUCCESS;
+	}
+
+	/* Without payloads, counting the chars is enough */
+	if (!payloads) {
+		size_t count[RADIX_BUCKETS] = {0};
+
+		for (size_t i = 0; i < n; i++) {
+			count[char_key(keys[i])]++;
+		}
+		for (size_t k = 0; k < RADIX_BUCKETS; k++) {
+			memset(keys, (int) k + CHAR_MIN, count[k]);
+			keys += count[k];
+		}
+
+		return E_SUCCESS;
+	}
+
+	uint32_t *ukeys = malloc(n * sizeof(uint32_t));
+	if (!ukeys) {
+		return E_OUT_OF_MEMORY;
+	}
+
+	for (size_t i = 0; i < n; i++) {
+		ukeys[i] = char_key(keys[i]);
+	}
+
+	bool sorted = radix_sort32(ukeys, payloads, n);
+	if (sorted) {
+		for (size_t i = 0; i < n; i++) {
+			keys[i] = (char) ((int) ukeys[i] + CHAR_MIN);
+		}
+	}
+
+	free(ukeys);
+	return sorted ? E_SUCCESS : E_OUT_OF_MEMORY;
+}
+
+/* !SECTION */
+/* SECTION - Parallel sort */
+
+/**
+ * @brief Part of a parallel sort run by one thread: sorting a chunk in place if dst is NULL,
+ * or merging the sorted ranges a and b into dst otherwise.
+ */
+typedef struct {
+	char *a;   /**< Chunk to sort, or first range to merge */
+	size_t na; /**< Number of elements of a */
+	char *b;   /**< Second range to merge */
+	size_t nb; /**< Number of elements of b */
+	char *dst; /**< Destination of the merge, or NULL */
+} SortTask;
+
+/**
+ * @brief Tasks shared by the threads of a parallel sort, which take them in order.
+ */
+typedef struct {
+	SortTask *tasks;
+	size_t count;
+	size_t next; /**< Index of the next task to take, updated atomically */
+	size_t size;
+	util_compare cmp;
+} TaskQueue;
+
+/**
+ * @brief Merges two sorted ranges, taking from a on ties.
+ */
+static void merge_ranges(const char *a, size_t na, const char *b, size_t nb, char *dst, size_t size, util_compare cmp)
+{
+	const char *a_end = a + na * size;
+	const char *b_end = b + nb * size;
+
+	while (a < a_end && b < b_end) {
+		if (cmp(b, a) < 0) {
+			memcpy(dst, b, size);
+			b += size;
+		} else {
+			memcpy(dst, a, size);
+			a += size;
+		}
+		dst += size;
+	}
+
+	/* One of the ranges is exhausted */
+	if (a < a_end) {
+		memcpy(dst, a, (size_t) (a_end - a));
+	} else if (b < b_end) {
+		memcpy(dst, b, (size_t) (b_end - b));
+	}
+}
+
+/**
+ * @brief Number of elements of a among the first k elements of the merge of a and b, found by
+ * binary search, so that a merge can be split into independent parts.
+ */
+static size_t merge_split(const char *a, size_t na, const char *b, size_t nb, size_t k, size_t size, util_compare cmp)
+{
+	size_t lo = k > nb ? k - nb : 0;
+	size_t hi = k < na ? k : na;
+
+	while (lo < hi) {
+		size_t i = lo + (hi - lo) / 2;
+		size_t j = k - i;
+
+		if (i > 0 && j < nb && cmp(b + j * size, a + (i - 1) * size) < 0) {
+			hi = i - 1; // a[i - 1] goes after b[j]
+		} else if (j > 0 && i < na && cmp(b + (j - 1) * size, a + i * size) >= 0) {
+			lo = i + 1; // a[i] goes before b[j - 1]
+		} else {
+			return i;
+		}
+	}
+
+	return lo;
+}
+
+static void *run_tasks(void *arg)
+{
+	TaskQueue *queue = arg;
+	size_t i;
+
+	while ((i = __atomic_fetch_add(&queue->next, 1, __ATOMIC_RELAXED)) < queue->count) {
+		SortTask *task = &queue->tasks[i];
+
+		if (task->dst) {
+			merge_ranges(task->a, task->na, task->b, task->nb, task->dst, queue->size, queue->cmp);
+		} else {
+			util_sort(task->a, task->na, queue->size, queue->cmp);
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Runs the tasks of a queue on up to threads threads, including the calling one.
+ * If threads cannot be created, the others run their tasks.
+ */
+static void run_parallel(TaskQueue *queue, pthread_t *ids, unsigned threads)
+{
+	unsigned started = 0;
+
+	queue->next = 0;
+	while (started + 1 < threads && started + 1 < queue->count && pthread_create(&ids[started], NULL, run_tasks, queue) == 0) {
+		started++;
+	}
+
+	run_tasks(queue);
+
+	for (unsigned t = 0; t < started; t++) {
+		pthread_join(ids[t], NULL);
+	}
+}
+
+void util_parallelSort(void *base, size_t n, size_t size, util_compare cmp, unsigned threads, size_t cutoff)
+{
+	claim((base != NULL || n == 0) && size > 0 && cmp != NULL);
+
+	if (threads == 0) {
+		long online = sysconf(_SC_NPROCESSORS_ONLN);
+		threads     = online > 0 ? (unsigned) online : 1;
+	}
+	if (cutoff == 0) {
+		cutoff = UTIL_PARALLEL_SORT_CUTOFF;
+	}
+
+	/* Each thread sorts a chunk of at least cutoff elements */
+	size_t chunks = n / cutoff < threads ? n / cutoff : threads;
+	if (chunks < 2) {
+		util_sort(base, n, size, cmp);
+		return;
+	}
+
+	threads = (unsigned) chunks;
+
+	/* util_sort() orders doubles by util_double_totalCmp() for util_double_cmp() too, so the merges
+	 * must follow the total order, or NaNs would compare equal to every run they are merged with */
+	util_compare order = cmp == util_double_cmp ? util_double_totalCmp : cmp;
+
+	char *buf       = malloc(n * size);
+	size_t *bounds  = malloc((chunks + 1) * sizeof(size_t));
+	SortTask *tasks = malloc(2 * chunks * sizeof(SortTask));
+	pthread_t *ids  = malloc(threads * sizeof(pthread_t));
+	TaskQueue queue = {.tasks = tasks, .size = size, .cmp = order};
+
+	if (!buf || !bounds || !tasks || !ids) {
+		util_sort(base, n, size, cmp); // Sequential sort, which needs no memory
+		goto cleanup;
+	}
+
+	/* Sort the chunks */
+	for (size_t c = 0; c <= chunks; c++) {
+		bounds[c] = n / chunks * c + (c < n % chunks ? c : n % chunks);
+	}
+	for (size_t c = 0; c < chunks; c++) {
+		tasks[c] = (SortTask) {.a = (char *) base + bounds[c] * size, .na = bounds[c + 1] - bounds[c]};
+	}
+	queue.count = chunks;
+	run_parallel(&queue, ids, threads);
+
+	/* Merge pairs of runs until one is left, splitting each merge in parts for all the threads */
+	char *src = base;
+	char *dst = buf;
+	for (size_t runs = chunks; runs > 1; runs = (runs + 1) / 2) {
+		size_t pairs = runs / 2;
+		size_t parts = (chunks + pairs - 1) / pairs;
+		queue.count  = 0;
+
+		for (size_t r = 0; r + 1 < runs; r += 2) {
+			size_t lo = bounds[r];
+			size_t na = bounds[r + 1] - lo;
+			size_t nb = bounds[r + 2] - bounds[r + 1];
+			char *a   = src + lo * size;
+			char *b   = a + na * size;
+			size_t i0 = 0;
+
+			for (size_t p = 1; p <= parts; p++) {
+				size_t k  = (na + nb) / parts * p + (p == parts ? (na + nb) % parts : 0);
+				size_t i1 = merge_split(a, na, b, nb, k, size, order);
+				size_t j0 = (na + nb) / parts * (p - 1) - i0;
+
+				tasks[queue.count++] = (SortTask) {
+					.a   = a + i0 * size,
+					.na  = i1 - i0,
+					.b   = b + j0 * size,
+					.nb  = k - i1 - j0,
+					.dst = dst + (lo + i0 + j0) * size,
+				};
+				i0 = i1;
+			}
+		}
+		if (runs % 2 == 1) {
+			size_t lo = bounds[runs - 1];
+			tasks[queue.count++] = (SortTask) {
+				.a   = src + lo * size,
+				.na  = n - lo,
+				.b   = src + n * size, // Empty range at the end of the array, rather than NULL
+				.dst = dst + lo * size,
+			};
+		}
+		run_parallel(&queue, ids, threads);
+
+		for (size_t r = 0; r < runs; r += 2) {
+			bounds[r / 2] = bounds[r];
+		}
+		bounds[(runs + 1) / 2] = n;
+
+		char *t = src;
+		src     = dst;
+		dst     = t;
+	}
+
+	if (src != base) {
+		memcpy(base, src, n * size);
+	}
+
+cleanup:
+	free(buf);
+	free(bounds);
+	free(tasks);
+	free(ids);
+}
+
+/* !SECTION */
+/* SECTION - Stable sort */
+
+/**
+ * @brief Runs shorter than the minimum run length, between MIN_MERGE / 2 and MIN_MERGE,
+ * are extended with binary insertion sort.
+ */
+#define MIN_MERGE 64
+
+/**
+ * @brief Number of consecutive elements taken from the same run during a merge
+ * before switching to a galloping search.
+ */
+#define MIN_GALLOP 7
+
+/**
+ * @brief Maximum number of pending runs. Their lengths grow at least as fast as the Fibonacci
+ * numbers from the top of the stack down, so this is enough for any array.
+ */
+#define MAX_RUNS 85
+
+/**
+ * @brief Range of sorted elements waiting to be merged.
+ */
+typedef struct {
+	size_t start;
+	size_t len;
+} Run;
+
+/**
+ * @brief State of a stable sort.
+ */
+typedef struct {
+	char *base;
+	size_t size;
+	util_compare cmp;
+	char *buf; /**< Buffer of n / 2 + 1 elements, for merges and insertions */
+	Run runs[MAX_RUNS];
+	size_t count; /**< Number of pending runs */
+	SortStats stats;
+} StableSort;
+
+static int stable_cmp(StableSort *s, const void *e1, const void *e2)
+{
+	s->stats.comparisons++;
+	return s->cmp(e1, e2);
+}
+
+/**
+ * @brief Minimum run length for an array of n elements, chosen so that n / minrun is a power of 2
+ * or slightly less, which keeps merges balanced.
+ */
+static size_t min_run_length(size_t n)
+{
+	size_t r = 0;
+
+	while (n >= MIN_MERGE) {
+		r |= n & 1;
+		n >>= 1;
+	}
+
+	return n + r;
+}
+
+/**
+ * @brief Returns the length of the run starting at a, among n > 0 elements,
+ * reversing it if it is strictly descending, which keeps the sort stable.
+ */
+static size_t count_run(StableSort *s, char *a, size_t n)
+{
+	size_t size = s->size;
+	size_t len  = 2;
+
+	if (n == 1) {
+		return 1;
+	}
+
+	if (stable_cmp(s, a + size, a) < 0) {
+		while (len < n && stable_cmp(s, a + len * size, a + (len - 1) * size) < 0) {
+			len++;
+		}
+		for (char *lo = a, *hi = a + (len - 1) * size; lo < hi; lo += size, hi -= size) {
+			swap_elems(lo, hi, size);
+		}
+	} else {
+		while (len < n && stable_cmp(s, a + len * size, a + (len - 1) * size) >= 0) {
+			len++;
+		}
+	}
+
+	return len;
+}
+
+/**
+ * @brief Sorts a[0, n), whose first sorted elements are already sorted, by inserting each of
+ * the others after the last element that does not go after it.
+ */
+static void binary_insertion(StableSort *s, char *a, size_t n, size_t sorted)
+{
+	size_t size = s->size;
+
+	for (size_t i = sorted; i < n; i++) {
+		char *x   = a + i * size;
+		size_t lo = 0;
+		size_t hi = i;
+
+		while (lo < hi) {
+			size_t mid = lo + (hi - lo) / 2;
+			if (stable_cmp(s, x, a + mid * size) < 0) {
+				hi = mid;
+			} else {
+				lo = mid + 1;
+			}
+		}
+
+		if (lo < i) {
+			memcpy(s->buf, x, size);
+			memmove(a + (lo + 1) * size, a + lo * size, (i - lo) * size);
+			memcpy(a + lo * size, s->buf, size);
+		}
+	}
+}
+
+/**
+ * @brief Returns the number of elements of the sorted range a[0, n) that go before key,
+ * or that do not go after it if right is true.
+ *
+ * @details The search probes 1, 2, 4... elements from the start of the range, or from its end if
+ * from_end is true, and then finishes with a binary search, so it takes O(log k) comparisons
+ * where k is the distance of the result from that end.
+ */
+static size_t gallop(StableSort *s, const char *key, const char *a, size_t n, bool right, bool from_end)
+{
+	size_t size = s->size;
+	size_t lo   = 0; // The result is in [lo, hi]
+	size_t hi   = n;
+	size_t step = 1;
+
+#define IN_PREFIX(i) (right ? stable_cmp(s, a + (i) * size, key) <= 0 : stable_cmp(s, a + (i) * size, key) < 0)
+
+	if (!from_end) {
+		while (step <= n && IN_PREFIX(step - 1)) {
+			lo = step;
+			step *= 2;
+		}
+		if (step <= n) {
+			hi = step - 1;
+		}
+	} else {
+		while (step <= n && !IN_PREFIX(n - step)) {
+			hi = n - step;
+			step *= 2;
+		}
+		if (step <= n) {
+			lo = n - step + 1;
+		}
+	}
+
+	while (lo < hi) {
+		size_t mid = lo + (hi - lo) / 2;
+		if (IN_PREFIX(mid)) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+
+#undef IN_PREFIX
+
+	return lo;
+}
+
+/**
+ * @brief Merges the adjacent runs a[0, len1) and b[0, len2) with len1 <= len2, from the left.
+ *
+ * @details a is moved to the buffer, and ties take from it, as it comes first.
+ * After MIN_GALLOP consecutive elements from the same run, the elements that follow from
+ * that run are found with a galloping search and moved at once.
+ */
+static void merge_lo(StableSort *s, char *a, size_t len1, char *b, size_t len2)
+{
+	size_t size       = s->size;
+	const char *p     = s->buf;
+	const char *p_end = s->buf + len1 * size;
+	const char *q     = b;
+	const char *q_end = b + len2 * size;
+	char *dst         = a;
+	size_t wins_p     = 0;
+	size_t wins_q     = 0;
+
+	memcpy(s->buf, a, len1 * size);
+
+	while (p < p_end && q < q_end) {
+		if (wins_p >= MIN_GALLOP) {
+			size_t k = gallop(s, q, p, (size_t) (p_end - p) / size, true, false);
+			memcpy(dst, p, k * size);
+			dst += k * size;
+			p += k * size;
+			wins_p = 0;
+		} else if (wins_q >= MIN_GALLOP) {
+			size_t k = gallop(s, p, q, (size_t) (q_end - q) / size, false, false);
+			memmove(dst, q, k * size);
+			dst += k * size;
+			q += k * size;
+			wins_q = 0;
+		} else if (stable_cmp(s, q, p) < 0) {
+			memcpy(dst, q, size);
+			dst += size;
+			q += size;
+			wins_q++;
+			wins_p = 0;
+		} else {
+			memcpy(dst, p, size);
+			dst += size;
+			p += size;
+			wins_p++;
+			wins_q = 0;
+		}
+	}
+
+	/* The rest of b is already in place */
+	if (p < p_end) {
+		memcpy(dst, p, (size_t) (p_end - p));
+	}
+}
+
+/**
+ * @brief Merges the adjacent runs a[0, len1) and b[0, len2) with len1 > len2, from the right.
+ *
+ * @details b is moved to the buffer, and ties take from it, as it comes last.
+ */
+static void merge_hi(StableSort *s, char *a, size_t len1, char *b, size_t len2)
+{
+	size_t size   = s->size;
+	size_t np     = len1; // Elements of a left
+	size_t nq     = len2; // Elements of the buffer left
+	char *buf     = s->buf;
+	size_t wins_p = 0;
+	size_t wins_q = 0;
+
+	memcpy(buf, b, len2 * size);
+
+	while (np > 0 && nq > 0) {
+		char *dst = a + (np + nq) * size;
+
+		if (wins_p >= MIN_GALLOP) {
+			size_t k = np - gallop(s, buf + (nq - 1) * size, a, np, true, true);
+			memmove(dst - k * size, a + (np - k) * size, k * size);
+			np -= k;
+			wins_p = 0;
+		} else if (wins_q >= MIN_GALLOP) {
+			size_t k = nq - gallop(s, a + (np - 1) * size, buf, nq, false, true);
+			memcpy(dst - k * size, buf + (nq - k) * size, k * size);
+			nq -= k;
+			wins_q = 0;
+		} else if (stable_cmp(s, buf + (nq - 1) * size, a + (np - 1) * size) < 0) {
+			memcpy(dst - size, a + (np - 1) * size, size);
+			np--;
+			wins_p++;
+			wins_q = 0;
+		} else {
+			memcpy(dst - size, buf + (nq - 1) * size, size);
+			nq--;
+			wins_q++;
+			wins_p = 0;
+		}
+	}
+
+	/* The rest of a is already in place */
+	if (nq > 0) {
+		memcpy(a, buf, nq * size);
+	}
+}
+
+/**
+ * @brief Merges the pending runs i and i + 1, which must be the last two or the two before the last one.
+ */
+static void merge_at(StableSort *s, size_t i)
+{
+	size_t size = s->size;
+	char *a     = s->base + s->runs[i].start * size;
+	size_t len1 = s->runs[i].len;
+	char *b     = s->base + s->runs[i + 1].start * size;
+	size_t len2 = s->runs[i + 1].len;
+
+	s->runs[i].len += len2;
+	if (i + 3 == s->count) {
+		s->runs[i + 1] = s->runs[i + 2];
+	}
+	s->count--;
+	s->stats.merges++;
+
+	/* Elements of a that do not go after b[0], and of b that go after the last of a, are in place */
+	size_t k = gallop(s, b, a, len1, true, false);
+	a += k * size;
+	len1 -= k;
+	if (len1 == 0) {
+		return;
+	}
+
+	len2 = gallop(s, a + (len1 - 1) * size, b, len2, false, true);
+	if (len2 == 0) {
+		return;
+	}
+
+	if (len1 <= len2) {
+		merge_lo(s, a, len1, b, len2);
+	} else {
+		merge_hi(s, a, len1, b, len2);
+	}
+}
+
+/**
+ * @brief Merges pending runs until, from the top of the stack, each run is longer than the sum
+ * of the next two and longer than the next one, which keeps merges balanced and the stack short.
+ */
+static void merge_collapse(StableSort *s)
+{
+	while (s->count > 1) {
+		size_t i = s->count - 2;
+		Run *r   = s->runs;
+
+		if ((i >= 1 && r[i - 1].len <= r[i].len + r[i + 1].len) ||
+			(i >= 2 && r[i - 2].len <= r[i - 1].len + r[i].len)) {
+			if (r[i - 1].len < r[i + 1].len) {
+				i--;
+			}
+		} else if (r[i].len > r[i + 1].len) {
+			break;
+		}
+		merge_at(s, i);
+	}
+}
+
+ErrStatus util_stableSort(void *base, size_t n, size_t size, util_compare cmp, SortStats *stats)
+{
+	claim((base != NULL || n == 0) && size > 0 && cmp != NULL);
+
+	StableSort s = {.base = base, .size = size, .cmp = cmp};
+
+	if (n > 1) {
+		s.buf = malloc((n / 2 + 1) * size);
+		if (!s.buf) {
+			return E_OUT_OF_MEMORY;
+		}
+
+		size_t min_run = min_run_length(n);
+		for (size_t lo = 0; lo < n;) {
+			size_t len = count_run(&s, s.base + lo * size, n - lo);
+			s.stats.runs++;
+
+			if (len < min_run) {
+				size_t forced = n - lo < min_run ? n - lo : min_run;
+				binary_insertion(&s, s.base + lo * size, forced, len);
+				len = forced;
+			}
+
+			s.runs[s.count++] = (Run) {.start = lo, .len = len};
+			merge_collapse(&s);
+			lo += len;
+		}
+
+		while (s.count > 1) {
+			size_t i = s.count - 2;
+			if (i > 0 && s.runs[i - 1].len < s.runs[i + 1].len) {
+				i--;
+			}
+			merge_at(&s, i);
+		}
+
+		free(s.buf);
+	}
+
+	if (stats) {
+		*stats = s.stats;
+	}
+
+	return E_SUCCESS;
+}
+
+/* !SECTION */
+/* SECTION - Small array sorting */
+
+void util_int_smallSort(int *a, size_t n)
+{
+	claim(a != NULL || n == 0);
+
+	if (n > UTIL_SMALL_SORT_MAX) {
+		sort_ints(a, n);
+	} else if (n > 1) {
+		network_sort_ints(a, n);
+	}
+}
+
+void util_double_smallSort(double *a, size_t n)
+{
+	claim(a != NULL || n == 0);
+
+	if (n > UTIL_SMALL_SORT_MAX) {
+		sort_doubles(a, n, true);
+	} else if (n > 1) {
+		network_sort_doubles(a, n);
+	}
+}
+
+/* !SECTION */
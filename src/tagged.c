@@ -0,0 +1,273 @@
+/**
+ * @brief Tagged immediate values: chars, ints and doubles stored inline in a `void *`.
+ *
+ * @file tagged.c
+ */
+
+#include "tagged.h"
+
+#include "dbg.h"
+#include "macros.h"
+#include "utilities.h"
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+_Static_assert(sizeof(void *) == sizeof(uint64_t), "Tagged values require 64-bit pointers");
+
+/**
+ * @brief Mask of the top 16 bits of a value, which hold the tag of chars and ints.
+ */
+#define TAG_MASK 0xFFFF000000000000ULL
+
+/**
+ * @brief Tag of chars.
+ */
+#define TAG_CHAR 0x0001000000000000ULL
+
+/**
+ * @brief Tag of ints.
+ */
+#define TAG_INT 0xFFFF000000000000ULL
+
+/**
+ * @brief Offset added to the bits of doubles. Once all NaNs are canonicalized,
+ * the top 16 bits of a double are at most 0xFFF0, so encoded doubles never collide with the tags.
+ */
+#define DOUBLE_OFFSET (1ULL << 49)
+
+/**
+ * @brief Bits of the quiet NaN that represents all NaNs.
+ */
+#define CANONICAL_NAN 0x7FF8000000000000ULL
+
+/* SECTION - Encoding */
+
+static uint64_t bits_of(const void *v)
+{
+	return (uint64_t) (uintptr_t) v;
+}
+
+static void *from_bits(uint64_t bits)
+{
+	return (void *) (uintptr_t) bits;
+}
+
+void *util_tagged_fromChar(char c)
+{
+	return from_bits(TAG_CHAR | (unsigned char) c);
+}
+
+void *util_tagged_fromInt(int i)
+{
+	return from_bits(TAG_INT | (uint32_t) i);
+}
+
+void *util_tagged_fromDouble(double d)
+{
+	uint64_t bits = CANONICAL_NAN;
+
+	if (d == d) {
+		memcpy(&bits, &d, sizeof(bits));
+	}
+
+	return from_bits(bits + DOUBLE_OFFSET);
+}
+
+bool util_tagged_isChar(const void *v)
+{
+	return (bits_of(v) & TAG_MASK) == TAG_CHAR;
+}
+
+bool util_tagged_isInt(const void *v)
+{
+	return (bits_of(v) & TAG_MASK) == TAG_INT;
+}
+
+bool util_tagged_isDouble(const void *v)
+{
+	uint64_t tag = bits_of(v) & TAG_MASK;
+
+	return tag != 0 && tag != TAG_CHAR && tag != TAG_INT;
+}
+
+char util_tagged_char(const void *v)
+{
+	claim(util_tagged_isChar(v));
+
+	return (char) (unsigned char) bits_of(v);
+}
+
+int util_tagged_int(const void *v)
+{
+	claim(util_tagged_isInt(v));
+
+	return (int) (uint32_t) bits_of(v);
+}
+
+double util_tagged_double(const void *v)
+{
+	if (util_tagged_isInt(v)) {
+		return util_tagged_int(v);
+	}
+
+	claim(util_tagged_isDouble(v));
+
+	uint64_t bits = bits_of(v) - DOUBLE_OFFSET;
+	double d;
+	memcpy(&d, &bits, sizeof(d));
+
+	return d;
+}
+
+/* !SECTION */
+/* SECTION - Element functions */
+
+int util_tagged_print(FILE *file, const void *v)
+{
+	claim(file != NULL);
+
+	if (!v) {
+		return fprintf(file, "%s ", DEF_NULL);
+	}
+
+	if (util_tagged_isChar(v)) {
+		char c = util_tagged_char(v);
+		return util_char_print(file, &c);
+	}
+
+	if (util_tagged_isInt(v)) {
+		int i = util_tagged_int(v);
+		return util_int_print(file, &i);
+	}
+
+	double d = util_tagged_double(v);
+	return util_double_print(file, &d);
+}
+
+int util_tagged_cmp(const void *v1, const void *v2)
+{
+	if (!v1 || !v2) {
+		return (!v1 < !v2) - (!v1 > !v2);
+	}
+
+	bool c1 = util_tagged_isChar(v1);
+	bool c2 = util_tagged_isChar(v2);
+
+	if (c1 && c2) {
+		return util_tagged_char(v1) - util_tagged_char(v2);
+	}
+	if (c1 || c2) {
+		return c2 - c1;
+	}
+
+	if (util_tagged_isInt(v1) && util_tagged_isInt(v2)) {
+		int i1 = util_tagged_int(v1);
+		int i2 = util_tagged_int(v2);
+		return (i1 > i2) - (i1 < i2);
+	}
+
+	/* Every int is exactly representable as a double */
+	double d1 = util_tagged_double(v1);
+	double d2 = util_tagged_double(v2);
+
+	/* NaN is ordered after every number, and equal only to itself */
+	bool nan1 = d1 != d1;
+	bool nan2 = d2 != d2;
+	if (nan1 || nan2) {
+		return nan1 - nan2;
+	}
+
+	return (d1 > d2) - (d1 < d2);
+}
+
+bool util_tagged_equal(const void *v1, const void *v2)
+{
+	return util_tagged_cmp(v1, v2) == 0;
+}
+
+char *util_tagged_toString(const void *v)
+{
+	if (!v) {
+		return NULL;
+	}
+
+	if (util_tagged_isChar(v)) {
+		char c = util_tagged_char(v);
+		return util_char_toString(&c);
+	}
+
+	if (util_tagged_isInt(v)) {
+		int i = util_tagged_int(v);
+		return util_int_toString(&i);
+	}
+
+	double d = util_tagged_double(v);
+	return util_double_toString(&d);
+}
+
+int util_tagged_toBuffer(char *buf, size_t size, const void *v)
+{
+	if (!v) {
+		return -1;
+	}
+
+	if (util_tagged_isChar(v)) {
+		char c = util_tagged_char(v);
+		return util_char_toBuffer(buf, size, &c);
+	}
+
+	if (util_tagged_isInt(v)) {
+		int i = util_tagged_int(v);
+		return util_int_toBuffer(buf, size, &i);
+	}
+
+	double d = util_tagged_double(v);
+	return util_double_toBuffer(buf, size, &d);
+}
+
+void *util_tagged_charFromString(const char *str)
+{
+	claim(str != NULL);
+
+	return util_tagged_fromChar(*str);
+}
+
+void *util_tagged_intFromString(const char *str)
+{
+	claim(str != NULL);
+
+	int i;
+	ErrStatus status = util_int_tryFromString(str, &i, NULL);
+
+	if (status != E_SUCCESS) {
+		errno = status == E_OUT_OF_RANGE ? ERANGE : 0;
+		return NULL;
+	}
+
+	return util_tagged_fromInt(i);
+}
+
+void *util_tagged_doubleFromString(const char *str)
+{
+	claim(str != NULL);
+
+	double d;
+	ErrStatus status = util_double_tryFromString(str, &d, NULL);
+
+	if (status != E_SUCCESS) {
+		errno = status == E_OUT_OF_RANGE ? ERANGE : 0;
+		return NULL;
+	}
+
+	return util_tagged_fromDouble(d);
+}
+
+void util_tagged_free(void *v)
+{
+	(void) v;
+}
+
+/* !SECTION */
@@ -8,7 +8,10 @@
 #include "utilities.h"
 
 #include "dbg.h"
+#include "format.h"
+#include "hash.h"
 #include "macros.h"
+#include "parse.h"
 
 #include <float.h>
 #include <inttypes.h>
@@ -18,6 +21,35 @@
 #include <stdlib.h>
 #include <string.h>
 
+#if defined(__AVX2__)
+	#include <immintrin.h>
+	#define STRING_VEC_SIZE 32
+#elif defined(__SSE2__)
+	#include <emmintrin.h>
+	#define STRING_VEC_SIZE 16
+#endif
+
+/**
+ * @brief Smallest page size of the supported targets. A vector load that does not cross a
+ * boundary of this size cannot fault if its first byte is readable.
+ */
+#define STRING_PAGE_SIZE 4096
+
+/**
+ * @brief Disables AddressSanitizer in functions that read past the end of strings on purpose,
+ * within the page of their last character.
+ */
+#if defined(__SANITIZE_ADDRESS__)
+	#define NO_SANITIZE_ADDRESS __attribute__((no_sanitize_address))
+#elif defined(__has_feature)
+	#if __has_feature(address_sanitizer)
+		#define NO_SANITIZE_ADDRESS __attribute__((no_sanitize_address))
+	#endif
+#endif
+#ifndef NO_SANITIZE_ADDRESS
+	#define NO_SANITIZE_ADDRESS
+#endif
+
 /**
  * @brief Maximum length of a string containing a pointer.
  */
@@ -25,16 +57,15 @@
 
 /**
  * @brief Maximum length of a string containing a double.
- * Only the digits of precision are taken.
- * @details Since we are representing the double using the %g format specifier,
- * the number of characters is the sum of:
+ * @details Since we are representing the double with the shortest round-trip digits
+ * in the layout of the %g format specifier, the number of characters is the sum of:
  * * 1 for the sign if the number is negative
- * * DBL_DIG digits
+ * * DBL_DECIMAL_DIG digits
  * * 1 dot
  * * 2 characters for exponent notation
  * * Number of digits of the exponent
  */
-#define MAX_DOUB_LEN (1 + DBL_DIG + 1 + 2 + (int) ceil(log10(DBL_MAX_10_EXP)))
+#define MAX_DOUB_LEN (1 + DBL_DECIMAL_DIG + 1 + 2 + (int) ceil(log10(DBL_MAX_10_EXP)))
 
 /**
  * @brief Maximum length of a string containing a signed long.
@@ -51,6 +82,25 @@
  */
 #define MAX_INT_LEN (1 + (int) ceil(log10(INT_MAX)))
 
+/* SECTION - Helpers */
+
+/**
+ * @brief Copies a string of the given length to a buffer, following the truncation rules of snprintf().
+ *
+ * @return The length of the string.
+ */
+static int copy_truncated(char *buf, size_t size, const char *str, size_t len)
+{
+	if (size > 0) {
+		size_t n = len < size ? len : size - 1;
+		memcpy(buf, str, n);
+		buf[n] = '\0';
+	}
+
+	return (int) len;
+}
+
+/* !SECTION */
 /* SECTION - Printing functions */
 
 int util_generic_print(FILE *file, const void *p)
@@ -87,7 +137,11 @@ int util_int_print(FILE *file, const void *i)
 		return fprintf(file, "%s ", DEF_NULL);
 	}
 
-	return fprintf(file, "%d ", *(const int *) i);
+	char buf[UTIL_FORMAT_BUFSIZE];
+	size_t len = util_formatInt(buf, *(const int *) i);
+	buf[len++] = ' ';
+
+	return fwrite(buf, sizeof(char), len, file) == len ? (int) len : -1;
 }
 
 int util_double_print(FILE *file, const void *d)
@@ -98,7 +152,10 @@ int util_double_print(FILE *file, const void *d)
 		return fprintf(file, "%s ", DEF_NULL);
 	}
 
-	return fprintf(file, "%.*g", DBL_DIG, *(const double *) d);
+	char buf[UTIL_FORMAT_BUFSIZE];
+	size_t len = util_formatDouble(buf, *(const double *) d);
+
+	return fwrite(buf, sizeof(char), len, file) == len ? (int) len : -1;
 }
 
 int util_string_print(FILE *file, const void *s)
@@ -112,6 +169,94 @@ int util_string_print(FILE *file, const void *s)
 	return fprintf(file, "%s ", (const char *) s);
 }
 
+/* !SECTION */
+/* SECTION - String kernels */
+
+#ifdef STRING_VEC_SIZE
+
+/**
+ * @brief Whether a vector load at s1 or s2 could cross into the next page.
+ */
+static inline bool near_page_end(const char *s1, const char *s2)
+{
+	uintptr_t limit = STRING_PAGE_SIZE - STRING_VEC_SIZE;
+
+	return (((uintptr_t) s1 & (STRING_PAGE_SIZE - 1)) > limit) | (((uintptr_t) s2 & (STRING_PAGE_SIZE - 1)) > limit);
+}
+
+/**
+ * @brief Bitmask of the positions of the next STRING_VEC_SIZE bytes where the strings differ or
+ * where s1 ends. Neither load may cross a page boundary.
+ */
+NO_SANITIZE_ADDRESS static inline uint32_t stop_mask(const char *s1, const char *s2)
+{
+	#if STRING_VEC_SIZE == 32
+	__m256i a    = _mm256_loadu_si256((const __m256i *) s1);
+	__m256i b    = _mm256_loadu_si256((const __m256i *) s2);
+	uint32_t eq  = (uint32_t) _mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b));
+	uint32_t nul = (uint32_t) _mm256_movemask_epi8(_mm256_cmpeq_epi8(a, _mm256_setzero_si256()));
+
+	return ~eq | nul;
+	#else
+	__m128i a    = _mm_loadu_si128((const __m128i *) s1);
+	__m128i b    = _mm_loadu_si128((const __m128i *) s2);
+	uint32_t eq  = (uint32_t) _mm_movemask_epi8(_mm_cmpeq_epi8(a, b));
+	uint32_t nul = (uint32_t) _mm_movemask_epi8(_mm_cmpeq_epi8(a, _mm_setzero_si128()));
+
+	return (~eq & 0xFFFF) | nul;
+	#endif
+}
+
+#endif
+
+/**
+ * @brief Compares two strings like strcmp(), starting with a single vector comparison.
+ *
+ * @details Short keys, the common case of hash tables and sorts, are compared with one load of
+ * each string and no call. The loads may read past the terminating null byte, but never into
+ * another page, so they cannot fault. Strings near a page boundary and the rest of longer strings
+ * are compared by strcmp(), whose implementation is selected at run time for the processor.
+ *
+ * @return The difference of the first differing characters as unsigned chars, or 0.
+ */
+NO_SANITIZE_ADDRESS static int string_compare(const char *s1, const char *s2)
+{
+#ifdef STRING_VEC_SIZE
+	if (!near_page_end(s1, s2)) {
+		uint32_t mask = stop_mask(s1, s2);
+		if (mask) {
+			int i = __builtin_ctz(mask);
+			return (unsigned char) s1[i] - (unsigned char) s2[i];
+		}
+		s1 += STRING_VEC_SIZE;
+		s2 += STRING_VEC_SIZE;
+	}
+#endif
+
+	return strcmp(s1, s2);
+}
+
+/**
+ * @brief Tests whether two strings are equal, with the same kernel as string_compare().
+ */
+NO_SANITIZE_ADDRESS static bool string_equal(const char *s1, const char *s2)
+{
+#ifdef STRING_VEC_SIZE
+	if (!near_page_end(s1, s2)) {
+		/* At the first stop, either both strings end or they differ */
+		uint32_t mask = stop_mask(s1, s2);
+		if (mask) {
+			int i = __builtin_ctz(mask);
+			return s1[i] == s2[i];
+		}
+		s1 += STRING_VEC_SIZE;
+		s2 += STRING_VEC_SIZE;
+	}
+#endif
+
+	return strcmp(s1, s2) == 0;
+}
+
 /* !SECTION */
 /* SECTION - Comparison functions */
 /* Rationale behind the null return values: We consider that null values should be ordered
@@ -157,13 +302,247 @@ int util_double_cmp(const void *double1, const void *double2)
 	return (d1 > d2) - (d1 < d2);
 }
 
+uint64_t util_double_totalKey(double d)
+{
+	uint64_t bits;
+	memcpy(&bits, &d, sizeof(bits));
+
+	return bits ^ ((uint64_t) ((int64_t) bits >> 63) | 0x8000000000000000ULL);
+}
+
+int util_double_totalCmp(const void *double1, const void *double2)
+{
+	if (!double1 || !double2) {
+		return (!double1 < !double2) - (!double1 > !double2);
+	}
+
+	uint64_t k1 = util_double_totalKey(*(const double *) double1);
+	uint64_t k2 = util_double_totalKey(*(const double *) double2);
+
+	return (k1 > k2) - (k1 < k2);
+}
+
+void util_double_totalCmpBatch(const double *doubles1, const double *doubles2, int *results, size_t n)
+{
+	claim((doubles1 && doubles2 && results) || n == 0);
+
+	for (size_t i = 0; i < n; i++) {
+		uint64_t k1 = util_double_totalKey(doubles1[i]);
+		uint64_t k2 = util_double_totalKey(doubles2[i]);
+		results[i]  = (k1 > k2) - (k1 < k2);
+	}
+}
+
 int util_string_cmp(const void *str1, const void *str2)
 {
 	if (!str1 || !str2) {
 		return (!str1 < !str2) - (!str1 > !str2);
 	}
 
-	return strcmp((const char *) str1, (const char *) str2);
+	if (str1 == str2) {
+		return 0; // Interned strings
+	}
+
+	return string_compare(str1, str2);
+}
+
+/* !SECTION */
+/* SECTION - Equality functions */
+
+bool util_char_equal(const void *char1, const void *char2)
+{
+	if (!char1 || !char2) {
+		return char1 == char2;
+	}
+
+	return *(const char *) char1 == *(const char *) char2;
+}
+
+bool util_int_equal(const void *int1, const void *int2)
+{
+	if (!int1 || !int2) {
+		return int1 == int2;
+	}
+
+	return *(const int *) int1 == *(const int *) int2;
+}
+
+/**
+ * @brief Bits of a double, with -0.0 folded into 0.0 and all the NaNs into the default NaN,
+ * so that equal values in the sense of util_double_equal() have the same bits.
+ */
+static uint64_t canonical_bits(double d)
+{
+	uint64_t bits;
+
+	d = d == 0 ? 0.0 : (isnan(d) ? NAN : d);
+	memcpy(&bits, &d, sizeof(bits));
+
+	return bits;
+}
+
+bool util_double_equal(const void *double1, const void *double2)
+{
+	if (!double1 || !double2) {
+		return double1 == double2;
+	}
+
+	return canonical_bits(*(const double *) double1) == canonical_bits(*(const double *) double2);
+}
+
+bool util_double_totalEqual(const void *double1, const void *double2)
+{
+	if (!double1 || !double2) {
+		return double1 == double2;
+	}
+
+	return util_double_totalKey(*(const double *) double1) == util_double_totalKey(*(const double *) double2);
+}
+
+bool util_string_equal(const void *str1, const void *str2)
+{
+	if (!str1 || !str2) {
+		return str1 == str2;
+	}
+
+	return str1 == str2 || string_equal(str1, str2);
+}
+
+/* !SECTION */
+/* SECTION - Hash functions */
+
+/**
+ * @brief Finalizer of splitmix64, which spreads every input bit over the whole result.
+ */
+static uint64_t mix64(uint64_t x)
+{
+	x ^= x >> 30;
+	x *= 0xBF58476D1CE4E5B9ULL;
+	x ^= x >> 27;
+	x *= 0x94D049BB133111EBULL;
+	x ^= x >> 31;
+
+	return x;
+}
+
+uint64_t util_generic_hash(const void *p)
+{
+	return p ? mix64((uint64_t) (uintptr_t) p) : 0;
+}
+
+uint64_t util_char_hash(const void *c)
+{
+	return c ? mix64((unsigned char) *(const char *) c) : 0;
+}
+
+uint64_t util_int_hash(const void *i)
+{
+	return i ? mix64((uint32_t) *(const int *) i) : 0;
+}
+
+uint64_t util_double_hash(const void *d)
+{
+	if (!d) {
+		return 0;
+	}
+
+	return mix64(canonical_bits(*(const double *) d));
+}
+
+uint64_t util_double_totalHash(const void *d)
+{
+	return d ? mix64(util_double_totalKey(*(const double *) d)) : 0;
+}
+
+uint64_t util_string_hash(const void *s)
+{
+	if (!s) {
+		return 0;
+	}
+
+	return hash_bytes(s, strlen(s));
+}
+
+/* !SECTION */
+/* SECTION - Sort key functions */
+
+/**
+ * @brief Writes the key of NULL, @ref UTIL_KEY_NULL, if size allows it.
+ */
+static size_t write_null_key(unsigned char *buf, size_t size)
+{
+	if (size > 0) {
+		buf[0] = UTIL_KEY_NULL;
+	}
+
+	return 1;
+}
+
+/**
+ * @brief Writes @ref UTIL_KEY_PRESENT followed by the len - 1 low bytes of an unsigned key in
+ * big-endian order, so that memcmp() orders keys as integers. Only the first size bytes are written.
+ */
+static size_t write_key(unsigned char *buf, size_t size, uint64_t key, size_t len)
+{
+	if (size > 0) {
+		buf[0] = UTIL_KEY_PRESENT;
+	}
+
+	for (size_t b = 1; b < len && b < size; b++) {
+		buf[b] = (unsigned char) (key >> (8 * (len - 1 - b)));
+	}
+
+	return len;
+}
+
+int util_compareKeys(const unsigned char *key1, size_t len1, const unsigned char *key2, size_t len2)
+{
+	size_t len = len1 < len2 ? len1 : len2;
+	int res    = len > 0 ? memcmp(key1, key2, len) : 0;
+
+	return res ? res : (len1 > len2) - (len1 < len2);
+}
+
+size_t util_char_sortKey(unsigned char *buf, size_t size, const void *c)
+{
+	if (!c) {
+		return write_null_key(buf, size);
+	}
+
+	return write_key(buf, size, (uint64_t) (*(const char *) c - CHAR_MIN), UTIL_CHAR_KEYSIZE);
+}
+
+size_t util_int_sortKey(unsigned char *buf, size_t size, const void *i)
+{
+	if (!i) {
+		return write_null_key(buf, size);
+	}
+
+	return write_key(buf, size, (uint32_t) *(const int *) i ^ 0x80000000U, UTIL_INT_KEYSIZE);
+}
+
+size_t util_double_sortKey(unsigned char *buf, size_t size, const void *d)
+{
+	if (!d) {
+		return write_null_key(buf, size);
+	}
+
+	return write_key(buf, size, util_double_totalKey(*(const double *) d), UTIL_DOUBLE_KEYSIZE);
+}
+
+size_t util_string_sortKey(unsigned char *buf, size_t size, const void *s)
+{
+	if (!s) {
+		return write_null_key(buf, size);
+	}
+
+	size_t len = strlen(s) + 1;
+	if (size > 0) {
+		buf[0] = UTIL_KEY_PRESENT;
+		memcpy(buf + 1, s, len < size - 1 ? len : size - 1);
+	}
+
+	return len + 1;
 }
 
 /* !SECTION */
@@ -180,7 +559,7 @@ char *util_generic_toString(const void *elem)
 	str = malloc((MAX_POINTER_LEN + 1) * sizeof(char));
 	check_mem(str);
 
-	snprintf(str, MAX_POINTER_LEN + 1, "0x%" PRIxPTR, (uintptr_t) elem);
+	util_generic_toBuffer(str, MAX_POINTER_LEN + 1, elem);
 
 error:
 	return str;
@@ -197,8 +576,7 @@ char *util_char_toString(const void *c)
 	str = malloc((MAX_CHAR_LEN + 1) * sizeof(char));
 	check_mem(str);
 
-	str[0] = *(const char *) c;
-	str[1] = '\0';
+	util_char_toBuffer(str, MAX_CHAR_LEN + 1, c);
 
 error:
 	return str;
@@ -215,7 +593,7 @@ char *util_int_toString(const void *n)
 	str = malloc((MAX_INT_LEN + 1) * sizeof(char));
 	check_mem(str);
 
-	snprintf(str, MAX_INT_LEN + 1, "%d", *(const int *) n);
+	util_int_toBuffer(str, MAX_INT_LEN + 1, n);
 
 error:
 	return str;
@@ -232,7 +610,7 @@ char *util_double_toString(const void *d)
 	str = malloc((MAX_DOUB_LEN + 1) * sizeof(char));
 	check_mem(str);
 
-	snprintf(str, MAX_DOUB_LEN + 1, "%.*g", DBL_DIG, *(const double *) d);
+	util_double_toBuffer(str, MAX_DOUB_LEN + 1, d);
 
 error:
 	return str;
@@ -253,6 +631,73 @@ error:
 	return str;
 }
 
+/* !SECTION */
+/* SECTION - To buffer functions */
+
+int util_generic_toBuffer(char *buf, size_t size, const void *e)
+{
+	if (!e) {
+		return -1;
+	}
+
+	return snprintf(buf, size, "0x%" PRIxPTR, (uintptr_t) e);
+}
+
+int util_char_toBuffer(char *buf, size_t size, const void *c)
+{
+	if (!c) {
+		return -1;
+	}
+
+	if (size > MAX_CHAR_LEN) {
+		buf[0] = *(const char *) c;
+		buf[1] = '\0';
+	} else if (size > 0) {
+		buf[0] = '\0';
+	}
+
+	return MAX_CHAR_LEN;
+}
+
+int util_int_toBuffer(char *buf, size_t size, const void *i)
+{
+	if (!i) {
+		return -1;
+	}
+
+	char tmp[UTIL_FORMAT_BUFSIZE];
+	size_t len = util_formatInt(tmp, *(const int *) i);
+
+	return copy_truncated(buf, size, tmp, len);
+}
+
+int util_double_toBuffer(char *buf, size_t size, const void *d)
+{
+	if (!d) {
+		return -1;
+	}
+
+	char tmp[UTIL_FORMAT_BUFSIZE];
+	size_t len = util_formatDouble(tmp, *(const double *) d);
+
+	return copy_truncated(buf, size, tmp, len);
+}
+
+int util_string_toBuffer(char *buf, size_t size, const void *s)
+{
+	if (!s) {
+		return -1;
+	}
+
+	size_t len = strlen((const char *) s);
+	if (len > INT_MAX) {
+		errno = EOVERFLOW;
+		return -1;
+	}
+
+	return copy_truncated(buf, size, s, len);
+}
+
 /* !SECTION */
 /* SECTION - From string functions */
 
@@ -277,16 +722,11 @@ void *util_int_fromString(const char *str)
 	check_mem(i);
 
 	char *end;
-	errno    = 0;
-	long tmp = strtol(str, &end, 10);
-	if (tmp > INT_MAX || tmp < INT_MIN) {
-		errno = ERANGE;
-	}
+	errno = 0;
+	*i    = util_strtoi(str, &end);
 	check(errno == 0, "Error parsing %s", str);
 	check(end != str, "No integer could be parsed from %s", str);
 
-	*i = (int) tmp;
-
 	return i;
 
 error:
@@ -303,7 +743,7 @@ void *util_double_fromString(const char *str)
 
 	char *end;
 	errno = 0;
-	*d    = strtod(str, &end);
+	*d    = util_strtod(str, &end);
 	check(errno == 0, "Error parsing %s", str);
 	check(end != str, "No value could be parsed from %s", str);
 
@@ -325,6 +765,109 @@ error:
 	return s;
 }
 
+ErrStatus util_int_tryFromString(const char *str, int *i, size_t *offset)
+{
+	claim(str != NULL && i != NULL);
+
+	int saved_errno = errno;
+	char *end;
+
+	errno            = 0;
+	int value        = util_strtoi(str, &end);
+	ErrStatus status = errno == ERANGE ? E_OUT_OF_RANGE : E_SUCCESS;
+	errno            = saved_errno;
+
+	if (offset) {
+		*offset = (size_t) (end - str);
+	}
+
+	if (end == str) {
+		return E_INVALID_ARG;
+	}
+
+	*i = value;
+	return status;
+}
+
+ErrStatus util_double_tryFromString(const char *str, double *d, size_t *offset)
+{
+	claim(str != NULL && d != NULL);
+
+	int saved_errno = errno;
+	char *end;
+
+	errno            = 0;
+	double value     = util_strtod(str, &end);
+	ErrStatus status = errno == ERANGE ? E_OUT_OF_RANGE : E_SUCCESS;
+	errno            = saved_errno;
+
+	if (offset) {
+		*offset = (size_t) (end - str);
+	}
+
+	if (end == str) {
+		return E_INVALID_ARG;
+	}
+
+	*d = value;
+	return status;
+}
+
+/* !SECTION */
+/* SECTION - Length-delimited parsing functions */
+
+ErrStatus util_char_parse(const char *str, size_t len, void *c, const char **end)
+{
+	claim(str != NULL && c != NULL);
+
+	if (len == 0) {
+		if (end) {
+			*end = str;
+		}
+		return E_INVALID_ARG;
+	}
+
+	*(char *) c = *str;
+	if (end) {
+		*end = str + 1;
+	}
+
+	return E_SUCCESS;
+}
+
+ErrStatus util_int_parse(const char *str, size_t len, void *i, const char **end)
+{
+	claim(str != NULL && i != NULL);
+
+	long value       = 0;
+	ErrStatus status = util_parseLong(str, len, INT_MIN, INT_MAX, &value, end);
+
+	if (status != E_INVALID_ARG) {
+		*(int *) i = (int) value;
+	}
+
+	return status;
+}
+
+ErrStatus util_double_parse(const char *str, size_t len, void *d, const char **end)
+{
+	claim(str != NULL && d != NULL);
+
+	return util_parseDouble(str, len, (double *) d, end);
+}
+
+ErrStatus util_stringView_parse(const char *str, size_t len, void *sv, const char **end)
+{
+	claim(str != NULL && sv != NULL);
+
+	*(StringView *) sv = (StringView) {.str = str, .len = len};
+	if (end) {
+		*end = str + len;
+	}
+
+	return E_SUCCESS;
+}
+
 /* !SECTION */
 /* SECTION - Misc */
 
@@ -334,3 +877,81 @@ bool util_genericEqual(const void *e1, const void *e2)
 }
 
 /* !SECTION */
+/* SECTION - Type descriptors */
+
+const UtilType UTIL_TYPE_CHAR = {
+	.name       = "char",
+	.kind       = UTIL_KIND_CHAR,
+	.size       = sizeof(char),
+	.align      = _Alignof(char),
+	.print      = util_char_print,
+	.cmp        = util_char_cmp,
+	.equal      = util_char_equal,
+	.hash       = util_char_hash,
+	.sortKey    = util_char_sortKey,
+	.toString   = util_char_toString,
+	.toBuffer   = util_char_toBuffer,
+	.fromString = util_char_fromString,
+	.parse      = util_char_parse,
+	.free       = free,
+};
+
+const UtilType UTIL_TYPE_INT = {
+	.name       = "int",
+	.kind       = UTIL_KIND_INT,
+	.size       = sizeof(int),
+	.align      = _Alignof(int),
+	.print      = util_int_print,
+	.cmp        = util_int_cmp,
+	.equal      = util_int_equal,
+	.hash       = util_int_hash,
+	.sortKey    = util_int_sortKey,
+	.toString   = util_int_toString,
+	.toBuffer   = util_int_toBuffer,
+	.fromString = util_int_fromString,
+	.parse      = util_int_parse,
+	.free       = free,
+};
+
+const UtilType UTIL_TYPE_DOUBLE = {
+	.name       = "double",
+	.kind       = UTIL_KIND_DOUBLE,
+	.size       = sizeof(double),
+	.align      = _Alignof(double),
+	.print      = util_double_print,
+	.cmp        = util_double_totalCmp,
+	.equal      = util_double_totalEqual,
+	.hash       = util_double_totalHash,
+	.sortKey    = util_double_sortKey,
+	.toString   = util_double_toString,
+	.toBuffer   = util_double_toBuffer,
+	.fromString = util_double_fromString,
+	.parse      = util_double_parse,
+	.free       = free,
+};
+
+const UtilType UTIL_TYPE_STRING = {
+	.name       = "string",
+	.kind       = UTIL_KIND_STRING,
+	.print      = util_string_print,
+	.cmp        = util_string_cmp,
+	.equal      = util_string_equal,
+	.hash       = util_string_hash,
+	.sortKey    = util_string_sortKey,
+	.toString   = util_string_toString,
+	.toBuffer   = util_string_toBuffer,
+	.fromString = util_string_fromString,
+	.free       = free,
+};
+
+const UtilType UTIL_TYPE_GENERIC = {
+	.name     = "generic",
+	.kind     = UTIL_KIND_GENERIC,
+	.print    = util_generic_print,
+	.equal    = util_genericEqual,
+	.hash     = util_generic_hash,
+	.toString = util_generic_toString,
+	.toBuffer = util_generic_toBuffer,
+};
+
+/* !SECTION */
@@ -1,7 +1,13 @@
 #include "test_macros.h"
 #include "utilities.h"
 
+#include <fcntl.h>
 #include <limits.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
 
 #define test_equal(fn, x, y)  \
 	ck_assert(fn(x, y) == 0); \
@@ -143,6 +149,40 @@ START_TEST(test_double_cmp_limits2)
 
 END_TEST
 
+START_TEST(test_double_totalCmp)
+{
+	/* In increasing order */
+	double values[] = {-NAN, -INFINITY, -DBL_MAX, -1.5, -DBL_MIN, -0.0, 0.0, DBL_MIN, 1.5, DBL_MAX, INFINITY, NAN};
+	size_t n        = sizeof(values) / sizeof(values[0]);
+
+	for (size_t i = 0; i < n; i++) {
+		test_equal(util_double_totalCmp, &values[i], &values[i]);
+		for (size_t j = i + 1; j < n; j++) {
+			test_diff(util_double_totalCmp, &values[i], &values[j]);
+			ck_assert(util_double_totalKey(values[i]) < util_double_totalKey(values[j]));
+		}
+	}
+
+	test_null(util_double_totalCmp, &values[0]);
+}
+
+END_TEST
+
+START_TEST(test_double_totalCmpBatch)
+{
+	double d1[]    = {1.0, NAN, -0.0, 2.0, -INFINITY};
+	double d2[]    = {1.0, 1.0, 0.0, -2.0, NAN};
+	int expected[] = {0, 1, -1, 1, -1};
+	int results[5] = {0};
+
+	util_double_totalCmpBatch(d1, d2, results, 5);
+	ck_assert_mem_eq(results, expected, sizeof(expected));
+
+	util_double_totalCmpBatch(NULL, NULL, NULL, 0);
+}
+
+END_TEST
+
 START_TEST(test_string_cmp_equal)
 {
 	const char *s1 = "abcdef";
@@ -180,6 +220,269 @@ START_TEST(test_string_cmp_limits)
 	test_diff(util_string_cmp, s1, s2);
 }
 
+START_TEST(test_string_cmp_lengths)
+{
+	char s1[300];
+	char s2[300];
+
+	/* Differences and ends at every position of the first vectors and past the vector limit */
+	for (size_t len = 0; len < 260; len++) {
+		memset(s1, 'k', len);
+		memset(s2, 'k', len);
+		s1[len] = s2[len] = '\0';
+
+		ck_assert(util_string_cmp(s1, s2) == 0 && util_string_equal(s1, s2));
+
+		if (len > 0) {
+			s2[len - 1] = (char) 0xE9;
+			ck_assert_msg(util_string_cmp(s1, s2) < 0, "len = %zu", len);
+			ck_assert(util_string_cmp(s2, s1) > 0);
+			ck_assert(!util_string_equal(s1, s2) && !util_string_equal(s2, s1));
+
+			s2[len - 1] = '\0';
+			ck_assert(util_string_cmp(s1, s2) > 0 && util_string_cmp(s2, s1) < 0);
+			ck_assert(!util_string_equal(s1, s2));
+		}
+	}
+}
+
+END_TEST
+
+START_TEST(test_string_cmp_page_boundary)
+{
+	long page  = sysconf(_SC_PAGESIZE);
+	int fd     = open("/dev/zero", O_RDWR);
+	char *mem  = mmap(NULL, 2 * (size_t) page, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+	char other[80];
+
+	ck_assert(fd >= 0 && mem != MAP_FAILED);
+	ck_assert(mprotect(mem + page, (size_t) page, PROT_NONE) == 0);
+
+	/* Strings that end right before an unreadable page */
+	for (size_t len = 0; len < 70; len++) {
+		char *s = mem + page - len - 1;
+
+		memset(s, 'p', len);
+		s[len] = '\0';
+		memcpy(other, s, len + 1);
+
+		ck_assert(util_string_cmp(s, other) == 0 && util_string_cmp(other, s) == 0);
+		ck_assert(util_string_equal(s, other) && util_string_equal(other, s));
+
+		other[len]     = 'q';
+		other[len + 1] = '\0';
+		ck_assert(util_string_cmp(s, other) < 0 && util_string_cmp(other, s) > 0);
+		ck_assert(!util_string_equal(s, other) && !util_string_equal(other, s));
+	}
+
+	munmap(mem, 2 * (size_t) page);
+	close(fd);
+}
+
+END_TEST
+
+START_TEST(test_equal_functions)
+{
+	char c1 = 'a', c2 = 'a', c3 = 'b';
+	int i1 = 7, i2 = 7, i3 = -7;
+	double d1 = 0.0, d2 = -0.0, d3 = 1e-300;
+	char s1[] = "equal", s2[] = "equal";
+
+	ck_assert(util_char_equal(&c1, &c2) && !util_char_equal(&c1, &c3));
+	ck_assert(util_int_equal(&i1, &i2) && !util_int_equal(&i1, &i3));
+	ck_assert(util_double_equal(&d1, &d2) && !util_double_equal(&d1, &d3));
+	ck_assert(util_double_equal(NULL, NULL) && !util_double_equal(&d1, NULL));
+
+	/* NaN is only equal to NaN, whatever its sign and payload, so that equality stays transitive */
+	double nan1 = NAN, nan2 = -NAN, one = 1.0, two = 2.0;
+	ck_assert(util_double_equal(&nan1, &nan2) && util_double_equal(&nan1, &nan1));
+	ck_assert(!util_double_equal(&nan1, &one) && !util_double_equal(&nan1, &two) && !util_double_equal(&two, &nan2));
+	ck_assert(util_string_equal(s1, s2) && !util_string_equal(s1, "equals"));
+
+	ck_assert(util_int_equal(NULL, NULL) && !util_int_equal(&i1, NULL) && !util_int_equal(NULL, &i1));
+	ck_assert(util_string_equal(NULL, NULL) && !util_string_equal(s1, NULL));
+}
+
+END_TEST
+
+START_TEST(test_hash_functions)
+{
+	/* Equal elements have equal hashes */
+	int i1 = 123456, i2 = 123456, i3 = 123457;
+	double d1 = 0.0, d2 = -0.0;
+	char s1[] = "hash me", s2[] = "hash me";
+
+	ck_assert(util_int_hash(&i1) == util_int_hash(&i2));
+	ck_assert(util_int_hash(&i1) != util_int_hash(&i3));
+	ck_assert(util_double_hash(&d1) == util_double_hash(&d2));
+	double nan1 = NAN, nan2 = -NAN;
+	ck_assert(util_double_hash(&nan1) == util_double_hash(&nan2));
+	ck_assert(util_string_hash(s1) == util_string_hash(s2));
+	ck_assert(util_string_hash(s1) != util_string_hash("hash me!"));
+	ck_assert(util_generic_hash(s1) != util_generic_hash(s2));
+
+	ck_assert(util_char_hash(NULL) == 0 && util_int_hash(NULL) == 0 && util_double_hash(NULL) == 0);
+	ck_assert(util_string_hash(NULL) == 0 && util_generic_hash(NULL) == 0);
+}
+
+END_TEST
+
+/**
+ * @brief Tests that the sort keys of two elements are ordered as the elements.
+ */
+static void check_keys(util_sortKey key, util_compare cmp, const void *e1, const void *e2)
+{
+	unsigned char k1[64];
+	unsigned char k2[64];
+	size_t len1  = key(k1, sizeof(k1), e1);
+	size_t len2  = key(k2, sizeof(k2), e2);
+	int expected = cmp(e1, e2);
+	int actual   = util_compareKeys(k1, len1, k2, len2);
+
+	ck_assert((expected > 0) == (actual > 0) && (expected < 0) == (actual < 0));
+}
+
+START_TEST(test_sort_keys)
+{
+	char chars[]     = {CHAR_MIN, -1, 0, 1, 'a', CHAR_MAX};
+	int ints[]       = {INT_MIN, -65536, -256, -1, 0, 1, 255, 256, 65536, INT_MAX};
+	double doubles[] = {-NAN, -INFINITY, -DBL_MAX, -1.5, -DBL_MIN, -0.0, 0.0, DBL_MIN, 1.5, DBL_MAX, INFINITY, NAN};
+	char *strings[]  = {"", "a", "a\x80", "ab", "abc", "b", "\x7f", "\xff"};
+
+	for (size_t i = 0; i < sizeof(chars); i++) {
+		for (size_t j = 0; j < sizeof(chars); j++) {
+			check_keys(util_char_sortKey, util_char_cmp, &chars[i], &chars[j]);
+		}
+		check_keys(util_char_sortKey, util_char_cmp, NULL, &chars[i]);
+	}
+	for (size_t i = 0; i < sizeof(ints) / sizeof(ints[0]); i++) {
+		for (size_t j = 0; j < sizeof(ints) / sizeof(ints[0]); j++) {
+			check_keys(util_int_sortKey, util_int_cmp, &ints[i], &ints[j]);
+		}
+		check_keys(util_int_sortKey, util_int_cmp, &ints[i], NULL);
+	}
+	for (size_t i = 0; i < sizeof(doubles) / sizeof(doubles[0]); i++) {
+		for (size_t j = 0; j < sizeof(doubles) / sizeof(doubles[0]); j++) {
+			check_keys(util_double_sortKey, util_double_totalCmp, &doubles[i], &doubles[j]);
+		}
+	}
+	for (size_t i = 0; i < sizeof(strings) / sizeof(strings[0]); i++) {
+		for (size_t j = 0; j < sizeof(strings) / sizeof(strings[0]); j++) {
+			check_keys(util_string_sortKey, util_string_cmp, strings[i], strings[j]);
+		}
+		check_keys(util_string_sortKey, util_string_cmp, NULL, strings[i]);
+	}
+
+	ck_assert(util_int_sortKey(NULL, 0, &ints[0]) == UTIL_INT_KEYSIZE);
+	ck_assert(util_double_sortKey(NULL, 0, &doubles[0]) == UTIL_DOUBLE_KEYSIZE);
+	ck_assert(util_string_sortKey(NULL, 0, "abc") == 5);
+	ck_assert(util_char_sortKey(NULL, 0, NULL) == 1);
+	ck_assert(UTIL_TYPE_INT.sortKey == util_int_sortKey && UTIL_TYPE_GENERIC.sortKey == NULL);
+}
+
+END_TEST
+
+START_TEST(test_sort_keys_composite)
+{
+	/* (string, int) pairs in increasing order */
+	char *names[] = {"ab", "ab", "ab", "abc", "b"};
+	int numbers[] = {-5, 0, 7, -100, -100};
+	unsigned char keys[5][16];
+	size_t lens[5];
+
+	for (size_t i = 0; i < 5; i++) {
+		lens[i] = util_string_sortKey(keys[i], sizeof(keys[i]), names[i]);
+		lens[i] += util_int_sortKey(keys[i] + lens[i], sizeof(keys[i]) - lens[i], &numbers[i]);
+	}
+
+	for (size_t i = 1; i < 5; i++) {
+		ck_assert(util_compareKeys(keys[i - 1], lens[i - 1], keys[i], lens[i]) < 0);
+		ck_assert(util_compareKeys(keys[i], lens[i], keys[i - 1], lens[i - 1]) > 0);
+	}
+	ck_assert(util_compareKeys(keys[0], lens[0], keys[0], lens[0]) == 0);
+
+	/* Truncated keys are prefixes of the whole key */
+	unsigned char prefix[3] = {0};
+	ck_assert(util_int_sortKey(prefix, 2, &numbers[2]) == UTIL_INT_KEYSIZE);
+	ck_assert(memcmp(prefix, keys[2] + 4, 2) == 0 && prefix[2] == 0);
+	ck_assert(util_string_sortKey(prefix, 2, "abc") == 5);
+	ck_assert(memcmp(prefix, "\x01" "a", 2) == 0);
+}
+
+END_TEST
+
+START_TEST(test_sort_keys_composite_null)
+{
+	/* (string, int) pairs in increasing order, with NULL fields ordered first */
+	char *names[]  = {NULL, NULL, NULL, "", "", "a", "a"};
+	int numbers[]  = {0, INT_MIN, 7, INT_MIN, 0, 0, -1};
+	bool is_null[] = {true, false, false, false, false, true, false};
+	unsigned char keys[7][16];
+	size_t lens[7];
+
+	for (size_t i = 0; i < 7; i++) {
+		lens[i] = util_string_sortKey(keys[i], sizeof(keys[i]), names[i]);
+		lens[i] += util_int_sortKey(keys[i] + lens[i], sizeof(keys[i]) - lens[i], is_null[i] ? NULL : &numbers[i]);
+	}
+
+	for (size_t i = 1; i < 7; i++) {
+		ck_assert_msg(util_compareKeys(keys[i - 1], lens[i - 1], keys[i], lens[i]) < 0, "i = %zu", i);
+		ck_assert_msg(util_compareKeys(keys[i], lens[i], keys[i - 1], lens[i - 1]) > 0, "i = %zu", i);
+	}
+}
+
+END_TEST
+
+START_TEST(test_type_descriptors)
+{
+	const UtilType *types[] = {&UTIL_TYPE_CHAR, &UTIL_TYPE_INT, &UTIL_TYPE_DOUBLE, &UTIL_TYPE_STRING};
+	const char *inputs[]    = {"x", "-42", "2.5", "text"};
+
+	/* Round trip through the functions of each descriptor */
+	for (size_t t = 0; t < sizeof(types) / sizeof(types[0]); t++) {
+		const UtilType *type = types[t];
+		void *e1             = type->fromString(inputs[t]);
+		void *e2             = type->fromString(inputs[t]);
+		char *str            = type->toString(e1);
+
+		ck_assert(e1 != NULL && e2 != NULL);
+		ck_assert_str_eq(str, inputs[t]);
+		ck_assert(type->cmp(e1, e2) == 0);
+		ck_assert(type->equal(e1, e2));
+		ck_assert(type->hash(e1) == type->hash(e2));
+
+		free(str);
+		type->free(e1);
+		type->free(e2);
+	}
+
+	ck_assert(UTIL_TYPE_INT.kind == UTIL_KIND_INT && UTIL_TYPE_INT.size == sizeof(int));
+	ck_assert(UTIL_TYPE_DOUBLE.align == _Alignof(double));
+
+	/* NaNs and signed zeros are ordered, and equal, hash and sortKey agree with the order */
+	double doubles[] = {NAN, -NAN, 0.0, -0.0, 1.0, INFINITY};
+	for (size_t i = 0; i < sizeof(doubles) / sizeof(doubles[0]); i++) {
+		for (size_t j = 0; j < sizeof(doubles) / sizeof(doubles[0]); j++) {
+			bool same = UTIL_TYPE_DOUBLE.cmp(&doubles[i], &doubles[j]) == 0;
+			ck_assert_msg(same == (i == j), "i = %zu, j = %zu", i, j);
+			ck_assert(UTIL_TYPE_DOUBLE.equal(&doubles[i], &doubles[j]) == same);
+			ck_assert(!same || UTIL_TYPE_DOUBLE.hash(&doubles[i]) == UTIL_TYPE_DOUBLE.hash(&doubles[j]));
+
+			unsigned char k1[UTIL_DOUBLE_KEYSIZE], k2[UTIL_DOUBLE_KEYSIZE];
+			size_t len1 = UTIL_TYPE_DOUBLE.sortKey(k1, sizeof(k1), &doubles[i]);
+			size_t len2 = UTIL_TYPE_DOUBLE.sortKey(k2, sizeof(k2), &doubles[j]);
+			int by_cmp  = UTIL_TYPE_DOUBLE.cmp(&doubles[i], &doubles[j]);
+			int by_key  = util_compareKeys(k1, len1, k2, len2);
+			ck_assert((by_key > 0) - (by_key < 0) == (by_cmp > 0) - (by_cmp < 0));
+		}
+	}
+	ck_assert(UTIL_TYPE_STRING.size == 0 && UTIL_TYPE_STRING.parse == NULL);
+	ck_assert(UTIL_TYPE_GENERIC.kind == UTIL_KIND_GENERIC && UTIL_TYPE_GENERIC.cmp == NULL);
+	ck_assert(UTIL_TYPE_GENERIC.equal(types, types) && !UTIL_TYPE_GENERIC.equal(types, inputs));
+}
+
+END_TEST
+
 /* !SECTION */
 
 Suite *cmp_suite_create(void)
@@ -199,6 +502,12 @@ Suite *cmp_suite_create(void)
 	tcase_add_test(core, test_double_cmp_diff);
 	tcase_add_test(core, test_string_cmp_equal);
 	tcase_add_test(core, test_string_cmp_diff);
+	tcase_add_test(core, test_equal_functions);
+	tcase_add_test(core, test_hash_functions);
+	tcase_add_test(core, test_sort_keys);
+	tcase_add_test(core, test_sort_keys_composite);
+	tcase_add_test(core, test_sort_keys_composite_null);
+	tcase_add_test(core, test_type_descriptors);
 
 	limits = tcase_create(CASE_LIMITS);
 	tcase_add_test(limits, test_char_cmp_null);
@@ -208,8 +517,12 @@ Suite *cmp_suite_create(void)
 	tcase_add_test(limits, test_double_cmp_null);
 	tcase_add_test(limits, test_double_cmp_limits);
 	tcase_add_test(limits, test_double_cmp_limits2);
+	tcase_add_test(limits, test_double_totalCmp);
+	tcase_add_test(limits, test_double_totalCmpBatch);
 	tcase_add_test(limits, test_string_cmp_null);
 	tcase_add_test(limits, test_string_cmp_limits);
+	tcase_add_test(limits, test_string_cmp_lengths);
+	tcase_add_test(limits, test_string_cmp_page_boundary);
 
 	suite_add_tcase(s, core);
 	suite_add_tcase(s, limits);
@@ -0,0 +1,194 @@
+#include "format.h"
+#include "test_macros.h"
+
+#include <float.h>
+#include <limits.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define test_format(fn, fmt, x)                   \
+	char buf[UTIL_FORMAT_BUFSIZE];                \
+	char expected[UTIL_FORMAT_BUFSIZE];           \
+	snprintf(expected, sizeof(expected), fmt, x); \
+	ck_assert(fn(buf, x) == strlen(expected));    \
+	ck_assert_str_eq(buf, expected);
+
+static const long long_values[] = {
+	0, 1, -1, 9, 10, -10, 99, 100, 101, 999, 1000, 12345, -67890, 1000000, 9999999, 123456789,
+	INT_MAX, INT_MIN, (long) INT_MAX + 1, (long) INT_MIN - 1, 1000000000000000000L, LONG_MAX, LONG_MIN
+};
+
+#define NUM_OF_LONGS (sizeof(long_values) / sizeof(*long_values))
+
+static const struct {
+	double value;
+	const char *str;
+} double_values[] = {
+	{ 0.0,                     "0"                        },
+	{ -0.0,                    "-0"                       },
+	{ 1.0,                     "1"                        },
+	{ -1.5,                    "-1.5"                     },
+	{ 0.1,                     "0.1"                      },
+	{ 0.3,                     "0.3"                      },
+	{ 2.0 / 3.0,               "0.6666666666666666"       },
+	{ 100.0,                   "100"                      },
+	{ 1e-4,                    "0.0001"                   },
+	{ 1e-5,                    "1e-05"                    },
+	{ 1e16,                    "10000000000000000"        },
+	{ 1e17,                    "1e+17"                    },
+	{ 123456789012345678.0,    "1.2345678901234568e+17"   },
+	{ 5e-324,                  "5e-324"                   },
+	{ DBL_MAX,                 "1.7976931348623157e+308"  },
+	{ DBL_MIN,                 "2.2250738585072014e-308"  },
+	{ -DBL_EPSILON,            "-2.220446049250313e-16"   },
+	{ 9007199254740993.0,      "9007199254740992"         },
+	{ HUGE_VAL,                "inf"                      },
+	{ -HUGE_VAL,               "-inf"                     },
+};
+
+#define NUM_OF_DOUBLES (sizeof(double_values) / sizeof(*double_values))
+
+/**
+ * @brief Number of random doubles checked for round trips.
+ */
+#define ROUND_TRIPS 100000
+
+/* SECTION - Tests */
+
+START_TEST(test_format_int)
+{
+	int i = (int) long_values[_i];
+
+	test_format(util_formatInt, "%d", i);
+}
+
+END_TEST
+
+START_TEST(test_format_long)
+{
+	long l = long_values[_i];
+
+	test_format(util_formatLong, "%ld", l);
+}
+
+END_TEST
+
+START_TEST(test_format_unsigned)
+{
+	unsigned u = (unsigned) long_values[_i];
+
+	test_format(util_formatUnsigned, "%u", u);
+}
+
+END_TEST
+
+START_TEST(test_format_unsigned_long)
+{
+	unsigned long u = (unsigned long) long_values[_i];
+
+	test_format(util_formatUnsignedLong, "%lu", u);
+}
+
+END_TEST
+
+START_TEST(test_format_int_powers)
+{
+	for (int i = 1; i <= INT_MAX / 10; i *= 10) {
+		test_format(util_formatInt, "%d", i - 1);
+	}
+}
+
+END_TEST
+
+START_TEST(test_format_unsigned_max)
+{
+	unsigned u = UINT_MAX;
+
+	test_format(util_formatUnsigned, "%u", u);
+}
+
+END_TEST
+
+START_TEST(test_format_double)
+{
+	char buf[UTIL_FORMAT_BUFSIZE];
+
+	ck_assert(util_formatDouble(buf, double_values[_i].value) == strlen(double_values[_i].str));
+	ck_assert_str_eq(buf, double_values[_i].str);
+}
+
+END_TEST
+
+START_TEST(test_format_double_nan)
+{
+	char buf[UTIL_FORMAT_BUFSIZE];
+
+	ck_assert(util_formatDouble(buf, NAN) == 3);
+	ck_assert_str_eq(buf, "nan");
+}
+
+END_TEST
+
+START_TEST(test_format_double_round_trip)
+{
+	char buf[UTIL_FORMAT_BUFSIZE];
+	uint64_t state = 0x9E3779B97F4A7C15ULL;
+
+	for (int i = 0; i < ROUND_TRIPS; i++) {
+		uint64_t bits, back_bits;
+		double d;
+
+		do {
+			state ^= state << 13;
+			state ^= state >> 7;
+			state ^= state << 17;
+			bits    = state;
+			memcpy(&d, &bits, sizeof(d));
+		} while (!isfinite(d));
+
+		ck_assert(util_formatDouble(buf, d) < UTIL_FORMAT_BUFSIZE);
+
+		double back = strtod(buf, NULL);
+		memcpy(&back_bits, &back, sizeof(back));
+		ck_assert_msg(bits == back_bits, "%a was written as %s", d, buf);
+	}
+}
+
+END_TEST
+
+/* !SECTION */
+
+Suite *format_suite_create(void)
+{
+	Suite *s;
+	TCase *core;
+	TCase *limits;
+
+	s = suite_create("Number formatting functions");
+
+	core = tcase_create(CASE_CORE);
+	tcase_add_loop_test(core, test_format_int, 0, NUM_OF_LONGS);
+	tcase_add_loop_test(core, test_format_long, 0, NUM_OF_LONGS);
+	tcase_add_loop_test(core, test_format_unsigned, 0, NUM_OF_LONGS);
+	tcase_add_loop_test(core, test_format_unsigned_long, 0, NUM_OF_LONGS);
+	tcase_add_loop_test(core, test_format_double, 0, NUM_OF_DOUBLES);
+	tcase_add_test(core, test_format_double_round_trip);
+
+	limits = tcase_create(CASE_LIMITS);
+	tcase_add_test(limits, test_format_int_powers);
+	tcase_add_test(limits, test_format_unsigned_max);
+	tcase_add_test(limits, test_format_double_nan);
+
+	suite_add_tcase(s, core);
+	suite_add_tcase(s, limits);
+
+	return s;
+}
+
+int main(void)
+{
+	MAIN_RUNNER(format_suite_create);
+}
@@ -294,6 +294,56 @@ START_TEST(test_string_from_string_empty)
 
 END_TEST
 
+START_TEST(test_int_try_from_string)
+{
+	const char *strings[] = {"12345", "  -42xyz", "qwerty12345", "", "2147483648", "-9999999999 "};
+	const ErrStatus status[] = {E_SUCCESS, E_SUCCESS, E_INVALID_ARG, E_INVALID_ARG, E_OUT_OF_RANGE, E_OUT_OF_RANGE};
+	const int values[]       = {12345, -42, 7, 7, INT_MAX, INT_MIN};
+	const size_t offsets[]   = {5, 5, 0, 0, 10, 11};
+
+	for (size_t j = 0; j < sizeof(strings) / sizeof(*strings); j++) {
+		int i         = 7;
+		size_t offset = 99;
+
+		errno = EINTR;
+		ck_assert(util_int_tryFromString(strings[j], &i, &offset) == status[j]);
+		ck_assert(i == values[j]);
+		ck_assert(offset == offsets[j]);
+		ck_assert(errno == EINTR);
+	}
+}
+
+END_TEST
+
+START_TEST(test_double_try_from_string)
+{
+	const char *strings[] = {"1234.567nbvcxz", "1e-3", "nbvcxz1.5", "", "34e+1024", "-34e-1024", "0x1F", "NAN"};
+	const ErrStatus status[] = {E_SUCCESS,      E_SUCCESS,      E_INVALID_ARG, E_INVALID_ARG,
+								E_OUT_OF_RANGE, E_OUT_OF_RANGE, E_SUCCESS,     E_SUCCESS};
+	const size_t offsets[]   = {8, 4, 0, 0, 8, 9, 4, 3};
+
+	for (size_t j = 0; j < sizeof(strings) / sizeof(*strings); j++) {
+		double d      = 7;
+		size_t offset = 99;
+
+		errno = EINTR;
+		ck_assert(util_double_tryFromString(strings[j], &d, &offset) == status[j]);
+		ck_assert(offset == offsets[j]);
+		ck_assert(errno == EINTR);
+		if (status[j] == E_INVALID_ARG) {
+			ck_assert(d == 7);
+		}
+	}
+
+	double d;
+	ck_assert(util_double_tryFromString("1e-3", &d, NULL) == E_SUCCESS);
+	ck_assert(d == 0.001);
+	ck_assert(util_double_tryFromString("34e+1024", &d, NULL) == E_OUT_OF_RANGE);
+	ck_assert(d == HUGE_VAL);
+}
+
+END_TEST
+
 #ifndef NDEBUG
 START_TEST(test_from_null_string)
 {
@@ -349,6 +399,8 @@ Suite *from_string_suite_create(void)
 	tcase_add_test(invalid, test_double_from_string_overflow);
 	tcase_add_test(invalid, test_double_from_string_underflow);
 	tcase_add_test(invalid, test_double_from_string_hex_neg);
+	tcase_add_test(invalid, test_int_try_from_string);
+	tcase_add_test(invalid, test_double_try_from_string);
 
 	signal_invalid = tcase_create(CASE_SIGNAL_INVALID);
 #ifndef NDEBUG
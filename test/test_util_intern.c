@@ -0,0 +1,242 @@
+#include "intern.h"
+#include "test_macros.h"
+#include "utilities.h"
+
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NUM_THREADS 4
+#define NUM_STRINGS 20000
+
+/**
+ * @brief Work of a thread of the concurrency test.
+ */
+typedef struct {
+	InternPool *pool;
+	const char **results;
+	size_t offset;
+} Worker;
+
+static void *intern_all(void *arg)
+{
+	Worker *w = arg;
+	char buf[32];
+
+	/* Each thread starts at a different string, so that they race on insertions */
+	for (size_t k = 0; k < NUM_STRINGS; k++) {
+		size_t i = (k + w->offset) % NUM_STRINGS;
+		sprintf(buf, "key-%zu", i);
+		w->results[i] = util_internPool_intern(w->pool, buf);
+	}
+
+	return NULL;
+}
+
+/* SECTION - Tests */
+
+START_TEST(test_intern_same_pointer)
+{
+	InternPool *pool = util_internPool_create();
+	char a[]         = "hello";
+	char b[]         = "hello";
+
+	ck_assert(pool != NULL);
+
+	const char *ia = util_internPool_intern(pool, a);
+	const char *ib = util_internPool_intern(pool, b);
+
+	ck_assert(ia != NULL && ia != a);
+	ck_assert(ia == ib);
+	ck_assert_str_eq(ia, "hello");
+	ck_assert(util_internPool_intern(pool, "world") != ia);
+	ck_assert(util_internPool_count(pool) == 2);
+
+	util_internPool_destroy(pool);
+}
+
+END_TEST
+
+START_TEST(test_intern_len)
+{
+	InternPool *pool = util_internPool_create();
+
+	ck_assert(pool != NULL);
+
+	const char *ab = util_internPool_internLen(pool, "abcdef", 2);
+	ck_assert_str_eq(ab, "ab");
+	ck_assert(util_internPool_intern(pool, "ab") == ab);
+
+	const char *empty = util_internPool_internLen(pool, NULL, 0);
+	ck_assert_str_eq(empty, "");
+	ck_assert(util_internPool_intern(pool, "") == empty);
+	ck_assert(util_internPool_count(pool) == 2);
+
+	util_internPool_destroy(pool);
+}
+
+END_TEST
+
+START_TEST(test_intern_global)
+{
+	char a[] = "global";
+	char b[] = "global";
+
+	void *ia = util_string_intern(a);
+	void *ib = util_string_intern(b);
+
+	ck_assert(ia != NULL);
+	ck_assert(util_genericEqual(ia, ib));
+	ck_assert(!util_genericEqual(ia, util_string_intern("other")));
+}
+
+END_TEST
+
+START_TEST(test_intern_many)
+{
+	/* Enough strings to grow every shard several times */
+	InternPool *pool     = util_internPool_create();
+	const char **results = malloc(NUM_STRINGS * sizeof(*results));
+	char buf[32];
+
+	ck_assert(pool != NULL && results != NULL);
+
+	for (size_t i = 0; i < NUM_STRINGS; i++) {
+		sprintf(buf, "key-%zu", i);
+		results[i] = util_internPool_intern(pool, buf);
+		ck_assert(results[i] != NULL);
+	}
+	ck_assert(util_internPool_count(pool) == NUM_STRINGS);
+
+	for (size_t i = 0; i < NUM_STRINGS; i++) {
+		sprintf(buf, "key-%zu", i);
+		ck_assert(util_internPool_intern(pool, buf) == results[i]);
+		ck_assert_str_eq(results[i], buf);
+	}
+	ck_assert(util_internPool_count(pool) == NUM_STRINGS);
+
+	free(results);
+	util_internPool_destroy(pool);
+}
+
+END_TEST
+
+START_TEST(test_intern_long)
+{
+	/* Strings larger than the storage blocks */
+	InternPool *pool = util_internPool_create();
+	size_t len       = 100000;
+	char *str        = malloc(len + 1);
+
+	ck_assert(pool != NULL && str != NULL);
+	memset(str, 'x', len);
+	str[len] = '\0';
+
+	const char *small = util_internPool_intern(pool, "small");
+	const char *large = util_internPool_intern(pool, str);
+	ck_assert(large != NULL && strlen(large) == len);
+	ck_assert(util_internPool_intern(pool, str) == large);
+	ck_assert(util_internPool_intern(pool, "small") == small);
+
+	free(str);
+	util_internPool_destroy(pool);
+}
+
+END_TEST
+
+START_TEST(test_intern_concurrent)
+{
+	InternPool *pool = util_internPool_create();
+	pthread_t threads[NUM_THREADS];
+	Worker workers[NUM_THREADS];
+
+	ck_assert(pool != NULL);
+
+	for (size_t t = 0; t < NUM_THREADS; t++) {
+		workers[t] = (Worker) {
+			.pool    = pool,
+			.results = malloc(NUM_STRINGS * sizeof(const char *)),
+			.offset  = t * NUM_STRINGS / NUM_THREADS,
+		};
+		ck_assert(workers[t].results != NULL);
+		ck_assert(pthread_create(&threads[t], NULL, intern_all, &workers[t]) == 0);
+	}
+
+	for (size_t t = 0; t < NUM_THREADS; t++) {
+		pthread_join(threads[t], NULL);
+	}
+
+	ck_assert(util_internPool_count(pool) == NUM_STRINGS);
+	for (size_t i = 0; i < NUM_STRINGS; i++) {
+		ck_assert(workers[0].results[i] != NULL);
+		for (size_t t = 1; t < NUM_THREADS; t++) {
+			ck_assert(workers[t].results[i] == workers[0].results[i]);
+		}
+	}
+
+	for (size_t t = 0; t < NUM_THREADS; t++) {
+		free(workers[t].results);
+	}
+	util_internPool_destroy(pool);
+}
+
+END_TEST
+
+START_TEST(test_intern_destroy_null)
+{
+	util_internPool_destroy(NULL);
+}
+
+END_TEST
+
+#ifndef NDEBUG
+START_TEST(test_intern_null_string)
+{
+	InternPool *pool = util_internPool_create();
+	util_internPool_intern(pool, NULL);
+}
+#endif
+
+END_TEST
+
+/* !SECTION */
+
+Suite *intern_suite_create(void)
+{
+	Suite *s;
+	TCase *core;
+	TCase *limits;
+	TCase *signal_invalid;
+
+	s = suite_create("String interning");
+
+	core = tcase_create(CASE_CORE);
+	tcase_add_test(core, test_intern_same_pointer);
+	tcase_add_test(core, test_intern_len);
+	tcase_add_test(core, test_intern_global);
+	tcase_add_test(core, test_intern_concurrent);
+
+	limits = tcase_create(CASE_LIMITS);
+	tcase_add_test(limits, test_intern_many);
+	tcase_add_test(limits, test_intern_long);
+	tcase_add_test(limits, test_intern_destroy_null);
+
+	signal_invalid = tcase_create(CASE_SIGNAL_INVALID);
+#ifndef NDEBUG
+	tcase_add_test_raise_signal(signal_invalid, test_intern_null_string, SIGABRT);
+#endif
+	tcase_set_tags(signal_invalid, NO_FORK_TAG);
+
+	suite_add_tcase(s, core);
+	suite_add_tcase(s, limits);
+	suite_add_tcase(s, signal_invalid);
+
+	return s;
+}
+
+int main(void)
+{
+	MAIN_RUNNER(intern_suite_create);
+}
@@ -0,0 +1,428 @@
+#include "load.h"
+#include "test_macros.h"
+#include "utilities.h"
+
+#include <errno.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define MAX_ELEMS 16
+
+/**
+ * @brief Elements collected by the consumers.
+ */
+typedef struct {
+	size_t count;
+	size_t limit;
+	int ints[MAX_ELEMS];
+	double doubles[MAX_ELEMS];
+	char *strings[MAX_ELEMS];
+	size_t token_lens[MAX_ELEMS];
+} Collected;
+
+static char path[] = "/tmp/test_util_load_XXXXXX";
+
+/**
+ * @brief Creates a temporary file with the given contents, whose path is stored in path.
+ */
+static void write_file(const char *contents)
+{
+	strcpy(path + strlen(path) - 6, "XXXXXX");
+	int fd = mkstemp(path);
+	ck_assert(fd >= 0);
+	ck_assert(write(fd, contents, strlen(contents)) == (ssize_t) strlen(contents));
+	close(fd);
+}
+
+static ErrStatus collect_int(void *elem, void *ctx)
+{
+	Collected *c = ctx;
+
+	if (c->count == c->limit) {
+		return E_INVALID_OP;
+	}
+	c->ints[c->count++] = *(int *) elem;
+
+	return E_SUCCESS;
+}
+
+static ErrStatus collect_double(void *elem, void *ctx)
+{
+	Collected *c = ctx;
+
+	c->doubles[c->count++] = *(double *) elem;
+
+	return E_SUCCESS;
+}
+
+static ErrStatus collect_string(void *elem, void *ctx)
+{
+	Collected *c = ctx;
+
+	c->strings[c->count++] = elem;
+
+	return E_SUCCESS;
+}
+
+static ErrStatus collect_token(const char *token, size_t len, void *ctx)
+{
+	Collected *c = ctx;
+
+	c->token_lens[c->count++] = len;
+	(void) token;
+
+	return E_SUCCESS;
+}
+
+/* SECTION - Tests */
+
+START_TEST(test_map_file)
+{
+	MappedFile file;
+
+	write_file("Hello mapped world");
+	ck_assert(util_mappedFile_open(&file, path) == E_SUCCESS);
+	ck_assert(file.len == 18);
+	ck_assert(memcmp(file.data, "Hello mapped world", 18) == 0);
+
+	util_mappedFile_close(&file);
+	ck_assert(file.data == NULL && file.len == 0);
+	util_mappedFile_close(NULL);
+	unlink(path);
+}
+
+END_TEST
+
+START_TEST(test_tokenize)
+{
+	MappedFile file;
+	Collected c = {0};
+
+	write_file("  a bb\n\n\tccc,dddd  ");
+	ck_assert(util_mappedFile_open(&file, path) == E_SUCCESS);
+
+	ck_assert(util_mappedFile_tokenize(&file, NULL, collect_token, &c) == E_SUCCESS);
+	ck_assert(c.count == 3);
+	ck_assert(c.token_lens[0] == 1 && c.token_lens[1] == 2 && c.token_lens[2] == 8);
+
+	c.count = 0;
+	ck_assert(util_mappedFile_tokenize(&file, " \n\t,", collect_token, &c) == E_SUCCESS);
+	ck_assert(c.count == 4);
+	ck_assert(c.token_lens[2] == 3 && c.token_lens[3] == 4);
+
+	util_mappedFile_close(&file);
+	unlink(path);
+}
+
+END_TEST
+
+START_TEST(test_load_parsed_ints)
+{
+	Collected c          = {.limit = MAX_ELEMS};
+	const int expected[] = {1, -22, 333, 4444};
+	int elem;
+	size_t offsets[2];
+	ParseStats stats = {.error_offsets = offsets, .error_capacity = 2};
+
+	write_file("1 -22\nx 333\r\n\n4444 y");
+	ck_assert(util_loadParsed(path, NULL, util_int_parse, &elem, collect_int, &c, &stats) == E_SUCCESS);
+	ck_assert(c.count == 4);
+	ck_assert(memcmp(c.ints, expected, sizeof(expected)) == 0);
+	ck_assert(stats.count == 6);
+	ck_assert(stats.errors == 2);
+	ck_assert(offsets[0] == 6 && offsets[1] == 19);
+	ck_assert(stats.consumed == 20);
+	unlink(path);
+}
+
+END_TEST
+
+START_TEST(test_load_parsed_partial_tokens)
+{
+	Collected c = {.limit = MAX_ELEMS};
+	int elem;
+	size_t offsets[2];
+	ParseStats stats = {.error_offsets = offsets, .error_capacity = 2};
+
+	write_file("12abc 7 1.5");
+	ck_assert(util_loadParsed(path, NULL, util_int_parse, &elem, collect_int, &c, &stats) == E_SUCCESS);
+	ck_assert(c.count == 1 && c.ints[0] == 7);
+	ck_assert(stats.count == 3);
+	ck_assert(stats.errors == 2);
+	ck_assert(offsets[0] == 0 && offsets[1] == 8);
+	unlink(path);
+}
+
+END_TEST
+
+START_TEST(test_load_parsed_doubles)
+{
+	Collected c = {0};
+	double elem;
+
+	write_file("1.5;-2e3;.25;1e-3");
+	ck_assert(util_loadParsed(path, ";", util_double_parse, &elem, collect_double, &c, NULL) == E_SUCCESS);
+	ck_assert(c.count == 4);
+	ck_assert(c.doubles[0] == 1.5 && c.doubles[1] == -2000 && c.doubles[2] == 0.25 && c.doubles[3] == 0.001);
+	unlink(path);
+}
+
+END_TEST
+
+START_TEST(test_load_elems)
+{
+	Collected c      = {0};
+	ParseStats stats = {0};
+
+	write_file("alpha beta\ngamma");
+	ck_assert(util_loadElems(path, NULL, util_string_fromString, collect_string, &c, &stats) == E_SUCCESS);
+	ck_assert(c.count == 3);
+	ck_assert(strcmp(c.strings[0], "alpha") == 0);
+	ck_assert(strcmp(c.strings[1], "beta") == 0);
+	ck_assert(strcmp(c.strings[2], "gamma") == 0);
+	ck_assert(stats.count == 3 && stats.errors == 0);
+
+	for (size_t i = 0; i < c.count; i++) {
+		free(c.strings[i]);
+	}
+	unlink(path);
+}
+
+END_TEST
+
+START_TEST(test_load_elems_long_token)
+{
+	/* Tokens longer than the internal stack buffer */
+	Collected c = {0};
+	char contents[2000];
+
+	memset(contents, 'z', sizeof(contents) - 1);
+	contents[sizeof(contents) - 1] = '\0';
+	contents[10]                   = ' ';
+
+	write_file(contents);
+	ck_assert(util_loadElems(path, NULL, util_string_fromString, collect_string, &c, NULL) == E_SUCCESS);
+	ck_assert(c.count == 2);
+	ck_assert(strlen(c.strings[0]) == 10);
+	ck_assert(strlen(c.strings[1]) == sizeof(contents) - 12);
+
+	free(c.strings[0]);
+	free(c.strings[1]);
+	unlink(path);
+}
+
+END_TEST
+
+START_TEST(test_load_page_sized_file)
+{
+	/* The last token ends exactly at the end of the mapping */
+	Collected c    = {.limit = MAX_ELEMS};
+	long page      = sysconf(_SC_PAGESIZE);
+	char *contents = malloc(page + 1);
+	int elem;
+
+	ck_assert(contents != NULL);
+	memset(contents, ' ', page);
+	memcpy(contents + page - 3, "123", 3);
+	contents[page] = '\0';
+
+	write_file(contents);
+	ck_assert(util_loadParsed(path, NULL, util_int_parse, &elem, collect_int, &c, NULL) == E_SUCCESS);
+	ck_assert(c.count == 1 && c.ints[0] == 123);
+
+	free(contents);
+	unlink(path);
+}
+
+END_TEST
+
+START_TEST(test_load_empty_file)
+{
+	Collected c      = {.limit = MAX_ELEMS};
+	ParseStats stats = {0};
+	int elem;
+
+	write_file("");
+	ck_assert(util_loadParsed(path, NULL, util_int_parse, &elem, collect_int, &c, &stats) == E_SUCCESS);
+	ck_assert(c.count == 0 && stats.count == 0 && stats.consumed == 0);
+	unlink(path);
+}
+
+END_TEST
+
+START_TEST(test_load_stop)
+{
+	/* The consumer can stop loading */
+	Collected c      = {.limit = 2};
+	ParseStats stats = {0};
+	int elem;
+
+	write_file("10 20 30 40");
+	ck_assert(util_loadParsed(path, NULL, util_int_parse, &elem, collect_int, &c, &stats) == E_INVALID_OP);
+	ck_assert(c.count == 2);
+	ck_assert(stats.count == 3);
+	ck_assert(stats.consumed == 8);
+	unlink(path);
+}
+
+END_TEST
+
+START_TEST(test_load_missing_file)
+{
+	Collected c = {0};
+	int elem;
+
+	errno = 0;
+	ck_assert(util_loadParsed("/nonexistent/file", NULL, util_int_parse, &elem, collect_int, &c, NULL) ==
+			  E_INVALID_ARG);
+	ck_assert(errno == ENOENT);
+}
+
+END_TEST
+
+START_TEST(test_load_parallel)
+{
+	/* Large enough to be split in several chunks, with invalid tokens spread over the file */
+	const size_t num_values = 300000;
+	char *contents          = malloc(num_values * 12);
+	size_t len              = 0;
+	size_t offsets[4];
+	ParseStats stats = {.error_offsets = offsets, .error_capacity = 4};
+	size_t expected_offsets[4];
+	size_t errors = 0;
+	int *elems;
+	size_t n;
+
+	ck_assert(contents != NULL);
+	for (size_t i = 0; i < num_values; i++) {
+		if (i % 100000 == 50000) {
+			expected_offsets[errors++] = len;
+			len += (size_t) sprintf(contents + len, "bad ");
+		}
+		if (i == 250000) {
+			expected_offsets[errors++] = len;
+			len += (size_t) sprintf(contents + len, "12abc ");
+		}
+		len += (size_t) sprintf(contents + len, "%d%c", (int) (i * 7919) - 1000000, i % 8 == 7 ? '\n' : ' ');
+	}
+
+	write_file(contents);
+	ck_assert(util_loadParallel(path, NULL, util_int_parse, sizeof(int), 4, (void **) &elems, &n, &stats) ==
+			  E_SUCCESS);
+	ck_assert(n == num_values);
+	for (size_t i = 0; i < num_values; i++) {
+		ck_assert(elems[i] == (int) (i * 7919) - 1000000);
+	}
+	ck_assert(stats.count == num_values + errors);
+	ck_assert(stats.errors == errors);
+	ck_assert(memcmp(offsets, expected_offsets, errors * sizeof(size_t)) == 0);
+	ck_assert(stats.consumed == len);
+	free(elems);
+
+	/* Default number of threads */
+	ck_assert(util_loadParallel(path, NULL, util_int_parse, sizeof(int), 0, (void **) &elems, &n, NULL) ==
+			  E_SUCCESS);
+	ck_assert(n == num_values);
+	ck_assert(elems[num_values - 1] == (int) ((num_values - 1) * 7919) - 1000000);
+	free(elems);
+
+	free(contents);
+	unlink(path);
+}
+
+END_TEST
+
+START_TEST(test_load_parallel_small)
+{
+	double *elems;
+	size_t n;
+
+	write_file("1.5,2.5\n-3e2");
+	ck_assert(util_loadParallel(path, ",", util_double_parse, sizeof(double), 8, (void **) &elems, &n, NULL) ==
+			  E_SUCCESS);
+	ck_assert(n == 3);
+	ck_assert(elems[0] == 1.5 && elems[1] == 2.5 && elems[2] == -300);
+	free(elems);
+	unlink(path);
+
+	int *ints;
+	ParseStats stats = {0};
+
+	write_file("1 1.5\n2");
+	ck_assert(util_loadParallel(path, NULL, util_int_parse, sizeof(int), 8, (void **) &ints, &n, &stats) ==
+			  E_SUCCESS);
+	ck_assert(n == 2 && ints[0] == 1 && ints[1] == 2);
+	ck_assert(stats.count == 3 && stats.errors == 1);
+	free(ints);
+	unlink(path);
+
+	write_file("");
+	ck_assert(util_loadParallel(path, NULL, util_double_parse, sizeof(double), 8, (void **) &elems, &n, NULL) ==
+			  E_SUCCESS);
+	ck_assert(n == 0 && elems == NULL);
+	unlink(path);
+}
+
+END_TEST
+
+#ifndef NDEBUG
+START_TEST(test_load_null_path)
+{
+	int elem;
+	util_loadParsed(NULL, NULL, util_int_parse, &elem, collect_int, NULL, NULL);
+}
+#endif
+
+END_TEST
+
+/* !SECTION */
+
+Suite *load_suite_create(void)
+{
+	Suite *s;
+	TCase *core;
+	TCase *limits;
+	TCase *invalid;
+	TCase *signal_invalid;
+
+	s = suite_create("File loading functions");
+
+	core = tcase_create(CASE_CORE);
+	tcase_add_test(core, test_map_file);
+	tcase_add_test(core, test_tokenize);
+	tcase_add_test(core, test_load_parsed_ints);
+	tcase_add_test(core, test_load_parsed_doubles);
+	tcase_add_test(core, test_load_elems);
+	tcase_add_test(core, test_load_parallel);
+
+	limits = tcase_create(CASE_LIMITS);
+	tcase_add_test(limits, test_load_elems_long_token);
+	tcase_add_test(limits, test_load_page_sized_file);
+	tcase_add_test(limits, test_load_empty_file);
+	tcase_add_test(limits, test_load_stop);
+	tcase_add_test(limits, test_load_parallel_small);
+
+	invalid = tcase_create(CASE_INVALID);
+	tcase_add_test(invalid, test_load_missing_file);
+	tcase_add_test(invalid, test_load_parsed_partial_tokens);
+
+	signal_invalid = tcase_create(CASE_SIGNAL_INVALID);
+#ifndef NDEBUG
+	tcase_add_test_raise_signal(signal_invalid, test_load_null_path, SIGABRT);
+#endif
+	tcase_set_tags(signal_invalid, NO_FORK_TAG);
+
+	suite_add_tcase(s, core);
+	suite_add_tcase(s, limits);
+	suite_add_tcase(s, invalid);
+	suite_add_tcase(s, signal_invalid);
+
+	return s;
+}
+
+int main(void)
+{
+	MAIN_RUNNER(load_suite_create);
+}
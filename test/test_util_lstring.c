@@ -0,0 +1,237 @@
+#include "lstring.h"
+#include "test_macros.h"
+#include "utilities.h"
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char *strings[] = {"", "a", "ab", "abc", "b", "hello world", "exactly 15 char",
+								"sixteen chars ok", "a much longer string stored out of line"};
+
+#define NUM_STRINGS (sizeof(strings) / sizeof(strings[0]))
+
+/* SECTION - Tests */
+
+START_TEST(test_lstring_init)
+{
+	LString s;
+
+	for (size_t i = 0; i < NUM_STRINGS; i++) {
+		size_t len = strlen(strings[i]);
+
+		ck_assert(util_lString_init(&s, strings[i], len) == E_SUCCESS);
+		ck_assert(s.len == len);
+		ck_assert_str_eq(util_lString_str(&s), strings[i]);
+		ck_assert(util_lString_str(&s) != strings[i]);
+		ck_assert((util_lString_str(&s) == s.data.sso) == (len <= UTIL_LSTRING_SSO_CAP));
+		util_lString_destroy(&s);
+		ck_assert(s.len == 0);
+	}
+
+	/* Not null-terminated input and embedded null bytes */
+	ck_assert(util_lString_init(&s, "a\0b!", 3) == E_SUCCESS);
+	ck_assert(s.len == 3 && memcmp(util_lString_str(&s), "a\0b", 4) == 0);
+	util_lString_destroy(&s);
+
+	ck_assert(util_lString_init(&s, NULL, 0) == E_SUCCESS);
+	ck_assert_str_eq(util_lString_str(&s), "");
+	util_lString_destroy(&s);
+	util_lString_destroy(NULL);
+}
+
+END_TEST
+
+START_TEST(test_lstring_cmp)
+{
+	/* Same order as util_string_cmp */
+	for (size_t i = 0; i < NUM_STRINGS; i++) {
+		LString *si = util_lString_fromString(strings[i]);
+		ck_assert(si != NULL);
+
+		for (size_t j = 0; j < NUM_STRINGS; j++) {
+			LString *sj = util_lString_fromString(strings[j]);
+			ck_assert(sj != NULL);
+
+			int expected = util_string_cmp(strings[i], strings[j]);
+			int actual   = util_lString_cmp(si, sj);
+			ck_assert((expected > 0) == (actual > 0) && (expected < 0) == (actual < 0));
+			ck_assert(util_lString_equal(si, sj) == (expected == 0));
+
+			util_lString_free(sj);
+		}
+
+		ck_assert(util_lString_cmp(NULL, si) < 0);
+		ck_assert(util_lString_cmp(si, NULL) > 0);
+		ck_assert(!util_lString_equal(si, NULL));
+		util_lString_free(si);
+	}
+
+	ck_assert(util_lString_cmp(NULL, NULL) == 0);
+	ck_assert(util_lString_equal(NULL, NULL));
+}
+
+END_TEST
+
+START_TEST(test_lstring_hash)
+{
+	LString *a = util_lString_fromString("some key");
+	LString *b = util_lString_fromString("some key");
+	LString *c = util_lString_fromString("some kez");
+
+	ck_assert(a != NULL && b != NULL && c != NULL);
+	ck_assert(a->hash == 0);
+
+	uint64_t h = util_lString_hash(a);
+	ck_assert(h != 0 && a->hash == h);
+	ck_assert(util_lString_hash(a) == h);
+	ck_assert(util_lString_hash(b) == h);
+	ck_assert(util_lString_hash(c) != h);
+
+	/* Cached hashes still compare equal strings */
+	ck_assert(util_lString_equal(a, b));
+	ck_assert(!util_lString_equal(a, c));
+
+	util_lString_free(a);
+	util_lString_free(b);
+	util_lString_free(c);
+	ck_assert(util_lString_hash(NULL) == 0);
+	ck_assert(UTIL_TYPE_LSTRING.hash == util_lString_hash);
+}
+
+END_TEST
+
+START_TEST(test_lstring_sort_key)
+{
+	/* Increasing order, with null bytes */
+	static const char *const chars[] = {"", "\0", "\0\0", "\0\x01", "a", "a\0", "a\0b", "a\x01", "ab"};
+	static const size_t lens[]       = {0, 1, 2, 2, 1, 2, 3, 2, 2};
+	unsigned char keys[9][16];
+	size_t key_lens[9];
+	LString s;
+
+	for (size_t i = 0; i < 9; i++) {
+		ck_assert(util_lString_init(&s, chars[i], lens[i]) == E_SUCCESS);
+		key_lens[i] = util_lString_sortKey(keys[i], sizeof(keys[i]), &s);
+		ck_assert(util_lString_sortKey(NULL, 0, &s) == key_lens[i]);
+		util_lString_destroy(&s);
+	}
+
+	for (size_t i = 1; i < 9; i++) {
+		ck_assert_msg(util_compareKeys(keys[i - 1], key_lens[i - 1], keys[i], key_lens[i]) < 0, "i = %zu", i);
+	}
+	ck_assert(key_lens[8] == 5 && memcmp(keys[8], "\x01" "ab\0\0", 5) == 0);
+	ck_assert(key_lens[1] == 5 && memcmp(keys[1], "\x01\0\xff\0\0", 5) == 0);
+	ck_assert(util_lString_sortKey(NULL, 0, NULL) == 1);
+	ck_assert(UTIL_TYPE_LSTRING.sortKey == util_lString_sortKey);
+}
+
+END_TEST
+
+START_TEST(test_lstring_to_string)
+{
+	char buf[8];
+
+	for (size_t i = 0; i < NUM_STRINGS; i++) {
+		LString *s = util_lString_fromString(strings[i]);
+		char *str  = util_lString_toString(s);
+
+		ck_assert_str_eq(str, strings[i]);
+		ck_assert(util_lString_toBuffer(buf, sizeof(buf), s) == (int) strlen(strings[i]));
+		ck_assert(strncmp(buf, strings[i], sizeof(buf) - 1) == 0);
+
+		free(str);
+		util_lString_free(s);
+	}
+
+	ck_assert(util_lString_toString(NULL) == NULL);
+	ck_assert(util_lString_toBuffer(buf, sizeof(buf), NULL) < 0);
+}
+
+END_TEST
+
+START_TEST(test_lstring_print)
+{
+	char *out;
+	size_t size;
+	FILE *file = open_memstream(&out, &size);
+	LString *s = util_lString_fromString("hello world");
+
+	ck_assert(file != NULL && s != NULL);
+	ck_assert(util_lString_print(file, s) == 12);
+	ck_assert(util_lString_print(file, NULL) == 5);
+	fclose(file);
+
+	ck_assert_str_eq(out, "hello world null ");
+
+	free(out);
+	util_lString_free(s);
+}
+
+END_TEST
+
+START_TEST(test_lstring_parse)
+{
+	const char *buf = "abc,def";
+	const char *end;
+	LString s;
+
+	ck_assert(util_lString_parse(buf, 3, &s, &end) == E_SUCCESS);
+	ck_assert(end == buf + 3);
+	ck_assert_str_eq(util_lString_str(&s), "abc");
+	util_lString_destroy(&s);
+
+	util_lString_free(NULL);
+}
+
+END_TEST
+
+#ifndef NDEBUG
+START_TEST(test_lstring_null_string)
+{
+	util_lString_fromString(NULL);
+}
+#endif
+
+END_TEST
+
+/* !SECTION */
+
+Suite *lstring_suite_create(void)
+{
+	Suite *s;
+	TCase *core;
+	TCase *limits;
+	TCase *signal_invalid;
+
+	s = suite_create("Length-prefixed strings");
+
+	core = tcase_create(CASE_CORE);
+	tcase_add_test(core, test_lstring_init);
+	tcase_add_test(core, test_lstring_cmp);
+	tcase_add_test(core, test_lstring_hash);
+	tcase_add_test(core, test_lstring_sort_key);
+	tcase_add_test(core, test_lstring_to_string);
+	tcase_add_test(core, test_lstring_print);
+
+	limits = tcase_create(CASE_LIMITS);
+	tcase_add_test(limits, test_lstring_parse);
+
+	signal_invalid = tcase_create(CASE_SIGNAL_INVALID);
+#ifndef NDEBUG
+	tcase_add_test_raise_signal(signal_invalid, test_lstring_null_string, SIGABRT);
+#endif
+	tcase_set_tags(signal_invalid, NO_FORK_TAG);
+
+	suite_add_tcase(s, core);
+	suite_add_tcase(s, limits);
+	suite_add_tcase(s, signal_invalid);
+
+	return s;
+}
+
+int main(void)
+{
+	MAIN_RUNNER(lstring_suite_create);
+}
@@ -0,0 +1,697 @@
+#include "parse.h"
+#include "test_macros.h"
+#include "utilities.h"
+
+#include <errno.h>
+#include <limits.h>
+#include <locale.h>
+#include <math.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/**
+ * @brief Checks that a function gives the same value, end pointer and errno as strtol().
+ */
+#define test_like_strtol(fn, type, str)                \
+	char *end1, *end2;                                 \
+	errno      = 0;                                    \
+	long l     = strtol(str, &end1, 10);               \
+	int error1 = errno;                                \
+	errno      = 0;                                    \
+	type v     = fn(str, &end2);                       \
+	ck_assert_msg((long) v == l, "Parsing %s", str);   \
+	ck_assert_msg(end1 == end2, "Parsing %s", str);    \
+	ck_assert_msg(errno == error1, "Parsing %s", str);
+
+/**
+ * @brief Checks that util_strtod() gives the same value (bit for bit), end pointer and errno as strtod().
+ */
+#define test_like_strtod(str)                          \
+	char *end1, *end2;                                 \
+	errno      = 0;                                    \
+	double d1  = strtod(str, &end1);                   \
+	int error1 = errno;                                \
+	errno      = 0;                                    \
+	double d2  = util_strtod(str, &end2);              \
+	ck_assert_msg(memcmp(&d1, &d2, sizeof(d1)) == 0 || (isnan(d1) && isnan(d2)), \
+				  "Parsing %s", str);                  \
+	ck_assert_msg(end1 == end2, "Parsing %s", str);    \
+	ck_assert_msg(errno == error1, "Parsing %s", str);
+
+static const char *long_strings[] = {
+	"0",
+	"-0",
+	"+0",
+	"7",
+	"-7",
+	"12345",
+	"12345678",
+	"123456789",
+	"-1234567890123456",
+	"  \t\n\v\f\r42",
+	"00000000000000000000000000012",
+	"-0000000000000000000000000009223372036854775808",
+	"9223372036854775807",
+	"-9223372036854775808",
+	"12345qwerty",
+	"123qwerty45",
+	"1234567812345678x",
+	"+-1",
+	"",
+	"-",
+	"+",
+	"   ",
+	" - 1",
+	"qwerty12345",
+	"0x1F",
+	"1e5",
+	"12.5",
+};
+
+static const char *long_overflows[] = {
+	"9223372036854775808",
+	"-9223372036854775809",
+	"99999999999999999999",
+	"18446744073709551616",
+	"-123456789012345678901234567890",
+};
+
+static const char *int_overflows[] = {
+	"2147483648",
+	"-2147483649",
+	"9999999999",
+	"9223372036854775808",
+};
+
+static const char *double_strings[] = {
+	"0",
+	"-0",
+	"0.0",
+	"-0.000e5",
+	"1",
+	"1.5",
+	"-1.5",
+	".5",
+	"5.",
+	"  \t\n3.25",
+	"0.1",
+	"0.3",
+	"3.141592653589793",
+	"2.718281828459045235360287471352662497757",
+	"123456789012345678901234567890",
+	"0.000000000000000000000000000001234",
+	"9007199254740993",
+	"9007199254740992.5",
+	"4503599627370496.5",
+	"1e22",
+	"1e23",
+	"8.98846567431158e307",
+	"1.7976931348623157e308",
+	"2.2250738585072014e-308",
+	"1.5e-300",
+	"7.2057594037927933e+16",
+	"1E10",
+	"1e",
+	"1e+",
+	"1e-x",
+	"1.5abc",
+	"1,5",
+	"12.34.56",
+	"00000000000000000000001.5",
+	"",
+	"-",
+	".",
+	"-.e1",
+	"e5",
+	"abc",
+	"0x1p-2",
+	"-0X1.8",
+	"inf",
+	"-Infinity",
+	"nan",
+	"NAN(123)",
+	"4.9e-324",
+	"2.4703282292062328e-324",
+};
+
+static const char *double_overflows[] = {
+	"1e309",
+	"-1.7976931348623159e308",
+	"1e100000000000",
+	"1e-400",
+	"-1e-100000000000",
+};
+
+#define NUM_OF_DOUBLE_STRINGS   (sizeof(double_strings) / sizeof(*double_strings))
+#define NUM_OF_DOUBLE_OVERFLOWS (sizeof(double_overflows) / sizeof(*double_overflows))
+#define NUM_OF_LONG_STRINGS   (sizeof(long_strings) / sizeof(*long_strings))
+#define NUM_OF_LONG_OVERFLOWS (sizeof(long_overflows) / sizeof(*long_overflows))
+#define NUM_OF_INT_OVERFLOWS  (sizeof(int_overflows) / sizeof(*int_overflows))
+
+/* SECTION - Tests */
+
+START_TEST(test_strtol)
+{
+	test_like_strtol(util_strtol, long, long_strings[_i]);
+}
+
+END_TEST
+
+START_TEST(test_strtoi)
+{
+	/* Same as strtol(), with values outside of the range of int clamped */
+	const char *str = long_strings[_i];
+	char *end1, *end2;
+
+	long l = strtol(str, &end1, 10);
+	errno  = 0;
+	int v  = util_strtoi(str, &end2);
+
+	if (l > INT_MAX || l < INT_MIN) {
+		ck_assert(v == (l > 0 ? INT_MAX : INT_MIN));
+		ck_assert(errno == ERANGE);
+	} else {
+		ck_assert(v == l);
+		ck_assert(errno == 0);
+	}
+	ck_assert(end1 == end2);
+}
+
+END_TEST
+
+START_TEST(test_strtol_overflow)
+{
+	test_like_strtol(util_strtol, long, long_overflows[_i]);
+	ck_assert(errno == ERANGE);
+}
+
+END_TEST
+
+START_TEST(test_strtoi_overflow)
+{
+	const char *str = int_overflows[_i];
+	char *end;
+
+	errno = 0;
+	int v = util_strtoi(str, &end);
+	ck_assert(errno == ERANGE);
+	ck_assert(v == (str[0] == '-' ? INT_MIN : INT_MAX));
+	ck_assert(end == str + strlen(str));
+}
+
+END_TEST
+
+START_TEST(test_strtoi_limits)
+{
+	char str[64];
+	char *end;
+
+	snprintf(str, sizeof(str), "%d", INT_MAX);
+	ck_assert(util_strtoi(str, &end) == INT_MAX);
+	snprintf(str, sizeof(str), "%d", INT_MIN);
+	ck_assert(util_strtoi(str, &end) == INT_MIN);
+	ck_assert(util_strtoi(str, NULL) == INT_MIN);
+}
+
+END_TEST
+
+START_TEST(test_strtol_random)
+{
+	char str[64];
+	unsigned long state = 0x2545F4914F6CDD1DUL;
+
+	for (int i = 0; i < 10000; i++) {
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		snprintf(str, sizeof(str), "%ld", (long) state >> (state % 64));
+
+		test_like_strtol(util_strtol, long, str);
+	}
+}
+
+END_TEST
+
+START_TEST(test_strtol_page_boundary)
+{
+	/* Numbers that end right before an inaccessible page must not fault */
+	long page = sysconf(_SC_PAGESIZE);
+	char *mem = mmap(NULL, 2 * page, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+	ck_assert(mem != MAP_FAILED);
+	ck_assert(mprotect(mem + page, page, PROT_NONE) == 0);
+
+	for (int n = 1; n <= 16; n++) {
+		char *str = mem + page - n - 1;
+		memset(str, '1', n);
+		str[n] = '\0';
+
+		test_like_strtol(util_strtol, long, str);
+	}
+
+	munmap(mem, 2 * page);
+}
+
+END_TEST
+
+START_TEST(test_strtod)
+{
+	test_like_strtod(double_strings[_i]);
+}
+
+END_TEST
+
+START_TEST(test_strtod_overflow)
+{
+	test_like_strtod(double_overflows[_i]);
+	ck_assert(errno == ERANGE);
+}
+
+END_TEST
+
+START_TEST(test_strtod_random)
+{
+	char str[64];
+	unsigned long state = 0x2545F4914F6CDD1DUL;
+
+	for (int i = 0; i < 10000; i++) {
+		double d;
+
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		memcpy(&d, &state, sizeof(d));
+		snprintf(str, sizeof(str), "%.*g", (int) (state % 18) + 1, d);
+
+		test_like_strtod(str);
+	}
+}
+
+END_TEST
+
+START_TEST(test_strtod_locale)
+{
+	/* The decimal separator is always '.', whatever the locale */
+	const char *locales[] = {"de_DE.UTF-8", "fr_FR.UTF-8", "de_DE", "fr_FR"};
+	char *end;
+
+	for (size_t i = 0; i < sizeof(locales) / sizeof(*locales); i++) {
+		if (setlocale(LC_NUMERIC, locales[i])) {
+			break;
+		}
+	}
+
+	ck_assert(util_strtod("1.5", &end) == 1.5);
+	ck_assert(*end == '\0');
+	ck_assert(util_strtod("1,5", &end) == 1.0);
+	ck_assert(*end == ',');
+	ck_assert(util_strtod("1.5e-330", &end) == 0.0); // Handled by strtod()
+	ck_assert(*end == '\0');
+
+	setlocale(LC_NUMERIC, "C");
+}
+
+END_TEST
+
+START_TEST(test_strtod_page_boundary)
+{
+	long page = sysconf(_SC_PAGESIZE);
+	char *mem = mmap(NULL, 2 * page, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+	ck_assert(mem != MAP_FAILED);
+	ck_assert(mprotect(mem + page, page, PROT_NONE) == 0);
+
+	for (int n = 3; n <= 24; n++) {
+		char *str = mem + page - n - 1;
+		memset(str, '3', n);
+		str[n / 2] = '.';
+		str[n]     = '\0';
+
+		test_like_strtod(str);
+	}
+
+	munmap(mem, 2 * page);
+}
+
+END_TEST
+
+START_TEST(test_parse_long_bounded)
+{
+	/* Only the first len bytes are part of the field */
+	const char *csv = "12345,-678,,99999999999 ,x";
+	const char *end;
+	long l = 0;
+
+	ck_assert(util_parseLong(csv, 3, LONG_MIN, LONG_MAX, &l, &end) == E_SUCCESS);
+	ck_assert(l == 123 && end == csv + 3);
+	ck_assert(util_parseLong(csv + 6, 4, LONG_MIN, LONG_MAX, &l, &end) == E_SUCCESS);
+	ck_assert(l == -678 && end == csv + 10);
+
+	l = 7;
+	ck_assert(util_parseLong(csv + 11, 0, LONG_MIN, LONG_MAX, &l, &end) == E_INVALID_ARG);
+	ck_assert(l == 7 && end == csv + 11);
+	ck_assert(util_parseLong(csv + 12, 12, INT_MIN, INT_MAX, &l, &end) == E_OUT_OF_RANGE);
+	ck_assert(l == INT_MAX && end == csv + 23);
+	ck_assert(util_parseLong(csv + 25, 1, LONG_MIN, LONG_MAX, &l, NULL) == E_INVALID_ARG);
+}
+
+END_TEST
+
+START_TEST(test_parse_double_bounded)
+{
+	const char *csv = "1.25e3;-0.5e;1e999;inf;0x10;.;1234567890.0987654321e-3";
+	const char *end;
+	double d = 0;
+	int saved;
+
+	ck_assert(util_parseDouble(csv, 4, &d, &end) == E_SUCCESS);
+	ck_assert(d == 1.25 && end == csv + 4);
+	ck_assert(util_parseDouble(csv, 6, &d, &end) == E_SUCCESS);
+	ck_assert(d == 1250 && end == csv + 6);
+	ck_assert(util_parseDouble(csv + 7, 5, &d, &end) == E_SUCCESS);
+	ck_assert(d == -0.5 && end == csv + 11);
+
+	errno = 0;
+	ck_assert(util_parseDouble(csv + 13, 5, &d, &end) == E_OUT_OF_RANGE);
+	ck_assert(d == HUGE_VAL && end == csv + 18);
+	saved = errno;
+	ck_assert(saved == 0);
+
+	ck_assert(util_parseDouble(csv + 19, 3, &d, &end) == E_SUCCESS);
+	ck_assert(isinf(d) && end == csv + 22);
+	ck_assert(util_parseDouble(csv + 23, 2, &d, &end) == E_SUCCESS);
+	ck_assert(d == 0 && end == csv + 24); // "0x" without hexadecimal digits
+	ck_assert(util_parseDouble(csv + 23, 4, &d, &end) == E_SUCCESS);
+	ck_assert(d == 16 && end == csv + 27);
+
+	d = 7;
+	ck_assert(util_parseDouble(csv + 28, 1, &d, &end) == E_INVALID_ARG);
+	ck_assert(d == 7 && end == csv + 28);
+	ck_assert(util_parseDouble(csv + 30, 24, &d, &end) == E_SUCCESS);
+	ck_assert(d == 1234567.8900987654321 && end == csv + 54);
+}
+
+END_TEST
+
+START_TEST(test_parse_double_long_field)
+{
+	/* Fields that do not fit in the stack buffer used for strtod() */
+	char field[400];
+	const char *end;
+	double d;
+
+	memset(field, '0', sizeof(field));
+	field[0] = '0';
+	field[1] = '.';
+	memcpy(field + sizeof(field) - 4, "1e-3", 4);
+
+	ck_assert(util_parseDouble(field, sizeof(field), &d, &end) == E_OUT_OF_RANGE);
+	ck_assert(end == field + sizeof(field));
+
+	memcpy(field, "1.", 2);
+	ck_assert(util_parseDouble(field, sizeof(field), &d, &end) == E_SUCCESS);
+	ck_assert(d == 0.001 && end == field + sizeof(field));
+
+	/* Short numbers handed over to strtod() at the start of long buffers */
+	memset(field, ';', sizeof(field));
+	memcpy(field, " -0x1.8p+1;", 11);
+	ck_assert(util_parseDouble(field, sizeof(field), &d, &end) == E_SUCCESS);
+	ck_assert(d == -3 && end == field + 10);
+
+	memcpy(field, "nan(abc_1);", 11);
+	ck_assert(util_parseDouble(field, sizeof(field), &d, &end) == E_SUCCESS);
+	ck_assert(isnan(d) && end == field + 10);
+
+	memcpy(field, "nan(abc;", 8);
+	ck_assert(util_parseDouble(field, sizeof(field), &d, &end) == E_SUCCESS);
+	ck_assert(isnan(d) && end == field + 3);
+
+	memcpy(field, "-Infinity12", 11);
+	ck_assert(util_parseDouble(field, sizeof(field), &d, &end) == E_SUCCESS);
+	ck_assert(d == -INFINITY && end == field + 9);
+}
+
+END_TEST
+
+START_TEST(test_parse_page_boundary)
+{
+	/* Fields at the very end of a mapping, without null terminator */
+	long page = sysconf(_SC_PAGESIZE);
+	char *mem = mmap(NULL, 2 * page, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	const char *end;
+	long l;
+	double d;
+
+	ck_assert(mem != MAP_FAILED);
+	ck_assert(mprotect(mem + page, page, PROT_NONE) == 0);
+
+	for (int n = 1; n <= 24; n++) {
+		char *str = mem + page - n;
+		memset(str, '7', n);
+
+		ck_assert(util_parseLong(str, n, LONG_MIN, LONG_MAX, &l, &end) == (n <= 19 ? E_SUCCESS : E_OUT_OF_RANGE));
+		ck_assert(end == str + n);
+		ck_assert(util_parseDouble(str, n, &d, &end) == E_SUCCESS);
+		ck_assert(end == str + n);
+	}
+
+	memcpy(mem + page - 4, "1e-9", 4);
+	ck_assert(util_parseDouble(mem + page - 4, 4, &d, &end) == E_SUCCESS);
+	ck_assert(d == 1e-9);
+
+	munmap(mem, 2 * page);
+}
+
+END_TEST
+
+START_TEST(test_parse_types)
+{
+	const char *buf = "x 42 -1.5e2 field";
+	const char *end;
+	char c;
+	int i;
+	double d;
+	StringView sv;
+
+	ck_assert(util_char_parse(buf, 1, &c, &end) == E_SUCCESS);
+	ck_assert(c == 'x' && end == buf + 1);
+	ck_assert(util_int_parse(buf + 1, 3, &i, &end) == E_SUCCESS);
+	ck_assert(i == 42 && end == buf + 4);
+	ck_assert(util_double_parse(end, 7, &d, &end) == E_SUCCESS);
+	ck_assert(d == -150 && end == buf + 11);
+	ck_assert(util_stringView_parse(buf + 12, 5, &sv, &end) == E_SUCCESS);
+	ck_assert(sv.str == buf + 12 && sv.len == 5 && end == buf + 17);
+
+	ck_assert(util_char_parse(buf, 0, &c, &end) == E_INVALID_ARG);
+	ck_assert(end == buf);
+	ck_assert(util_int_parse(buf, 4, &i, &end) == E_INVALID_ARG);
+	ck_assert(i == 42 && end == buf);
+	ck_assert(util_int_parse("3000000000", 10, &i, NULL) == E_OUT_OF_RANGE);
+	ck_assert(i == INT_MAX);
+	ck_assert(util_double_parse(buf + 12, 5, &d, NULL) == E_INVALID_ARG);
+	ck_assert(d == -150);
+}
+
+END_TEST
+
+START_TEST(test_parse_generic)
+{
+	/* The built-in parse functions are interchangeable */
+	const util_parse functions[] = {util_char_parse, util_int_parse, util_double_parse, util_stringView_parse};
+	const char *field = "64";
+	const char *end;
+	union {
+		char c;
+		int i;
+		double d;
+		StringView sv;
+	} out;
+
+	for (size_t j = 0; j < sizeof(functions) / sizeof(*functions); j++) {
+		ck_assert(functions[j](field, 2, &out, &end) == E_SUCCESS);
+		ck_assert(end == field + (j == 0 ? 1 : 2));
+	}
+}
+
+END_TEST
+
+START_TEST(test_parse_ints)
+{
+	const char *csv = "1,-22,333\r\n 4444 ,x,,5 6,99999999999\n7";
+	const int expected[] = {1, -22, 333, 4444, 0, 0, 0, INT_MAX, 7};
+	const size_t error_offsets[] = {18, 20, 21};
+	size_t offsets[3];
+	ParseStats stats = {.error_offsets = offsets, .error_capacity = 3};
+	int out[16];
+
+	ck_assert(util_parseInts(csv, strlen(csv), ',', out, 16, &stats) == 9);
+	ck_assert(stats.count == 9);
+	ck_assert(stats.errors == 4);
+	ck_assert(stats.consumed == strlen(csv));
+	ck_assert(memcmp(out, expected, sizeof(expected)) == 0);
+	ck_assert(memcmp(offsets, error_offsets, sizeof(error_offsets)) == 0);
+}
+
+END_TEST
+
+START_TEST(test_parse_ints_resume)
+{
+	/* Long fields and fields longer than a SIMD block, parsed in several calls */
+	const char *csv = "12345678901,1,                  2,3\n4\n";
+	int out[2];
+	ParseStats stats = {0};
+	size_t offset    = 0;
+
+	ck_assert(util_parseInts(csv, strlen(csv), ',', out, 2, &stats) == 2);
+	ck_assert(out[0] == INT_MAX && out[1] == 1);
+	ck_assert(stats.errors == 1);
+	offset += stats.consumed;
+
+	ck_assert(util_parseInts(csv + offset, strlen(csv) - offset, ',', out, 2, &stats) == 2);
+	ck_assert(out[0] == 2 && out[1] == 3);
+	ck_assert(stats.errors == 0);
+	offset += stats.consumed;
+
+	ck_assert(util_parseInts(csv + offset, strlen(csv) - offset, ',', out, 2, &stats) == 1);
+	ck_assert(out[0] == 4);
+	ck_assert(offset + stats.consumed == strlen(csv));
+
+	ck_assert(util_parseInts(csv, 0, ',', out, 2, &stats) == 0);
+	ck_assert(util_parseInts(csv, strlen(csv), ',', NULL, 0, NULL) == 0);
+}
+
+END_TEST
+
+START_TEST(test_parse_doubles)
+{
+	const char *tsv = "1.5\t-2e3\t1e999\n.25\tinf\t0x10\tabc\n3.14159265358979323846264338327950288";
+	const double expected[] = {1.5, -2000, HUGE_VAL, 0.25, INFINITY, 16, 0, 3.14159265358979323846264338327950288};
+	size_t offsets[1];
+	ParseStats stats = {.error_offsets = offsets, .error_capacity = 1};
+	double out[16];
+
+	ck_assert(util_parseDoubles(tsv, strlen(tsv), '\t', out, 16, &stats) == 8);
+	ck_assert(stats.errors == 2);
+	ck_assert(offsets[0] == 9);
+	ck_assert(memcmp(out, expected, sizeof(expected)) == 0);
+}
+
+END_TEST
+
+START_TEST(test_parse_doubles_random)
+{
+	/* Bulk parsing gives the same values as strtod() */
+	char buf[32 * 1000];
+	double out[1000];
+	size_t len          = 0;
+	unsigned long state = 0x2545F4914F6CDD1DUL;
+	ParseStats stats    = {0};
+
+	for (int i = 0; i < 1000; i++) {
+		double d;
+
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		memcpy(&d, &state, sizeof(d));
+		if (!isnormal(d)) {
+			d = i; // Subnormals underflow, which is reported as an error
+		}
+		len += snprintf(buf + len, 32, "%.17g;", d);
+	}
+
+	ck_assert(util_parseDoubles(buf, len, ';', out, 1000, &stats) == 1000);
+	ck_assert(stats.errors == 0);
+
+	const char *p = buf;
+	for (int i = 0; i < 1000; i++) {
+		char *end;
+		double d = strtod(p, &end);
+		ck_assert(memcmp(&d, &out[i], sizeof(d)) == 0);
+		p = end + 1;
+	}
+}
+
+END_TEST
+
+#ifndef NDEBUG
+START_TEST(test_strtol_null)
+{
+	util_strtol(NULL, NULL);
+}
+#endif
+
+END_TEST
+
+#ifndef NDEBUG
+START_TEST(test_strtod_null)
+{
+	util_strtod(NULL, NULL);
+}
+#endif
+
+END_TEST
+
+/* !SECTION */
+
+Suite *parse_suite_create(void)
+{
+	Suite *s;
+	TCase *core;
+	TCase *limits;
+	TCase *invalid;
+	TCase *signal_invalid;
+
+	s = suite_create("Number parsing functions");
+
+	core = tcase_create(CASE_CORE);
+	tcase_add_loop_test(core, test_strtol, 0, NUM_OF_LONG_STRINGS);
+	tcase_add_loop_test(core, test_strtoi, 0, NUM_OF_LONG_STRINGS);
+	tcase_add_test(core, test_strtol_random);
+	tcase_add_loop_test(core, test_strtod, 0, NUM_OF_DOUBLE_STRINGS);
+	tcase_add_test(core, test_strtod_random);
+	tcase_add_test(core, test_strtod_locale);
+	tcase_add_test(core, test_parse_long_bounded);
+	tcase_add_test(core, test_parse_double_bounded);
+	tcase_add_test(core, test_parse_types);
+	tcase_add_test(core, test_parse_generic);
+	tcase_add_test(core, test_parse_ints);
+	tcase_add_test(core, test_parse_doubles);
+	tcase_add_test(core, test_parse_doubles_random);
+
+	limits = tcase_create(CASE_LIMITS);
+	tcase_add_test(limits, test_strtoi_limits);
+	tcase_add_test(limits, test_strtol_page_boundary);
+	tcase_add_test(limits, test_strtod_page_boundary);
+	tcase_add_test(limits, test_parse_page_boundary);
+	tcase_add_test(limits, test_parse_double_long_field);
+	tcase_add_test(limits, test_parse_ints_resume);
+
+	invalid = tcase_create(CASE_INVALID);
+	tcase_add_loop_test(invalid, test_strtol_overflow, 0, NUM_OF_LONG_OVERFLOWS);
+	tcase_add_loop_test(invalid, test_strtoi_overflow, 0, NUM_OF_INT_OVERFLOWS);
+	tcase_add_loop_test(invalid, test_strtod_overflow, 0, NUM_OF_DOUBLE_OVERFLOWS);
+
+	signal_invalid = tcase_create(CASE_SIGNAL_INVALID);
+#ifndef NDEBUG
+	tcase_add_test_raise_signal(signal_invalid, test_strtol_null, SIGABRT);
+	tcase_add_test_raise_signal(signal_invalid, test_strtod_null, SIGABRT);
+#endif
+	tcase_set_tags(signal_invalid, NO_FORK_TAG);
+
+	suite_add_tcase(s, core);
+	suite_add_tcase(s, limits);
+	suite_add_tcase(s, invalid);
+	suite_add_tcase(s, signal_invalid);
+
+	return s;
+}
+
+int main(void)
+{
+	MAIN_RUNNER(parse_suite_create);
+}
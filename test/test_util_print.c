@@ -1,3 +1,4 @@
+#include "print.h"
 #include "test_macros.h"
 #include "utilities.h"
 
@@ -6,6 +7,7 @@
 #include <limits.h>
 #include <signal.h>
 #include <stdlib.h>
+#include <string.h>
 
 #define test_print(msg, fn, ptr)     \
 	printf(msg);                     \
@@ -14,6 +16,17 @@
 
 #define NUM_OF_FN 5
 
+#define test_print_array(print_fn, expected)                    \
+	FILE *tmp = tmpfile();                                      \
+	char out[256];                                              \
+	ck_assert(tmp != NULL);                                     \
+	ck_assert(print_fn == (ssize_t) strlen(expected));          \
+	fflush(tmp);                                                \
+	rewind(tmp);                                                \
+	out[fread(out, sizeof(char), sizeof(out) - 1, tmp)] = '\0'; \
+	ck_assert_str_eq(out, expected);                            \
+	fclose(tmp);
+
 static const util_print functions[NUM_OF_FN] = {
 	util_generic_print,
 	util_char_print,
@@ -108,6 +121,72 @@ START_TEST(test_string_print)
 
 END_TEST
 
+START_TEST(test_print_array)
+{
+	int values[]         = { 1, -20, 300 };
+	const void *elems[]  = { &values[0], &values[1], NULL, &values[2] };
+	const char *expected = "1 -20 null 300 ";
+
+	test_print_array(util_printArray(tmp, elems, 4, util_int_toBuffer), expected);
+}
+
+END_TEST
+
+START_TEST(test_print_array_fd)
+{
+	const void *elems[]  = { "Hello", "World", NULL };
+	const char *expected = "Hello World null ";
+
+	test_print_array(util_printArrayFd(fileno(tmp), elems, 3, util_string_toBuffer), expected);
+}
+
+END_TEST
+
+START_TEST(test_print_array_locked)
+{
+	double values[]      = { 0.5, -1e100 };
+	const void *elems[]  = { &values[0], NULL, &values[1] };
+	const char *expected = "0.5 null -1e+100 ";
+
+	test_print_array(util_printArrayLocked(tmp, elems, 3, util_double_toBuffer), expected);
+}
+
+END_TEST
+
+START_TEST(test_print_array_empty)
+{
+	test_print_array(util_printArray(tmp, NULL, 0, util_int_toBuffer), "");
+}
+
+END_TEST
+
+START_TEST(test_print_array_large)
+{
+	/* Elements larger than the internal buffers, and enough of them to need several flushes */
+	size_t len       = UTIL_PRINT_BUFSIZE + 10;
+	size_t n         = 5;
+	char *str        = malloc(len + 1);
+	const void **arr = malloc(n * sizeof(*arr));
+	FILE *tmp        = tmpfile();
+
+	ck_assert(str && arr && tmp);
+	memset(str, 'x', len);
+	str[len] = '\0';
+	for (size_t i = 0; i < n; i++) {
+		arr[i] = (i % 2) ? "y" : str;
+	}
+
+	ck_assert(util_printArray(tmp, arr, n, util_string_toBuffer) == (ssize_t) (3 * (len + 1) + 2 * 2));
+	ck_assert(util_printArrayLocked(tmp, arr, n, util_string_toBuffer) == (ssize_t) (3 * (len + 1) + 2 * 2));
+	ck_assert(ftell(tmp) == 2 * (long) (3 * (len + 1) + 2 * 2));
+
+	fclose(tmp);
+	free(arr);
+	free(str);
+}
+
+END_TEST
+
 #ifndef NDEBUG
 START_TEST(test_invalid_arg)
 {
@@ -134,12 +213,17 @@ Suite *print_suite_create(void)
 	tcase_add_test(core, test_int_print);
 	tcase_add_test(core, test_double_print);
 	tcase_add_test(core, test_string_print);
+	tcase_add_test(core, test_print_array);
+	tcase_add_test(core, test_print_array_fd);
+	tcase_add_test(core, test_print_array_locked);
 
 	edges = tcase_create(CASE_LIMITS);
 	tcase_add_loop_test(edges, test_print_null, 0, NUM_OF_FN);
 	tcase_add_test(edges, test_print_null);
 	tcase_add_test(edges, test_int_print_min_max);
 	tcase_add_test(edges, test_double_print_min_max);
+	tcase_add_test(edges, test_print_array_empty);
+	tcase_add_test(edges, test_print_array_large);
 
 	invalid_args = tcase_create(CASE_SIGNAL_INVALID);
 #ifndef NDEBUG // This test relies on the behavior of asserts
@@ -0,0 +1,272 @@
+#include "sink.h"
+#include "test_macros.h"
+#include "utilities.h"
+
+#include <float.h>
+#include <limits.h>
+#include <signal.h>
+#include <string.h>
+#include <unistd.h>
+
+#define NUM_OF_FN 5
+
+static const util_print print_functions[NUM_OF_FN] = {
+	util_generic_print,
+	util_char_print,
+	util_int_print,
+	util_double_print,
+	util_string_print
+};
+
+static const util_sinkPrint functions[NUM_OF_FN] = {
+	util_generic_sinkPrint,
+	util_char_sinkPrint,
+	util_int_sinkPrint,
+	util_double_sinkPrint,
+	util_string_sinkPrint
+};
+
+/**
+ * @brief Checks that a sink print function writes the same as its stream counterpart.
+ */
+static void test_same_output(util_print print, util_sinkPrint sink_print, const void *elem)
+{
+	Sink sink;
+	FILE *tmp = tmpfile();
+	char expected[256];
+	size_t len;
+
+	ck_assert(tmp != NULL);
+	ck_assert(util_sink_initMemory(&sink, 0) == E_SUCCESS);
+
+	int n = print(tmp, elem);
+	fflush(tmp);
+	rewind(tmp);
+	expected[fread(expected, sizeof(char), sizeof(expected) - 1, tmp)] = '\0';
+
+	ck_assert(sink_print(&sink, elem) == n);
+	const char *data = util_sink_memoryData(&sink, &len);
+	ck_assert(len == strlen(expected));
+	ck_assert(memcmp(data, expected, len) == 0);
+
+	util_sink_destroy(&sink);
+	fclose(tmp);
+}
+
+/* SECTION - Tests */
+
+START_TEST(test_memory_sink)
+{
+	Sink sink;
+	size_t len;
+
+	ck_assert(util_sink_initMemory(&sink, 4) == E_SUCCESS);
+	ck_assert(util_sink_write(&sink, "Hello", 5) == 5);
+	ck_assert(util_sink_write(&sink, ", World", 7) == 7);
+
+	const char *data = util_sink_memoryData(&sink, &len);
+	ck_assert(len == 12);
+	ck_assert(memcmp(data, "Hello, World", 12) == 0);
+
+	util_sink_destroy(&sink);
+}
+
+END_TEST
+
+START_TEST(test_file_sink)
+{
+	Sink sink;
+	FILE *tmp = tmpfile();
+	char buf[16];
+	int i = -42;
+
+	ck_assert(tmp != NULL);
+	util_sink_initFile(&sink, tmp);
+	ck_assert(util_int_sinkPrint(&sink, &i) == 4);
+	ck_assert(util_string_sinkPrint(&sink, "ok") == 3);
+
+	fflush(tmp);
+	rewind(tmp);
+	buf[fread(buf, sizeof(char), sizeof(buf) - 1, tmp)] = '\0';
+	ck_assert_str_eq(buf, "-42 ok ");
+
+	util_sink_destroy(&sink);
+	fclose(tmp);
+}
+
+END_TEST
+
+START_TEST(test_fd_sink)
+{
+	Sink sink;
+	int fds[2];
+	char buf[16];
+	char c = 'x';
+
+	ck_assert(pipe(fds) == 0);
+	util_sink_initFd(&sink, fds[1]);
+	ck_assert(util_char_sinkPrint(&sink, &c) == 2);
+	ck_assert(util_char_sinkPrint(&sink, NULL) == 5);
+	close(fds[1]);
+
+	ssize_t n = read(fds[0], buf, sizeof(buf) - 1);
+	ck_assert(n == 7);
+	buf[n] = '\0';
+	ck_assert_str_eq(buf, "x null ");
+
+	util_sink_destroy(&sink);
+	close(fds[0]);
+}
+
+END_TEST
+
+START_TEST(test_ring_sink)
+{
+	Sink sink;
+	char storage[8];
+	char buf[16];
+
+	util_sink_initRing(&sink, storage, sizeof(storage));
+	ck_assert(util_sink_write(&sink, "abcde", 5) == 5);
+	ck_assert(util_sink_ringRead(&sink, buf, 2) == 2);
+	ck_assert(memcmp(buf, "ab", 2) == 0);
+
+	/* Wraps around the end of the storage */
+	ck_assert(util_sink_write(&sink, "fghij", 5) == 5);
+	ck_assert(util_sink_ringRead(&sink, buf, sizeof(buf)) == 8);
+	ck_assert(memcmp(buf, "cdefghij", 8) == 0);
+	ck_assert(util_sink_ringRead(&sink, buf, sizeof(buf)) == 0);
+
+	util_sink_destroy(&sink);
+}
+
+END_TEST
+
+START_TEST(test_ring_sink_overwrite)
+{
+	Sink sink;
+	char storage[4];
+	char buf[16];
+
+	util_sink_initRing(&sink, storage, sizeof(storage));
+	ck_assert(util_sink_write(&sink, "abc", 3) == 3);
+	ck_assert(util_sink_write(&sink, "de", 2) == 2);
+	ck_assert(util_sink_ringRead(&sink, buf, sizeof(buf)) == 4);
+	ck_assert(memcmp(buf, "bcde", 4) == 0);
+
+	/* Larger than the whole buffer */
+	ck_assert(util_sink_write(&sink, "0123456789", 10) == 10);
+	ck_assert(util_sink_ringRead(&sink, buf, sizeof(buf)) == 4);
+	ck_assert(memcmp(buf, "6789", 4) == 0);
+
+	util_sink_destroy(&sink);
+}
+
+END_TEST
+
+START_TEST(test_sink_print_same_output)
+{
+	int val         = INT_MIN;
+	char c          = '?';
+	double d        = -DBL_MAX;
+	const void *p[] = { &val, &c, &val, &d, "Some string" };
+
+	test_same_output(print_functions[_i], functions[_i], p[_i]);
+}
+
+END_TEST
+
+START_TEST(test_sink_print_null)
+{
+	test_same_output(print_functions[_i], functions[_i], NULL);
+}
+
+END_TEST
+
+START_TEST(test_sink_print_long_string)
+{
+	char str[UTIL_PRIMITIVE_BUFSIZE * 4];
+
+	memset(str, 'a', sizeof(str) - 1);
+	str[sizeof(str) - 1] = '\0';
+
+	test_same_output(util_string_print, util_string_sinkPrint, str);
+}
+
+END_TEST
+
+/**
+ * @brief Custom sink backend that counts its write calls.
+ */
+static ssize_t counting_write(Sink *sink, const char *data, size_t len)
+{
+	(void) data;
+	(*(size_t *) sink->ctx)++;
+	return (ssize_t) len;
+}
+
+START_TEST(test_sink_print_single_write)
+{
+	char str[UTIL_PRIMITIVE_BUFSIZE * 4];
+	size_t writes = 0;
+	Sink sink     = { .write = counting_write, .ctx = &writes };
+
+	memset(str, 'a', sizeof(str) - 1);
+	str[sizeof(str) - 1] = '\0';
+
+	ck_assert(util_string_sinkPrint(&sink, str) == (int) sizeof(str));
+	ck_assert_uint_eq(writes, 1);
+}
+
+END_TEST
+
+#ifndef NDEBUG
+START_TEST(test_invalid_arg)
+{
+	functions[_i](NULL, NULL);
+}
+#endif
+
+END_TEST
+
+/* !SECTION */
+
+Suite *sink_suite_create(void)
+{
+	Suite *s;
+	TCase *core;
+	TCase *limits;
+	TCase *invalid_args;
+
+	s = suite_create("Sinks");
+
+	core = tcase_create(CASE_CORE);
+	tcase_add_test(core, test_memory_sink);
+	tcase_add_test(core, test_file_sink);
+	tcase_add_test(core, test_fd_sink);
+	tcase_add_test(core, test_ring_sink);
+	tcase_add_loop_test(core, test_sink_print_same_output, 0, NUM_OF_FN);
+
+	limits = tcase_create(CASE_LIMITS);
+	tcase_add_test(limits, test_ring_sink_overwrite);
+	tcase_add_loop_test(limits, test_sink_print_null, 0, NUM_OF_FN);
+	tcase_add_test(limits, test_sink_print_long_string);
+	tcase_add_test(limits, test_sink_print_single_write);
+
+	invalid_args = tcase_create(CASE_SIGNAL_INVALID);
+#ifndef NDEBUG // This test relies on the behavior of asserts
+	tcase_add_loop_test_raise_signal(invalid_args, test_invalid_arg, SIGABRT, 0, NUM_OF_FN);
+#endif
+	tcase_set_tags(invalid_args, NO_FORK_TAG);
+
+	suite_add_tcase(s, core);
+	suite_add_tcase(s, limits);
+	suite_add_tcase(s, invalid_args);
+
+	return s;
+}
+
+int main(void)
+{
+	MAIN_RUNNER(sink_suite_create);
+}
@@ -0,0 +1,946 @@
+#include "sort.h"
+#include "sort_template.h"
+#include "test_macros.h"
+#include "utilities.h"
+
+#include <float.h>
+#include <limits.h>
+#include <math.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief Sizes that cover the insertion sort, the introsort and the radix sorts.
+ */
+static const size_t sizes[] = {0, 1, 2, 3, 16, 17, 100, 255, 256, 1000, 20000};
+
+#define NUM_SIZES (sizeof(sizes) / sizeof(sizes[0]))
+
+/**
+ * @brief Element of size 12, which is not handled by any specialized path.
+ */
+typedef struct {
+	int key;
+	int pad[2];
+} Record;
+
+static uint64_t state = 88172645463325252ULL;
+
+static uint64_t next_rand(void)
+{
+	state ^= state << 13;
+	state ^= state >> 7;
+	state ^= state << 17;
+
+	return state;
+}
+
+/**
+ * @brief Fills an array of ints with a distribution selected by kind:
+ * random, few distinct values, sorted, reversed, or random with the extreme values.
+ */
+static void fill_ints(int *a, size_t n, int kind)
+{
+	for (size_t i = 0; i < n; i++) {
+		uint64_t r = next_rand();
+
+		if (kind == 0) {
+			a[i] = (int) (uint32_t) r;
+		} else if (kind == 1) {
+			a[i] = (int) (r % 5) - 2;
+		} else if (kind == 2) {
+			a[i] = (int) i;
+		} else if (kind == 3) {
+			a[i] = (int) (n - i);
+		} else {
+			a[i] = r % 3 == 0 ? INT_MIN : (r % 3 == 1 ? INT_MAX : (int) (uint32_t) r);
+		}
+	}
+}
+
+#define RECORD_LESS(r1, r2)             ((r1).key < (r2).key)
+#define RECORD_LESS_BY(r1, r2, reverse) ((reverse) ? (r2).key < (r1).key : (r1).key < (r2).key)
+
+UTIL_DEFINE_SORT(records, Record, RECORD_LESS)
+UTIL_DEFINE_SORT_CTX(records_by, Record, bool, RECORD_LESS_BY)
+
+static size_t leaves = 0;
+
+/**
+ * @brief Leaf sort that checks the size of the ranges it is given, and counts them in *ctx.
+ */
+static void record_leaf_ctx(Record *a, size_t n, size_t *ctx)
+{
+	ck_assert(n <= UTIL_SORT_INSERTION_THRESHOLD);
+	(*ctx)++;
+	records_sort(a, n);
+}
+
+static void record_leaf(Record *a, size_t n)
+{
+	record_leaf_ctx(a, n, &leaves);
+}
+
+#define RECORD_LESS_CTX(r1, r2, ctx) ((void) (ctx), RECORD_LESS(r1, r2))
+
+UTIL_DEFINE_SORT_LEAF(records_leaf, Record, RECORD_LESS, record_leaf)
+UTIL_DEFINE_SORT_CTX_LEAF(records_counted, Record, size_t *, RECORD_LESS_CTX, record_leaf_ctx)
+
+static int record_cmp(const void *r1, const void *r2)
+{
+	return util_int_cmp(&((const Record *) r1)->key, &((const Record *) r2)->key);
+}
+
+/**
+ * @brief Comparison of pointers to ints that is not recognized by util_sortPtrs().
+ */
+static int reverse_int_cmp(const void *i1, const void *i2)
+{
+	return util_int_cmp(i2, i1);
+}
+
+/**
+ * @brief Comparison of pointers to ints with the qsort() convention.
+ */
+static int qsort_int_ptr_cmp(const void *p1, const void *p2)
+{
+	return util_int_cmp(*(void *const *) p1, *(void *const *) p2);
+}
+
+static int qsort_string_cmp(const void *p1, const void *p2)
+{
+	return util_string_cmp(*(void *const *) p1, *(void *const *) p2);
+}
+
+static int qsort_double_ptr_cmp(const void *p1, const void *p2)
+{
+	return util_double_cmp(*(void *const *) p1, *(void *const *) p2);
+}
+
+static size_t calls = 0;
+
+/**
+ * @brief record_cmp() that counts its calls.
+ */
+static int counting_cmp(const void *r1, const void *r2)
+{
+	calls++;
+	return record_cmp(r1, r2);
+}
+
+/**
+ * @brief Sorts records with util_stableSort(), checking that it is stable and that it reports
+ * all the calls to the comparison function, and returns the statistics of the sort.
+ */
+static SortStats stable_sort_records(Record *r, size_t n)
+{
+	SortStats stats;
+
+	for (size_t i = 0; i < n; i++) {
+		r[i].pad[0] = (int) i;
+	}
+
+	calls = 0;
+	ck_assert(util_stableSort(r, n, sizeof(Record), counting_cmp, &stats) == E_SUCCESS);
+	ck_assert_uint_eq(stats.comparisons, calls);
+
+	for (size_t i = 1; i < n; i++) {
+		ck_assert_msg(r[i - 1].key < r[i].key || (r[i - 1].key == r[i].key && r[i - 1].pad[0] < r[i].pad[0]),
+					  "n = %zu, i = %zu", n, i);
+	}
+
+	return stats;
+}
+
+/* SECTION - Tests */
+
+START_TEST(test_sort_ints)
+{
+	for (size_t s = 0; s < NUM_SIZES; s++) {
+		size_t n      = sizes[s];
+		int *a        = malloc((n + 1) * sizeof(int));
+		int *expected = malloc((n + 1) * sizeof(int));
+
+		for (int kind = 0; kind < 5; kind++) {
+			fill_ints(a, n, kind);
+			memcpy(expected, a, n * sizeof(int));
+			qsort(expected, n, sizeof(int), util_int_cmp);
+
+			util_sort(a, n, sizeof(int), util_int_cmp);
+			ck_assert_msg(memcmp(a, expected, n * sizeof(int)) == 0, "n = %zu, kind = %d", n, kind);
+		}
+
+		free(a);
+		free(expected);
+	}
+}
+
+END_TEST
+
+START_TEST(test_sort_doubles)
+{
+	for (size_t s = 0; s < NUM_SIZES; s++) {
+		size_t n         = sizes[s];
+		double *a        = malloc((n + 1) * sizeof(double));
+		double *expected = malloc((n + 1) * sizeof(double));
+
+		for (size_t i = 0; i < n; i++) {
+			uint64_t r = next_rand();
+			a[i]       = (double) (int64_t) r / (double) (r % 1000 + 1) * (r % 7 == 0 ? 1e-300 : 1.0);
+		}
+		if (n > 2) {
+			a[0] = -0.0;
+			a[1] = 1.0 / 0.0;
+			a[2] = -1.0 / 0.0;
+		}
+		memcpy(expected, a, n * sizeof(double));
+		qsort(expected, n, sizeof(double), util_double_cmp);
+
+		util_sort(a, n, sizeof(double), util_double_cmp);
+		for (size_t i = 0; i < n; i++) {
+			ck_assert_msg(a[i] == expected[i], "n = %zu, i = %zu", n, i);
+		}
+
+		free(a);
+		free(expected);
+	}
+}
+
+END_TEST
+
+START_TEST(test_sort_doubles_total)
+{
+	for (size_t s = 0; s < NUM_SIZES; s++) {
+		size_t n      = sizes[s];
+		double *a     = malloc((n + 1) * sizeof(double));
+		void **elems  = malloc((n + 1) * sizeof(void *));
+		double pool[] = {NAN, -NAN, -0.0, 0.0, INFINITY, -INFINITY, 1.0, -1.0};
+
+		for (size_t i = 0; i < n; i++) {
+			uint64_t r = next_rand();
+			a[i]       = r % 3 == 0 ? pool[r % 8] : (double) (int64_t) r / 1e15;
+			elems[i]   = &a[i];
+		}
+
+		util_sortPtrs(elems, n, util_double_totalCmp);
+		for (size_t i = 1; i < n; i++) {
+			ck_assert(util_double_totalCmp(elems[i - 1], elems[i]) <= 0);
+		}
+
+		util_sort(a, n, sizeof(double), util_double_totalCmp);
+		for (size_t i = 1; i < n; i++) {
+			ck_assert_msg(util_double_totalCmp(&a[i - 1], &a[i]) <= 0, "n = %zu, i = %zu", n, i);
+		}
+
+		free(a);
+		free(elems);
+	}
+}
+
+END_TEST
+
+START_TEST(test_sort_chars)
+{
+	char a[1000];
+	char expected[1000];
+
+	for (size_t i = 0; i < sizeof(a); i++) {
+		a[i] = (char) next_rand();
+	}
+	memcpy(expected, a, sizeof(a));
+	qsort(expected, sizeof(a), 1, util_char_cmp);
+
+	util_sort(a, sizeof(a), 1, util_char_cmp);
+	ck_assert(memcmp(a, expected, sizeof(a)) == 0);
+}
+
+END_TEST
+
+START_TEST(test_sort_generic)
+{
+	for (size_t s = 0; s < NUM_SIZES; s++) {
+		size_t n   = sizes[s];
+		Record *a  = malloc((n + 1) * sizeof(Record));
+		int *check = malloc((n + 1) * sizeof(int));
+
+		for (size_t i = 0; i < n; i++) {
+			a[i]     = (Record) {.key = (int) (next_rand() % 1000), .pad = {(int) i, -(int) i}};
+			check[i] = a[i].key;
+		}
+		qsort(check, n, sizeof(int), util_int_cmp);
+
+		util_sort(a, n, sizeof(Record), record_cmp);
+		for (size_t i = 0; i < n; i++) {
+			ck_assert(a[i].key == check[i]);
+			ck_assert(a[i].pad[0] == -a[i].pad[1]); // Records are moved whole
+		}
+
+		free(a);
+		free(check);
+	}
+}
+
+END_TEST
+
+START_TEST(test_sort_ptrs_ints)
+{
+	for (size_t s = 0; s < NUM_SIZES; s++) {
+		size_t n        = sizes[s];
+		int *values     = malloc((n + 1) * sizeof(int));
+		void **elems    = malloc((n + 1) * sizeof(void *));
+		void **expected = malloc((n + 1) * sizeof(void *));
+
+		fill_ints(values, n, 1 + (int) (s % 4));
+		for (size_t i = 0; i < n; i++) {
+			elems[i] = i % 50 == 7 ? NULL : &values[i];
+		}
+		memcpy(expected, elems, n * sizeof(void *));
+		qsort(expected, n, sizeof(void *), qsort_int_ptr_cmp);
+
+		util_sortPtrs(elems, n, util_int_cmp);
+		for (size_t i = 0; i < n; i++) {
+			ck_assert(util_int_cmp(elems[i], expected[i]) == 0);
+		}
+
+		/* Comparison functions that are not recognized */
+		util_sortPtrs(elems, n, reverse_int_cmp);
+		for (size_t i = 0; i < n; i++) {
+			ck_assert(util_int_cmp(elems[i], expected[n - 1 - i]) == 0);
+		}
+
+		free(values);
+		free(elems);
+		free(expected);
+	}
+}
+
+END_TEST
+
+START_TEST(test_sort_ptrs_doubles)
+{
+	size_t n        = 5000;
+	double *values  = malloc(n * sizeof(double));
+	void **elems    = malloc(n * sizeof(void *));
+	void **expected = malloc(n * sizeof(void *));
+
+	for (size_t i = 0; i < n; i++) {
+		values[i] = (double) (int64_t) next_rand() / 1e10;
+		elems[i]  = &values[i];
+	}
+	memcpy(expected, elems, n * sizeof(void *));
+	qsort(expected, n, sizeof(void *), qsort_double_ptr_cmp);
+
+	util_sortPtrs(elems, n, util_double_cmp);
+	ck_assert(memcmp(elems, expected, n * sizeof(void *)) == 0);
+
+	free(values);
+	free(elems);
+	free(expected);
+}
+
+END_TEST
+
+START_TEST(test_sort_ptrs_strings)
+{
+	for (size_t s = 0; s < NUM_SIZES; s++) {
+		size_t n            = sizes[s];
+		char (*strings)[12] = malloc((n + 1) * sizeof(*strings));
+		void **elems        = malloc((n + 1) * sizeof(void *));
+		void **expected     = malloc((n + 1) * sizeof(void *));
+
+		/* Short strings over a small alphabet, with many duplicates and common prefixes */
+		for (size_t i = 0; i < n; i++) {
+			uint64_t r = next_rand();
+			size_t len = r % 11;
+
+			for (size_t k = 0; k < len; k++) {
+				strings[i][k] = (char) ("ab\x80z"[(r >> (8 + 2 * k)) % 4]);
+			}
+			strings[i][len] = '\0';
+			elems[i]        = i % 100 == 3 ? NULL : strings[i];
+		}
+		memcpy(expected, elems, n * sizeof(void *));
+		qsort(expected, n, sizeof(void *), qsort_string_cmp);
+
+		util_sortPtrs(elems, n, util_string_cmp);
+		for (size_t i = 0; i < n; i++) {
+			ck_assert_msg(util_string_cmp(elems[i], expected[i]) == 0, "n = %zu, i = %zu", n, i);
+		}
+
+		free(strings);
+		free(elems);
+		free(expected);
+	}
+}
+
+END_TEST
+
+START_TEST(test_sort_ptrs_long_strings)
+{
+	/* Long common prefixes, so that most bytes are compared in deep groups */
+	const size_t n  = 2000;
+	char *storage   = malloc(n * (n + 2));
+	void **elems    = malloc(n * sizeof(void *));
+	void **expected = malloc(n * sizeof(void *));
+
+	ck_assert(storage && elems && expected);
+	for (size_t i = 0; i < n; i++) {
+		char *s    = storage + i * (n + 2);
+		size_t len = (i * 7919) % n;
+
+		memset(s, i % 3 == 0 ? 'b' : 'a', len);
+		s[len]     = (char) ('a' + i % 5);
+		s[len + 1] = '\0';
+		elems[i]   = expected[i] = s;
+	}
+
+	qsort(expected, n, sizeof(void *), qsort_string_cmp);
+	util_sortPtrs(elems, n, util_string_cmp);
+	for (size_t i = 0; i < n; i++) {
+		ck_assert_msg(util_string_cmp(elems[i], expected[i]) == 0, "i = %zu", i);
+	}
+
+	free(storage);
+	free(elems);
+	free(expected);
+}
+
+END_TEST
+
+START_TEST(test_sort_ptrs_chars)
+{
+	char values[600];
+	void *elems[600];
+
+	for (size_t i = 0; i < 600; i++) {
+		values[i] = (char) next_rand();
+		elems[i]  = &values[i];
+	}
+
+	util_sortPtrs(elems, 600, util_char_cmp);
+	for (size_t i = 1; i < 600; i++) {
+		ck_assert(util_char_cmp(elems[i - 1], elems[i]) <= 0);
+	}
+}
+
+END_TEST
+
+START_TEST(test_template_sort)
+{
+	for (size_t s = 0; s < NUM_SIZES; s++) {
+		size_t n   = sizes[s];
+		Record *a  = malloc((n + 1) * sizeof(Record));
+		int *check = malloc((n + 1) * sizeof(int));
+
+		for (int kind = 0; kind < 5; kind++) {
+			fill_ints(check, n, kind);
+			for (size_t i = 0; i < n; i++) {
+				a[i] = (Record) {.key = check[i], .pad = {(int) i, -(int) i}};
+			}
+			qsort(check, n, sizeof(int), util_int_cmp);
+
+			records_sort(a, n);
+			ck_assert(records_isSorted(a, n));
+			for (size_t i = 0; i < n; i++) {
+				ck_assert_msg(a[i].key == check[i], "n = %zu, kind = %d", n, kind);
+				ck_assert(a[i].pad[0] == -a[i].pad[1]);
+			}
+
+			records_by_sort(a, n, true);
+			ck_assert(records_by_isSorted(a, n, true));
+			ck_assert(n < 2 || a[0].key == check[n - 1]);
+		}
+
+		free(a);
+		free(check);
+	}
+}
+
+END_TEST
+
+START_TEST(test_template_leaf)
+{
+	size_t n   = 1000;
+	Record *a  = malloc(n * sizeof(Record));
+	Record *b  = malloc(n * sizeof(Record));
+	size_t ctx = 0;
+
+	for (size_t i = 0; i < n; i++) {
+		a[i] = b[i] = (Record) {.key = (int) (next_rand() % 100)};
+	}
+
+	leaves = 0;
+	records_leaf_sort(a, n);
+	ck_assert(records_isSorted(a, n) && leaves > 0);
+
+	records_counted_sort(b, n, &ctx);
+	ck_assert(records_isSorted(b, n) && ctx == leaves);
+
+	free(a);
+	free(b);
+}
+
+END_TEST
+
+START_TEST(test_template_search)
+{
+	Record a[100];
+
+	for (size_t i = 0; i < 100; i++) {
+		a[i] = (Record) {.key = 2 * (int) (i / 2)}; // Pairs of equal keys: 0, 0, 2, 2, ...
+	}
+
+	for (int key = -1; key <= 100; key++) {
+		size_t i     = records_lowerBound(a, 100, (Record) {.key = key});
+		size_t check = key < 0 ? 0 : (size_t) (key + 1) / 2 * 2;
+
+		ck_assert_msg(i == check, "key = %d", key);
+		const Record *found = records_search(a, 100, (Record) {.key = key});
+		if (key >= 0 && key < 100 && key % 2 == 0) {
+			ck_assert_ptr_eq(found, &a[i]);
+		} else {
+			ck_assert_ptr_null(found);
+		}
+	}
+
+	ck_assert_uint_eq(records_lowerBound(a, 0, (Record) {.key = 0}), 0);
+	ck_assert_ptr_null(records_search(a, 0, (Record) {.key = 0}));
+	ck_assert_uint_eq(records_lowerBound(a, 1, (Record) {.key = 1}), 1);
+}
+
+END_TEST
+
+START_TEST(test_template_merge)
+{
+	Record a[]   = {{1, {0}}, {3, {0}}, {3, {0}}, {8, {0}}};
+	Record b[]   = {{0, {1}}, {3, {1}}, {9, {1}}};
+	Record out[7];
+	int keys[]   = {0, 1, 3, 3, 3, 8, 9};
+	int origin[] = {1, 0, 0, 0, 1, 0, 1};
+
+	records_merge(a, 4, b, 3, out);
+	for (size_t i = 0; i < 7; i++) {
+		ck_assert_int_eq(out[i].key, keys[i]);
+		ck_assert_int_eq(out[i].pad[0], origin[i]); // Equal keys of a come first
+	}
+
+	records_merge(a, 0, b, 3, out);
+	ck_assert_mem_eq(out, b, sizeof(b));
+	records_merge(a, 4, b, 0, out);
+	ck_assert_mem_eq(out, a, sizeof(a));
+}
+
+END_TEST
+
+START_TEST(test_radix_ints)
+{
+	for (size_t s = 0; s < NUM_SIZES; s++) {
+		size_t n        = sizes[s];
+		int *keys       = malloc((n + 1) * sizeof(int));
+		int *expected   = malloc((n + 1) * sizeof(int));
+		void **payloads = malloc((n + 1) * sizeof(void *));
+
+		for (int kind = 0; kind < 5; kind++) {
+			fill_ints(keys, n, kind);
+			for (size_t i = 0; i < n; i++) {
+				payloads[i] = (void *) (uintptr_t) i;
+			}
+			memcpy(expected, keys, n * sizeof(int));
+			qsort(expected, n, sizeof(int), util_int_cmp);
+
+			ck_assert(util_int_radixSort(keys, payloads, n) == E_SUCCESS);
+			ck_assert_msg(memcmp(keys, expected, n * sizeof(int)) == 0, "n = %zu, kind = %d", n, kind);
+
+			/* Stable: equal keys keep the order of their payloads */
+			for (size_t i = 1; i < n; i++) {
+				ck_assert(keys[i - 1] < keys[i] || (uintptr_t) payloads[i - 1] < (uintptr_t) payloads[i]);
+			}
+		}
+
+		free(keys);
+		free(expected);
+		free(payloads);
+	}
+}
+
+END_TEST
+
+START_TEST(test_radix_unsigned_doubles)
+{
+	size_t n         = 3000;
+	unsigned *u      = malloc(n * sizeof(unsigned));
+	double *d        = malloc(n * sizeof(double));
+	double *original = malloc(n * sizeof(double));
+	void **payloads  = malloc(n * sizeof(void *));
+
+	for (size_t i = 0; i < n; i++) {
+		uint64_t r = next_rand();
+		u[i]       = i % 3 == 0 ? UINT_MAX - (unsigned) (r % 4) : (unsigned) r;
+		d[i]       = i % 11 == 0 ? (r % 2 ? NAN : -0.0) : (double) (int64_t) r / 1e12;
+	}
+
+	ck_assert(util_unsigned_radixSort(u, NULL, n) == E_SUCCESS);
+	for (size_t i = 1; i < n; i++) {
+		ck_assert(u[i - 1] <= u[i]);
+	}
+
+	/* Payloads point to the original values */
+	memcpy(original, d, n * sizeof(double));
+	for (size_t i = 0; i < n; i++) {
+		payloads[i] = &original[i];
+	}
+	ck_assert(util_double_radixSort(d, payloads, n) == E_SUCCESS);
+	for (size_t i = 0; i < n; i++) {
+		ck_assert(util_double_totalCmp(payloads[i], &d[i]) == 0);
+		ck_assert(i == 0 || util_double_totalCmp(&d[i - 1], &d[i]) <= 0);
+	}
+
+	free(u);
+	free(d);
+	free(original);
+	free(payloads);
+}
+
+END_TEST
+
+START_TEST(test_radix_chars)
+{
+	char keys[500];
+	char original[500];
+	void *payloads[500];
+
+	for (size_t i = 0; i < 500; i++) {
+		keys[i]     = (char) next_rand();
+		original[i] = keys[i];
+		payloads[i] = &original[i];
+	}
+
+	ck_assert(util_char_radixSort(keys, payloads, 500) == E_SUCCESS);
+	for (size_t i = 0; i < 500; i++) {
+		ck_assert(*(char *) payloads[i] == keys[i]);
+		ck_assert(i == 0 || (util_char_cmp(&keys[i - 1], &keys[i]) <= 0 && payloads[i - 1] != payloads[i]));
+	}
+	for (size_t i = 1; i < 500; i++) {
+		ck_assert(keys[i - 1] != keys[i] || payloads[i - 1] < payloads[i]);
+	}
+
+	memcpy(keys, original, sizeof(keys));
+	ck_assert(util_char_radixSort(keys, NULL, 500) == E_SUCCESS);
+	for (size_t i = 1; i < 500; i++) {
+		ck_assert(util_char_cmp(&keys[i - 1], &keys[i]) <= 0);
+	}
+
+	ck_assert(util_char_radixSort(NULL, NULL, 0) == E_SUCCESS);
+	ck_assert(util_int_radixSort(NULL, NULL, 0) == E_SUCCESS);
+}
+
+END_TEST
+
+START_TEST(test_parallel_sort)
+{
+	size_t n   = 50000;
+	int *a     = malloc(n * sizeof(int));
+	int *check = malloc(n * sizeof(int));
+	Record *r  = malloc(n * sizeof(Record));
+
+	for (unsigned threads = 1; threads <= 7; threads++) {
+		size_t cutoff = 1000 * threads;
+
+		fill_ints(a, n, (int) threads % 5);
+		memcpy(check, a, n * sizeof(int));
+		qsort(check, n, sizeof(int), util_int_cmp);
+
+		util_parallelSort(a, n, sizeof(int), util_int_cmp, threads, cutoff);
+		ck_assert_msg(memcmp(a, check, n * sizeof(int)) == 0, "threads = %u", threads);
+
+		/* Comparison function that is not recognized, with few distinct keys */
+		for (size_t i = 0; i < n; i++) {
+			r[i]     = (Record) {.key = (int) (next_rand() % 100), .pad = {(int) i, -(int) i}};
+			check[i] = r[i].key;
+		}
+		qsort(check, n, sizeof(int), util_int_cmp);
+
+		util_parallelSort(r, n, sizeof(Record), record_cmp, threads, cutoff);
+		for (size_t i = 0; i < n; i++) {
+			ck_assert_msg(r[i].key == check[i], "threads = %u, i = %zu", threads, i);
+			ck_assert(r[i].pad[0] == -r[i].pad[1]);
+		}
+	}
+
+	free(a);
+	free(check);
+	free(r);
+}
+
+END_TEST
+
+START_TEST(test_parallel_sort_nan)
+{
+	/* Same result as util_sort() with util_double_cmp(), with NaNs of both signs and signed zeros */
+	size_t n      = 50000;
+	double *a     = malloc(n * sizeof(double));
+	double *check = malloc(n * sizeof(double));
+
+	for (unsigned threads = 2; threads <= 5; threads++) {
+		for (size_t i = 0; i < n; i++) {
+			uint64_t r = next_rand();
+			a[i]       = r % 7 == 0 ? (r % 2 ? NAN : -NAN) : r % 11 == 0 ? -0.0 : (double) (int64_t) r / 1e9;
+		}
+		memcpy(check, a, n * sizeof(double));
+		util_sort(check, n, sizeof(double), util_double_cmp);
+
+		util_parallelSort(a, n, sizeof(double), util_double_cmp, threads, 1000 * threads);
+		ck_assert_msg(memcmp(a, check, n * sizeof(double)) == 0, "threads = %u", threads);
+	}
+
+	free(a);
+	free(check);
+}
+
+END_TEST
+
+START_TEST(test_parallel_sort_limits)
+{
+	int a[300];
+
+	for (size_t n = 0; n < 300; n += 37) {
+		fill_ints(a, n, 0);
+		util_parallelSort(a, n, sizeof(int), util_int_cmp, 0, 0);
+		util_parallelSort(a, n, sizeof(int), reverse_int_cmp, 4, 1);
+		for (size_t i = 1; i < n; i++) {
+			ck_assert(a[i - 1] >= a[i]);
+		}
+	}
+
+	/* Strings, with more threads than elements per thread */
+	char *strings[] = {"pear", "apple", "fig", "kiwi", "banana", "apple", "date", "cherry", "grape"};
+	util_parallelSort(strings, 9, sizeof(char *), qsort_string_cmp, 16, 1);
+	for (size_t i = 1; i < 9; i++) {
+		ck_assert(strcmp(strings[i - 1], strings[i]) <= 0);
+	}
+}
+
+END_TEST
+
+START_TEST(test_stable_sort)
+{
+	for (size_t s = 0; s < NUM_SIZES; s++) {
+		size_t n  = sizes[s];
+		int *a    = malloc((n + 1) * sizeof(int));
+		Record *r = malloc((n + 1) * sizeof(Record));
+
+		for (int kind = 0; kind < 5; kind++) {
+			fill_ints(a, n, kind);
+
+			/* Few distinct keys, and runs of equal keys in the sorted and reversed arrays */
+			for (size_t i = 0; i < n; i++) {
+				r[i].key = kind == 2 || kind == 3 ? a[i] / 3 : a[i] % 16;
+			}
+			qsort(a, n, sizeof(int), util_int_cmp);
+
+			stable_sort_records(r, n);
+		}
+
+		free(a);
+		free(r);
+	}
+}
+
+END_TEST
+
+START_TEST(test_stable_sort_adaptive)
+{
+	size_t n  = 20000;
+	Record *r = malloc(n * sizeof(Record));
+	SortStats stats;
+
+	/* Sorted and strictly reversed input is a single run */
+	for (size_t i = 0; i < n; i++) {
+		r[i].key = (int) i;
+	}
+	stats = stable_sort_records(r, n);
+	ck_assert_uint_eq(stats.comparisons, n - 1);
+	ck_assert_uint_eq(stats.runs, 1);
+	ck_assert_uint_eq(stats.merges, 0);
+
+	for (size_t i = 0; i < n; i++) {
+		r[i].key = (int) (n - i);
+	}
+	stats = stable_sort_records(r, n);
+	ck_assert_uint_eq(stats.comparisons, n - 1);
+	ck_assert_uint_eq(stats.runs, 1);
+
+	/* Sorted input with a few random elements appended, which cost O(log n) each */
+	for (size_t i = 0; i < n; i++) {
+		r[i].key = i < n - 10 ? (int) i : (int) (next_rand() % n);
+	}
+	stats = stable_sort_records(r, n);
+	ck_assert_uint_eq(stats.merges, 1);
+	ck_assert(stats.comparisons < n + 1000);
+
+	/* Two interleaved sorted halves, found in n - 1 comparisons and merged in about n */
+	for (size_t i = 0; i < n; i++) {
+		r[i].key = i < n / 2 ? (int) (2 * i) : (int) (2 * (i - n / 2) + 1);
+	}
+	stats = stable_sort_records(r, n);
+	ck_assert_uint_eq(stats.runs, 2);
+	ck_assert_uint_eq(stats.merges, 1);
+	ck_assert(stats.comparisons < 2 * n + 64);
+
+	/* Random input, in O(n log n) */
+	for (size_t i = 0; i < n; i++) {
+		r[i].key = (int) (uint32_t) next_rand();
+	}
+	stats = stable_sort_records(r, n);
+	ck_assert(stats.comparisons <= n * 15);
+
+	free(r);
+}
+
+END_TEST
+
+START_TEST(test_stable_sort_limits)
+{
+	SortStats stats = {.comparisons = 1, .runs = 1, .merges = 1};
+	char chars[300];
+	int a[2] = {2, 1};
+
+	ck_assert(util_stableSort(NULL, 0, sizeof(int), util_int_cmp, &stats) == E_SUCCESS);
+	ck_assert_uint_eq(stats.comparisons + stats.runs + stats.merges, 0);
+	ck_assert(util_stableSort(a, 1, sizeof(int), util_int_cmp, NULL) == E_SUCCESS);
+	ck_assert_int_eq(a[0], 2);
+	ck_assert(util_stableSort(a, 2, sizeof(int), util_int_cmp, NULL) == E_SUCCESS);
+	ck_assert(a[0] == 1 && a[1] == 2);
+
+	/* Elements of size 1, around the minimum run length */
+	for (size_t n = 29; n < 300; n += 7) {
+		for (size_t i = 0; i < n; i++) {
+			chars[i] = (char) (next_rand() % 100);
+		}
+		ck_assert(util_stableSort(chars, n, 1, util_char_cmp, NULL) == E_SUCCESS);
+		for (size_t i = 1; i < n; i++) {
+			ck_assert(chars[i - 1] <= chars[i]);
+		}
+	}
+
+	char *strings[] = {"pear", "apple", "fig", "kiwi", "banana", "apple", "date", "cherry", "grape"};
+	ck_assert(util_stableSort(strings, 9, sizeof(char *), qsort_string_cmp, NULL) == E_SUCCESS);
+	for (size_t i = 1; i < 9; i++) {
+		ck_assert(strcmp(strings[i - 1], strings[i]) <= 0);
+	}
+}
+
+END_TEST
+
+START_TEST(test_small_sort)
+{
+	int a[UTIL_SMALL_SORT_MAX + 2];
+	int expected[UTIL_SMALL_SORT_MAX + 2];
+	double d[UTIL_SMALL_SORT_MAX + 2];
+	double d_expected[UTIL_SMALL_SORT_MAX + 2];
+	static const double specials[] = {0.0, -0.0, INFINITY, -INFINITY, NAN, -NAN, DBL_MIN, -DBL_MAX};
+
+	/* Every size of every network, and the sizes that do not fit them */
+	for (size_t n = 0; n <= UTIL_SMALL_SORT_MAX + 1; n++) {
+		for (int kind = 0; kind < 5; kind++) {
+			fill_ints(a, n, kind);
+			memcpy(expected, a, n * sizeof(int));
+			qsort(expected, n, sizeof(int), util_int_cmp);
+
+			util_int_smallSort(a, n);
+			ck_assert_msg(memcmp(a, expected, n * sizeof(int)) == 0, "n = %zu, kind = %d", n, kind);
+		}
+
+		for (size_t i = 0; i < n; i++) {
+			uint64_t r = next_rand();
+			d[i]       = r % 4 == 0 ? specials[r / 4 % 8] : (double) (int64_t) r / 1e3;
+		}
+		memcpy(d_expected, d, n * sizeof(double));
+		qsort(d_expected, n, sizeof(double), util_double_totalCmp);
+
+		util_double_smallSort(d, n);
+		ck_assert_msg(memcmp(d, d_expected, n * sizeof(double)) == 0, "n = %zu", n);
+	}
+
+	/* Radix sorts without payloads */
+	fill_ints(a, 50, 4);
+	memcpy(expected, a, 50 * sizeof(int));
+	qsort(expected, 50, sizeof(int), util_int_cmp);
+	ck_assert(util_int_radixSort(a, NULL, 50) == E_SUCCESS);
+	ck_assert(memcmp(a, expected, 50 * sizeof(int)) == 0);
+
+	util_int_smallSort(NULL, 0);
+	util_double_smallSort(NULL, 0);
+}
+
+END_TEST
+
+#ifndef NDEBUG
+START_TEST(test_sort_null_cmp)
+{
+	int a[2] = {2, 1};
+	util_sort(a, 2, sizeof(int), NULL);
+}
+#endif
+
+END_TEST
+
+/* !SECTION */
+
+Suite *sort_suite_create(void)
+{
+	Suite *s;
+	TCase *core;
+	TCase *limits;
+	TCase *signal_invalid;
+
+	s = suite_create("Sorting functions");
+
+	core = tcase_create(CASE_CORE);
+	tcase_add_test(core, test_sort_ints);
+	tcase_add_test(core, test_sort_doubles);
+	tcase_add_test(core, test_sort_doubles_total);
+	tcase_add_test(core, test_sort_chars);
+	tcase_add_test(core, test_sort_generic);
+	tcase_add_test(core, test_sort_ptrs_ints);
+	tcase_add_test(core, test_sort_ptrs_doubles);
+	tcase_add_test(core, test_sort_ptrs_strings);
+	tcase_add_test(core, test_template_sort);
+	tcase_add_test(core, test_template_leaf);
+	tcase_add_test(core, test_template_search);
+	tcase_add_test(core, test_template_merge);
+	tcase_add_test(core, test_radix_ints);
+	tcase_add_test(core, test_radix_unsigned_doubles);
+	tcase_add_test(core, test_parallel_sort);
+	tcase_add_test(core, test_stable_sort);
+	tcase_add_test(core, test_stable_sort_adaptive);
+	tcase_add_test(core, test_small_sort);
+
+	limits = tcase_create(CASE_LIMITS);
+	tcase_add_test(limits, test_sort_ptrs_long_strings);
+	tcase_add_test(limits, test_sort_ptrs_chars);
+	tcase_add_test(limits, test_radix_chars);
+	tcase_add_test(limits, test_parallel_sort_limits);
+	tcase_add_test(limits, test_parallel_sort_nan);
+	tcase_add_test(limits, test_stable_sort_limits);
+
+	signal_invalid = tcase_create(CASE_SIGNAL_INVALID);
+#ifndef NDEBUG
+	tcase_add_test_raise_signal(signal_invalid, test_sort_null_cmp, SIGABRT);
+#endif
+	tcase_set_tags(signal_invalid, NO_FORK_TAG);
+
+	suite_add_tcase(s, core);
+	suite_add_tcase(s, limits);
+	suite_add_tcase(s, signal_invalid);
+
+	return s;
+}
+
+int main(void)
+{
+	MAIN_RUNNER(sort_suite_create);
+}
@@ -0,0 +1,235 @@
+#include "tagged.h"
+#include "test_macros.h"
+#include "utilities.h"
+
+#include <errno.h>
+#include <float.h>
+#include <limits.h>
+#include <math.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const int ints[] = {0, 1, -1, 42, -1000000, INT_MAX, INT_MIN};
+
+static const double doubles[] = {0.0, -0.0, 1.5, -2.25, 1e300, -1e-300, DBL_MIN, DBL_MAX, -DBL_MAX,
+								 DBL_TRUE_MIN, INFINITY, -INFINITY};
+
+#define NUM_INTS (sizeof(ints) / sizeof(ints[0]))
+#define NUM_DOUBLES (sizeof(doubles) / sizeof(doubles[0]))
+
+/* SECTION - Tests */
+
+START_TEST(test_tagged_chars)
+{
+	for (int c = CHAR_MIN; c <= CHAR_MAX; c++) {
+		void *v = util_tagged_fromChar((char) c);
+
+		ck_assert(v != NULL);
+		ck_assert(util_tagged_isChar(v) && !util_tagged_isInt(v) && !util_tagged_isDouble(v));
+		ck_assert(util_tagged_char(v) == (char) c);
+	}
+}
+
+END_TEST
+
+START_TEST(test_tagged_ints)
+{
+	for (size_t i = 0; i < NUM_INTS; i++) {
+		void *v = util_tagged_fromInt(ints[i]);
+
+		ck_assert(v != NULL);
+		ck_assert(util_tagged_isInt(v) && !util_tagged_isChar(v) && !util_tagged_isDouble(v));
+		ck_assert(util_tagged_int(v) == ints[i]);
+		ck_assert(util_tagged_double(v) == ints[i]);
+	}
+}
+
+END_TEST
+
+START_TEST(test_tagged_doubles)
+{
+	for (size_t i = 0; i < NUM_DOUBLES; i++) {
+		void *v = util_tagged_fromDouble(doubles[i]);
+
+		ck_assert(v != NULL);
+		ck_assert(util_tagged_isDouble(v) && !util_tagged_isChar(v) && !util_tagged_isInt(v));
+		ck_assert(memcmp(&(double) {util_tagged_double(v)}, &doubles[i], sizeof(double)) == 0);
+	}
+
+	/* All NaNs share one encoding */
+	void *nan1 = util_tagged_fromDouble(NAN);
+	void *nan2 = util_tagged_fromDouble(-NAN);
+	ck_assert(util_tagged_isDouble(nan1));
+	ck_assert(nan1 == nan2);
+	ck_assert(isnan(util_tagged_double(nan1)));
+}
+
+END_TEST
+
+START_TEST(test_tagged_cmp)
+{
+	void *c = util_tagged_fromChar('a');
+	void *i = util_tagged_fromInt(2);
+	void *d = util_tagged_fromDouble(1.5);
+
+	ck_assert(util_tagged_cmp(util_tagged_fromChar('a'), util_tagged_fromChar('b')) < 0);
+	ck_assert(util_tagged_cmp(util_tagged_fromInt(INT_MIN), util_tagged_fromInt(INT_MAX)) < 0);
+	ck_assert(util_tagged_cmp(util_tagged_fromDouble(-1e300), util_tagged_fromDouble(1e-300)) < 0);
+
+	/* Numbers compare by value, chars go before them and NULL before everything */
+	ck_assert(util_tagged_cmp(d, i) < 0 && util_tagged_cmp(i, d) > 0);
+	ck_assert(util_tagged_equal(util_tagged_fromInt(3), util_tagged_fromDouble(3.0)));
+	ck_assert(util_tagged_cmp(c, d) < 0 && util_tagged_cmp(i, c) > 0);
+	ck_assert(util_tagged_cmp(NULL, c) < 0 && util_tagged_cmp(d, NULL) > 0);
+	ck_assert(util_tagged_cmp(NULL, NULL) == 0);
+	ck_assert(util_tagged_equal(util_tagged_fromDouble(0.0), util_tagged_fromDouble(-0.0)));
+	ck_assert(!util_tagged_equal(c, i));
+
+	/* NaN goes after every number and equals only itself */
+	void *nan = util_tagged_fromDouble(NAN);
+	ck_assert(util_tagged_cmp(nan, util_tagged_fromDouble(INFINITY)) > 0);
+	ck_assert(util_tagged_cmp(i, nan) < 0 && util_tagged_cmp(nan, i) > 0);
+	ck_assert(util_tagged_cmp(c, nan) < 0);
+	ck_assert(!util_tagged_equal(nan, d) && !util_tagged_equal(i, nan));
+	ck_assert(util_tagged_equal(nan, util_tagged_fromDouble(-NAN)));
+}
+
+END_TEST
+
+START_TEST(test_tagged_to_string)
+{
+	/* Same output as the functions of the untagged types */
+	char expected[UTIL_PRIMITIVE_BUFSIZE];
+	char buf[UTIL_PRIMITIVE_BUFSIZE];
+	char *str;
+	char c = 'z';
+
+	for (size_t i = 0; i < NUM_INTS; i++) {
+		void *v = util_tagged_fromInt(ints[i]);
+		int len = util_int_toBuffer(expected, sizeof(expected), &ints[i]);
+
+		ck_assert(util_tagged_toBuffer(buf, sizeof(buf), v) == len);
+		ck_assert_str_eq(buf, expected);
+		str = util_tagged_toString(v);
+		ck_assert_str_eq(str, expected);
+		free(str);
+	}
+
+	for (size_t i = 0; i < NUM_DOUBLES; i++) {
+		void *v = util_tagged_fromDouble(doubles[i]);
+		int len = util_double_toBuffer(expected, sizeof(expected), &doubles[i]);
+
+		ck_assert(util_tagged_toBuffer(buf, sizeof(buf), v) == len);
+		ck_assert_str_eq(buf, expected);
+		str = util_tagged_toString(v);
+		ck_assert_str_eq(str, expected);
+		free(str);
+	}
+
+	str = util_tagged_toString(util_tagged_fromChar(c));
+	ck_assert_str_eq(str, "z");
+	free(str);
+
+	ck_assert(util_tagged_toString(NULL) == NULL);
+	ck_assert(util_tagged_toBuffer(buf, sizeof(buf), NULL) < 0);
+}
+
+END_TEST
+
+START_TEST(test_tagged_print)
+{
+	char *out;
+	size_t size;
+	FILE *file = open_memstream(&out, &size);
+
+	ck_assert(file != NULL);
+	ck_assert(util_tagged_print(file, util_tagged_fromChar('x')) == 2);
+	ck_assert(util_tagged_print(file, util_tagged_fromInt(-12)) == 4);
+	ck_assert(util_tagged_print(file, util_tagged_fromDouble(0.5)) == 3);
+	ck_assert(util_tagged_print(file, NULL) == 5);
+	fclose(file);
+
+	ck_assert_str_eq(out, "x -12 0.5null ");
+	free(out);
+}
+
+END_TEST
+
+START_TEST(test_tagged_from_string)
+{
+	void *v;
+
+	v = util_tagged_charFromString("hello");
+	ck_assert(util_tagged_isChar(v) && util_tagged_char(v) == 'h');
+
+	v = util_tagged_intFromString("-123abc");
+	ck_assert(util_tagged_isInt(v) && util_tagged_int(v) == -123);
+
+	v = util_tagged_doubleFromString("2.5e3");
+	ck_assert(util_tagged_isDouble(v) && util_tagged_double(v) == 2500);
+
+	ck_assert(util_tagged_intFromString("abc") == NULL);
+	ck_assert(errno == 0);
+	ck_assert(util_tagged_intFromString("99999999999") == NULL);
+	ck_assert(errno == ERANGE);
+	ck_assert(util_tagged_doubleFromString("") == NULL);
+	ck_assert(errno == 0);
+	ck_assert(util_tagged_doubleFromString("1e999") == NULL);
+	ck_assert(errno == ERANGE);
+
+	util_tagged_free(v);
+	util_tagged_free(NULL);
+}
+
+END_TEST
+
+#ifndef NDEBUG
+START_TEST(test_tagged_wrong_type)
+{
+	util_tagged_int(util_tagged_fromDouble(1.0));
+}
+#endif
+
+END_TEST
+
+/* !SECTION */
+
+Suite *tagged_suite_create(void)
+{
+	Suite *s;
+	TCase *core;
+	TCase *limits;
+	TCase *signal_invalid;
+
+	s = suite_create("Tagged values");
+
+	core = tcase_create(CASE_CORE);
+	tcase_add_test(core, test_tagged_chars);
+	tcase_add_test(core, test_tagged_ints);
+	tcase_add_test(core, test_tagged_doubles);
+	tcase_add_test(core, test_tagged_cmp);
+	tcase_add_test(core, test_tagged_to_string);
+	tcase_add_test(core, test_tagged_print);
+
+	limits = tcase_create(CASE_LIMITS);
+	tcase_add_test(limits, test_tagged_from_string);
+
+	signal_invalid = tcase_create(CASE_SIGNAL_INVALID);
+#ifndef NDEBUG
+	tcase_add_test_raise_signal(signal_invalid, test_tagged_wrong_type, SIGABRT);
+#endif
+	tcase_set_tags(signal_invalid, NO_FORK_TAG);
+
+	suite_add_tcase(s, core);
+	suite_add_tcase(s, limits);
+	suite_add_tcase(s, signal_invalid);
+
+	return s;
+}
+
+int main(void)
+{
+	MAIN_RUNNER(tagged_suite_create);
+}
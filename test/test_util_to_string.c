@@ -16,6 +16,10 @@
 		free(ptr);                                           \
 	}
 
+#define test_to_buffer(fn, x, str)                            \
+	char buf[UTIL_PRIMITIVE_BUFSIZE];                         \
+	ck_assert(fn(buf, sizeof(buf), x) == (int) strlen(str)); \
+	ck_assert_str_eq(buf, str);
 
 static const util_toString functions[] = {
 	util_generic_toString,
@@ -25,6 +29,14 @@ static const util_toString functions[] = {
 	util_string_toString
 };
 
+static const util_toBuffer buffer_functions[] = {
+	util_generic_toBuffer,
+	util_char_toBuffer,
+	util_int_toBuffer,
+	util_double_toBuffer,
+	util_string_toBuffer
+};
+
 /* SECTION - Tests */
 
 START_TEST(test_generic_to_string)
@@ -59,10 +71,8 @@ END_TEST
 START_TEST(test_double_to_string)
 {
 	double d = 1234567.8901234567890;
-	char str[128];
-	snprintf(str, 128, "%.*g", DBL_DIG, d);
 
-	test_to_string(util_double_toString, &d, "Double", str);
+	test_to_string(util_double_toString, &d, "Double", "1234567.8901234567");
 }
 
 END_TEST
@@ -115,10 +125,8 @@ END_TEST
 START_TEST(test_double_to_string_max)
 {
 	double d = -DBL_MAX;
-	char str[128];
-	snprintf(str, 128, "%.*g", DBL_DIG, d);
 
-	test_to_string(util_double_toString, &d, "Double max", str);
+	test_to_string(util_double_toString, &d, "Double max", "-1.7976931348623157e+308");
 }
 
 END_TEST
@@ -126,10 +134,18 @@ END_TEST
 START_TEST(test_double_to_string_min)
 {
 	double d = -DBL_MIN;
-	char str[128];
-	snprintf(str, 128, "%.*g", DBL_DIG, d);
 
-	test_to_string(util_double_toString, &d, "Double min", str);
+	test_to_string(util_double_toString, &d, "Double min", "-2.2250738585072014e-308");
+}
+
+END_TEST
+
+START_TEST(test_double_to_string_round_trip)
+{
+	double d = 0.1 + 0.2;
+
+	test_to_string(util_double_toString, &d, "Double round trip", "0.30000000000000004");
+	ck_assert(strtod("0.30000000000000004", NULL) == d);
 }
 
 END_TEST
@@ -143,6 +159,92 @@ START_TEST(test_string_to_string_empty)
 
 END_TEST
 
+START_TEST(test_generic_to_buffer)
+{
+	long x = 0;
+	char str[128];
+	snprintf(str, 128, "0x%" PRIxPTR, (uintptr_t) &x);
+
+	test_to_buffer(util_generic_toBuffer, &x, str);
+}
+
+END_TEST
+
+START_TEST(test_char_to_buffer)
+{
+	char c = '!';
+
+	test_to_buffer(util_char_toBuffer, &c, "!");
+}
+
+END_TEST
+
+START_TEST(test_int_to_buffer)
+{
+	int i = INT_MIN;
+	char str[128];
+	snprintf(str, 128, "%d", i);
+
+	test_to_buffer(util_int_toBuffer, &i, str);
+}
+
+END_TEST
+
+START_TEST(test_double_to_buffer)
+{
+	double d = 0.1;
+
+	test_to_buffer(util_double_toBuffer, &d, "0.1");
+}
+
+END_TEST
+
+START_TEST(test_string_to_buffer)
+{
+	char *str = "Bananas";
+
+	test_to_buffer(util_string_toBuffer, str, str);
+}
+
+END_TEST
+
+START_TEST(test_null_to_buffer)
+{
+	char buf[UTIL_PRIMITIVE_BUFSIZE];
+
+	ck_assert(buffer_functions[_i](buf, sizeof(buf), NULL) < 0);
+}
+
+END_TEST
+
+START_TEST(test_to_buffer_truncated)
+{
+	int i = 1234567;
+	char buf[4];
+
+	ck_assert(util_int_toBuffer(buf, sizeof(buf), &i) == 7);
+	ck_assert_str_eq(buf, "123");
+
+	ck_assert(util_string_toBuffer(buf, sizeof(buf), "Bananas") == 7);
+	ck_assert_str_eq(buf, "Ban");
+
+	ck_assert(util_char_toBuffer(buf, 1, "?") == 1);
+	ck_assert_str_eq(buf, "");
+}
+
+END_TEST
+
+START_TEST(test_to_buffer_size_zero)
+{
+	double d = 0.5;
+
+	ck_assert(util_double_toBuffer(NULL, 0, &d) == 3);
+	ck_assert(util_string_toBuffer(NULL, 0, "Bananas") == 7);
+	ck_assert(util_char_toBuffer(NULL, 0, "?") == 1);
+}
+
+END_TEST
+
 /* !SECTION */
 
 Suite *to_string_suite_create(void)
@@ -160,6 +262,12 @@ Suite *to_string_suite_create(void)
 	tcase_add_test(core, test_double_to_string);
 	tcase_add_test(core, test_string_to_string);
 	tcase_add_loop_test(core, test_null_to_string, 0, NUM_OF_FN);
+	tcase_add_test(core, test_generic_to_buffer);
+	tcase_add_test(core, test_char_to_buffer);
+	tcase_add_test(core, test_int_to_buffer);
+	tcase_add_test(core, test_double_to_buffer);
+	tcase_add_test(core, test_string_to_buffer);
+	tcase_add_loop_test(core, test_null_to_buffer, 0, NUM_OF_FN);
 
 	limits = tcase_create(CASE_LIMITS);
 	tcase_add_test(limits, test_char_to_string_nul);
@@ -167,7 +275,10 @@ Suite *to_string_suite_create(void)
 	tcase_add_test(limits, test_int_to_string_min);
 	tcase_add_test(limits, test_double_to_string_max);
 	tcase_add_test(limits, test_double_to_string_min);
+	tcase_add_test(limits, test_double_to_string_round_trip);
 	tcase_add_test(limits, test_string_to_string_empty);
+	tcase_add_test(limits, test_to_buffer_truncated);
+	tcase_add_test(limits, test_to_buffer_size_zero);
 
 	suite_add_tcase(s, core);
 	suite_add_tcase(s, limits);
@@ -179,7 +290,7 @@ int main(void)
 {
 	// Temp code to check that macros are properly set
 	// printf("Pointer: %d\n", (2 + (int) ceil(log2((double) UINTPTR_MAX) / 4)));
-	// printf("Double: %d\n", (1 + DBL_DIG + 1 + 2 + (int) ceil(log10(DBL_MAX_10_EXP))));
+	// printf("Double: %d\n", (1 + DBL_DECIMAL_DIG + 1 + 2 + (int) ceil(log10(DBL_MAX_10_EXP))));
 	// printf("Long: %d\n", (1 + (int) ceil(log10((double) LONG_MAX))));
 	// printf("Int: %d\n", (1 + (int) ceil(log10(INT_MAX))));
 